@@ -0,0 +1,96 @@
+#ifndef CASM_config_ConcurrentConfigurationSet
+#define CASM_config_ConcurrentConfigurationSet
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+class ConfigurationSet;
+
+/// \brief Thread-safe set of configurations, for collecting results from
+///     parallel producers
+///
+/// Usage:
+/// \code
+/// ConcurrentConfigurationSet results;
+/// pool.parallel_for(n, [&](Index begin, Index end) {
+///   std::vector<Configuration> block;
+///   for (Index i = begin; i < end; ++i) {
+///     block.push_back(make_canonical_form(candidates[i]));
+///   }
+///   results.insert_range(block);
+/// });
+/// results.merge_into(configurations);
+/// \endcode
+///
+/// Notes:
+/// - Configurations are sharded by canonical supercell name, and each shard
+///   has its own mutex, so producers inserting configurations in different
+///   supercells do not contend for a lock
+/// - Configuration ids are not assigned on insertion. They are assigned by
+///   `merge_into`, which inserts configurations into a ConfigurationSet in
+///   order of supercell name and then Configuration, so that ids do not
+///   depend on the number of threads or the order of insertion.
+/// - As for ConfigurationSet, configurations must be in their canonical
+///   supercell. The supercell name is determined from the Hermite normal
+///   form of the supercell transformation matrix, and `insert` and
+///   `insert_range` throw if a configuration is not in its canonical
+///   supercell.
+class ConcurrentConfigurationSet {
+ public:
+  /// \brief Constructor
+  explicit ConcurrentConfigurationSet(Index _n_shards = 64);
+
+  ConcurrentConfigurationSet(ConcurrentConfigurationSet const &) = delete;
+  ConcurrentConfigurationSet &operator=(ConcurrentConfigurationSet const &) =
+      delete;
+
+  /// \brief Number of shards
+  Index n_shards() const;
+
+  /// \brief Total number of configurations
+  Index size() const;
+
+  bool empty() const;
+
+  void clear();
+
+  /// \brief Insert a Configuration, determining the supercell name
+  bool insert(Configuration const &configuration);
+
+  /// \brief Insert a Configuration with known supercell name
+  bool insert(std::string const &supercell_name,
+              Configuration const &configuration);
+
+  /// \brief Insert many configurations, taking each shard lock once
+  Index insert_range(std::vector<Configuration> const &configurations);
+
+  /// \brief Insert all configurations into a ConfigurationSet, assigning
+  ///     configuration ids in a deterministic order
+  Index merge_into(ConfigurationSet &configurations) const;
+
+ private:
+  struct Shard {
+    mutable std::mutex mutex;
+
+    /// Configurations, by supercell name
+    std::map<std::string, std::set<Configuration>> data;
+  };
+
+  Index _shard_index(std::string const &supercell_name) const;
+
+  std::vector<Shard> m_shards;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -3,9 +3,11 @@
 
 #include "casm/clexulator/ConfigDoFValues.hh"
 #include "casm/clexulator/ConfigDoFValuesTools.hh"
+#include "casm/configuration/LocalDoFTransformCache.hh"
 #include "casm/configuration/PrimSymInfo.hh"
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/gather_compare.hh"
 
 namespace CASM {
 namespace config {
@@ -24,36 +26,35 @@ class Occupation {
 
   /// \brief Return config == other, store config < other
   bool operator()(Eigen::VectorXi const &other) const {
-    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
-                     [&](Index i) { return other[i]; });
+    return _compare(make_permuted_occupation(m_occupation_ptr->data()),
+                    make_permuted_occupation(other.data()));
   }
 
   /// \brief Return config == A*config, store config < A*config
   bool operator()(SupercellSymOp const &A) const {
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_index(i)]; });
+    int const *occ = m_occupation_ptr->data();
+    return _compare(make_permuted_occupation(occ),
+                    make_permuted_occupation(occ, A));
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const {
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_index(i)]; },
-        [&](Index i) { return (*m_occupation_ptr)[B.permute_index(i)]; });
+    int const *occ = m_occupation_ptr->data();
+    return _compare(make_permuted_occupation(occ, A),
+                    make_permuted_occupation(occ, B));
   }
 
   /// \brief Return config == A*other, store config < A*other
   bool operator()(SupercellSymOp const &A, Eigen::VectorXi const &other) const {
-    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
-                     [&](Index i) { return other[A.permute_index(i)]; });
+    return _compare(make_permuted_occupation(m_occupation_ptr->data()),
+                    make_permuted_occupation(other.data(), A));
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
                   Eigen::VectorXi const &other) const {
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[A.permute_index(i)]; },
-        [&](Index i) { return other[B.permute_index(i)]; });
+    return _compare(make_permuted_occupation(m_occupation_ptr->data(), A),
+                    make_permuted_occupation(other.data(), B));
   }
 
   /// \brief Returns less than comparison
@@ -62,15 +63,15 @@ class Occupation {
   bool is_less() const { return m_less; }
 
  protected:
-  template <typename F, typename G>
-  bool _for_each(F f, G g) const {
-    Index i;
-    for (i = 0; i < m_occupation_ptr->size(); i++) {
-      if (!_check(f(i), g(i))) {
-        return false;
-      }
+  /// \brief Compare using the gather-compare kernel
+  bool _compare(PermutedOccupation const &lhs,
+                PermutedOccupation const &rhs) const {
+    Index n = m_occupation_ptr->size();
+    Index i = find_first_difference(lhs, rhs, n);
+    if (i == n) {
+      return true;
     }
-    return true;
+    return _check(lhs[i], rhs[i]);
   }
 
  private:
@@ -118,8 +119,8 @@ class AnisoOccupation {
 
   /// \brief Return config == other, store config < other
   bool operator()(Eigen::VectorXi const &other) const {
-    return _for_each([&](Index i) { return (*m_occupation_ptr)[i]; },
-                     [&](Index i) { return other[i]; });
+    return _compare(make_permuted_occupation(m_occupation_ptr->data()),
+                    make_permuted_occupation(other.data()));
   }
 
   /// \brief Return config == B*config, store config < B*config
@@ -127,9 +128,8 @@ class AnisoOccupation {
     _update_B(B, *m_occupation_ptr);
     m_tmp_valid = true;
 
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _compare(make_permuted_occupation(m_occupation_ptr->data()),
+                    make_permuted_occupation(m_new_occ_B.data(), B));
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
@@ -138,9 +138,8 @@ class AnisoOccupation {
     _update_B(B, *m_occupation_ptr);
     m_tmp_valid = true;
 
-    return _for_each(
-        [&](Index i) { return this->m_new_occ_A[A.permute_index(i)]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _compare(make_permuted_occupation(m_new_occ_A.data(), A),
+                    make_permuted_occupation(m_new_occ_B.data(), B));
   }
 
   /// \brief Return config == B*other, store config < B*other
@@ -148,9 +147,8 @@ class AnisoOccupation {
     _update_B(B, other);
     m_tmp_valid = false;
 
-    return _for_each(
-        [&](Index i) { return (*m_occupation_ptr)[i]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _compare(make_permuted_occupation(m_occupation_ptr->data()),
+                    make_permuted_occupation(m_new_occ_B.data(), B));
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
@@ -160,9 +158,8 @@ class AnisoOccupation {
     _update_B(B, other);
     m_tmp_valid = false;
 
-    return _for_each(
-        [&](Index i) { return this->m_new_occ_A[A.permute_index(i)]; },
-        [&](Index i) { return this->m_new_occ_B[B.permute_index(i)]; });
+    return _compare(make_permuted_occupation(m_new_occ_A.data(), A),
+                    make_permuted_occupation(m_new_occ_B.data(), B));
   }
 
   /// \brief Returns less than comparison
@@ -171,15 +168,15 @@ class AnisoOccupation {
   bool is_less() const { return m_less; }
 
  protected:
-  template <typename F, typename G>
-  bool _for_each(F f, G g) const {
-    Index i;
-    for (i = 0; i < m_occupation_ptr->size(); i++) {
-      if (!_check(f(i), g(i))) {
-        return false;
-      }
+  /// \brief Compare using the gather-compare kernel
+  bool _compare(PermutedOccupation const &lhs,
+                PermutedOccupation const &rhs) const {
+    Index n = m_occupation_ptr->size();
+    Index i = find_first_difference(lhs, rhs, n);
+    if (i == n) {
+      return true;
     }
-    return true;
+    return _check(lhs[i], rhs[i]);
   }
 
   void _update_A(SupercellSymOp const &A, Eigen::VectorXi const &before) const {
@@ -255,28 +252,53 @@ class AnisoOccupation {
 ///
 /// Method:
 /// - To improve efficiency when comparisons are being made repeatedly under
-///   transformation by the same factor group operation but different
-///   translations, temporary vectors 'm_new_dof_A' and 'm_new_dof_B' store the
-///   DoF values under transformation by factor group operation only,
-///   not site permutation. The factor group operation used last is stored in
-///   'm_fg_index_A' and 'm_fg_index_B'. The 'm_tmp_valid' is set to false if
-///   comparison is made against an "other" ConfigDoF to force update of the
-///   transformed variables in the temporary vectors the next time the functor
-///   is called because it cannot be guaranteed that the "other" is the same.
+///   transformation by many operations, the DoF values of the configuration
+///   this was constructed with, transformed by each prim factor group
+///   operation only, not site permutation, are stored in a
+///   LocalDoFTransformCache. Comparisons then only permute columns of the
+///   cached values.
+/// - If constructed with `_use_cache == false`, the DoF values of the
+///   configuration are instead transformed into temporaries 'm_new_dof_A'
+///   and 'm_new_dof_B', which uses the least memory. The values transformed
+///   and the prim factor group operation used last are stored in
+///   'm_before_A', 'm_fg_index_A', 'm_before_B', and 'm_fg_index_B', so
+///   that the transformation is skipped when comparisons are made
+///   repeatedly under transformation by the same factor group operation but
+///   different translations.
+/// - DoF values of an "other" ConfigDoF are transformed into 'm_new_dof_B'.
+///   The transformation is skipped if the same "other" object is compared
+///   against repeatedly, under the same factor group operation, so "other"
+///   must not be modified between such comparisons.
 class Local {
  public:
+  /// \brief Constructor
+  ///
+  /// \param _values Local DoF values, as columns by site index. Not copied,
+  ///     and must outlive this object.
+  /// \param _key DoF type, used to obtain the matrix rep
+  /// \param n_sublat Number of sublattices in the prim
+  /// \param _tol Tolerance for comparisons
+  /// \param _use_cache If true, cache transformed values in a
+  ///     LocalDoFTransformCache. If false, transform values every comparison.
+  /// \param _max_cache_bytes Limit on the memory used by the cache. If
+  ///     std::nullopt, all prim factor group operations are cached.
   Local(Eigen::MatrixXd const &_values, DoFKey const &_key, Index n_sublat,
-        double _tol)
+        double _tol, bool _use_cache = true,
+        std::optional<Index> _max_cache_bytes =
+            LocalDoFTransformCache::default_max_bytes)
       : m_values_ptr(&_values),
         m_key(_key),
         m_n_sublat(n_sublat),
         m_n_vol(_values.cols() / n_sublat),
         m_tol(_tol),
-        m_tmp_valid(true),
-        m_fg_index_A(0),
-        m_new_dof_A(*m_values_ptr),
-        m_fg_index_B(0),
-        m_new_dof_B(*m_values_ptr) {}
+        m_before_A(nullptr),
+        m_fg_index_A(-1),
+        m_before_B(nullptr),
+        m_fg_index_B(-1) {
+    if (_use_cache) {
+      m_cache.emplace(_values, _key, n_sublat, _max_cache_bytes);
+    }
+  }
 
   /// \brief Return config == other, store config < other
   bool operator()(Eigen::MatrixXd const &other) const {
@@ -286,54 +308,41 @@ class Local {
 
   /// \brief Return config == B*config, store config < B*config
   bool operator()(SupercellSymOp const &B) const {
-    _update_B(B, _values());
-    m_tmp_valid = true;
-
+    Eigen::MatrixXd const &new_dof_B = _transformed_B(B);
     return _for_each([&](Index i, Index j) { return this->_values()(i, j); },
                      [&](Index i, Index j) {
-                       return this->new_dof_B(i, B.permute_index(j));
+                       return new_dof_B(i, B.permute_index(j));
                      });
   }
 
   /// \brief Return A*config == B*config, store A*config < B*config
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B) const {
-    _update_A(A, _values());
-    _update_B(B, _values());
-    m_tmp_valid = true;
+    Eigen::MatrixXd const &new_dof_A = _transformed_A(A);
+    Eigen::MatrixXd const &new_dof_B = _transformed_B(B);
     return _for_each(
-        [&](Index i, Index j) {
-          return this->new_dof_A(i, A.permute_index(j));
-        },
-        [&](Index i, Index j) {
-          return this->new_dof_B(i, B.permute_index(j));
-        });
+        [&](Index i, Index j) { return new_dof_A(i, A.permute_index(j)); },
+        [&](Index i, Index j) { return new_dof_B(i, B.permute_index(j)); });
   }
 
   /// \brief Return config == B*other, store config < B*other
   bool operator()(SupercellSymOp const &B, Eigen::MatrixXd const &other) const {
-    _update_B(B, other);
-    m_tmp_valid = false;
-
+    Eigen::MatrixXd const &new_dof_B =
+        _transform(B, other, m_before_B, m_fg_index_B, m_new_dof_B);
     return _for_each([&](Index i, Index j) { return this->_values()(i, j); },
                      [&](Index i, Index j) {
-                       return this->new_dof_B(i, B.permute_index(j));
+                       return new_dof_B(i, B.permute_index(j));
                      });
   }
 
   /// \brief Return A*config == B*other, store A*config < B*other
   bool operator()(SupercellSymOp const &A, SupercellSymOp const &B,
                   Eigen::MatrixXd const &other) const {
-    _update_A(A, _values());
-    _update_B(B, other);
-    m_tmp_valid = false;
-
+    Eigen::MatrixXd const &new_dof_A = _transformed_A(A);
+    Eigen::MatrixXd const &new_dof_B =
+        _transform(B, other, m_before_B, m_fg_index_B, m_new_dof_B);
     return _for_each(
-        [&](Index i, Index j) {
-          return this->new_dof_A(i, A.permute_index(j));
-        },
-        [&](Index i, Index j) {
-          return this->new_dof_B(i, B.permute_index(j));
-        });
+        [&](Index i, Index j) { return new_dof_A(i, A.permute_index(j)); },
+        [&](Index i, Index j) { return new_dof_B(i, B.permute_index(j)); });
   }
 
   /// \brief Returns less than comparison
@@ -344,45 +353,52 @@ class Local {
  private:
   Eigen::MatrixXd const &_values() const { return *m_values_ptr; }
 
-  void _update_A(SupercellSymOp const &A, Eigen::MatrixXd const &before) const {
-    using clexulator::sublattice_block;
-    if (A.supercell_factor_group_index() != m_fg_index_A || !m_tmp_valid) {
-      PrimSymInfo const &prim_sym_info = A.supercell()->prim->sym_info;
-      m_fg_index_A = A.supercell_factor_group_index();
-      SupercellSymInfo const &supercell_sym_info = A.supercell()->sym_info;
-      Index prim_fg_index =
-          supercell_sym_info.factor_group->head_group_index[m_fg_index_A];
-      for (Index b = 0; b < m_n_sublat; ++b) {
-        Eigen::MatrixXd const &M =
-            prim_sym_info.local_dof_symgroup_rep.at(m_key)[prim_fg_index][b];
-        Index dim = M.cols();
-        sublattice_block(m_new_dof_A, b, m_n_vol).topRows(dim) =
-            M * sublattice_block(before, b, m_n_vol).topRows(dim);
-      }
+  /// Values of this config under the fg operation of `A` only, from the
+  /// cache if used, else transformed into 'm_new_dof_A'
+  Eigen::MatrixXd const &_transformed_A(SupercellSymOp const &A) const {
+    if (m_cache.has_value()) {
+      return m_cache->transformed(A);
     }
+    return _transform(A, _values(), m_before_A, m_fg_index_A, m_new_dof_A);
   }
 
-  void _update_B(SupercellSymOp const &B, Eigen::MatrixXd const &before) const {
-    using clexulator::sublattice_block;
-    if (B.supercell_factor_group_index() != m_fg_index_B || !m_tmp_valid) {
-      PrimSymInfo const &prim_sym_info = B.supercell()->prim->sym_info;
-      m_fg_index_B = B.supercell_factor_group_index();
-      SupercellSymInfo const &supercell_sym_info = B.supercell()->sym_info;
-      Index prim_fg_index =
-          supercell_sym_info.factor_group->head_group_index[m_fg_index_B];
-      for (Index b = 0; b < m_n_sublat; ++b) {
-        Eigen::MatrixXd const &M =
-            prim_sym_info.local_dof_symgroup_rep.at(m_key)[prim_fg_index][b];
-        Index dim = M.cols();
-        sublattice_block(m_new_dof_B, b, m_n_vol).topRows(dim) =
-            M * sublattice_block(before, b, m_n_vol).topRows(dim);
-      }
+  /// Values of this config under the fg operation of `B` only, from the
+  /// cache if used, else transformed into 'm_new_dof_B'
+  Eigen::MatrixXd const &_transformed_B(SupercellSymOp const &B) const {
+    if (m_cache.has_value()) {
+      return m_cache->transformed(B);
     }
+    return _transform(B, _values(), m_before_B, m_fg_index_B, m_new_dof_B);
   }
 
-  double new_dof_A(Index i, Index j) const { return m_new_dof_A(i, j); }
-
-  double new_dof_B(Index i, Index j) const { return m_new_dof_B(i, j); }
+  /// Transform `before` by the fg operation of `op` only, into `after`
+  ///
+  /// The transformation is skipped if `after` already holds `before`
+  /// transformed by the same prim factor group operation, as recorded by
+  /// `last_before` and `last_fg_index`, which are updated.
+  Eigen::MatrixXd const &_transform(SupercellSymOp const &op,
+                                    Eigen::MatrixXd const &before,
+                                    Eigen::MatrixXd const *&last_before,
+                                    Index &last_fg_index,
+                                    Eigen::MatrixXd &after) const {
+    using clexulator::sublattice_block;
+    Index prim_fg_index = op.prim_factor_group_index();
+    if (last_before == &before && last_fg_index == prim_fg_index) {
+      return after;
+    }
+    last_before = &before;
+    last_fg_index = prim_fg_index;
+    PrimSymInfo const &prim_sym_info = op.supercell()->prim->sym_info;
+    after = before;
+    for (Index b = 0; b < m_n_sublat; ++b) {
+      Eigen::MatrixXd const &M =
+          prim_sym_info.local_dof_symgroup_rep.at(m_key)[prim_fg_index][b];
+      Index dim = M.cols();
+      sublattice_block(after, b, m_n_vol).topRows(dim) =
+          M * sublattice_block(before, b, m_n_vol).topRows(dim);
+    }
+    return after;
+  }
 
   template <typename T>
   bool _check(const T &A, const T &B) const {
@@ -426,15 +442,18 @@ class Local {
   // Tolerance for comparisons
   double m_tol;
 
-  // Set to false when comparison is made to "other" ConfigDoF, to force update
-  // of temporary dof during the next comparison
-  mutable bool m_tmp_valid;
+  // DoFValues of this config under each fg operation only, if cached
+  std::optional<LocalDoFTransformCache> m_cache;
 
-  // Store temporary DoFValues under fg operation only:
+  // Store temporary DoFValues under fg operation only, if not cached, for
+  // "A", and for "B" or "other", with the values transformed and the prim
+  // factor group operation used last:
 
+  mutable Eigen::MatrixXd const *m_before_A;
   mutable Index m_fg_index_A;
   mutable Eigen::MatrixXd m_new_dof_A;
 
+  mutable Eigen::MatrixXd const *m_before_B;
   mutable Index m_fg_index_B;
   mutable Eigen::MatrixXd m_new_dof_B;
 
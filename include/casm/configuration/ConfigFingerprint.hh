@@ -0,0 +1,135 @@
+#ifndef CASM_config_ConfigFingerprint
+#define CASM_config_ConfigFingerprint
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief A fingerprint of a configuration's occupation that is invariant
+///     under SupercellSymOp
+///
+/// Equivalent configurations always have equal fingerprints. Configurations
+/// with equal fingerprints may or may not be equivalent.
+struct ConfigFingerprint {
+  /// \brief Number of sites with each occupant class
+  std::vector<Index> occupant_class_counts;
+
+  /// \brief Number of ordered pairs of sites, by distance shell and occupant
+  ///     classes, as `pair_counts[(shell * n_class + class_i) * n_class +
+  ///     class_j]`
+  std::vector<Index> pair_counts;
+
+  bool operator==(ConfigFingerprint const &rhs) const;
+
+  bool operator!=(ConfigFingerprint const &rhs) const;
+};
+
+/// \brief Hash a ConfigFingerprint, for use with unordered containers
+struct ConfigFingerprintHash {
+  std::size_t operator()(ConfigFingerprint const &fingerprint) const;
+};
+
+/// \brief Calculates ConfigFingerprint for configurations in one supercell
+///
+/// Notes:
+/// - Occupant classes are the orbits of (sublattice index, occupant index)
+///   under the prim factor group, so that counts are invariant when
+///   symmetry operations also transform occupants (i.e. molecular
+///   orientations)
+/// - Pairs are counted by distance, which is invariant under all supercell
+///   symmetry operations, for all pairs with distance less than or equal to
+///   `max_pair_distance`
+/// - Continuous DoF are not included. Configurations that differ only by
+///   continuous DoF values have equal fingerprints.
+class ConfigFingerprintCalculator {
+ public:
+  ConfigFingerprintCalculator(
+      std::shared_ptr<Supercell const> const &_supercell,
+      double max_pair_distance = -1.0);
+
+  /// \brief The supercell of configurations this calculates fingerprints for
+  std::shared_ptr<Supercell const> const supercell;
+
+  /// \brief Calculate the fingerprint of a configuration
+  ConfigFingerprint operator()(Configuration const &configuration) const;
+
+  /// \brief Number of occupant classes
+  Index n_occupant_classes() const;
+
+  /// \brief Distances of the pair shells that are counted
+  std::vector<double> const &shell_distances() const;
+
+ private:
+  /// \brief Occupant class, as `m_occupant_class[b][s]`
+  std::vector<std::vector<Index>> m_occupant_class;
+
+  Index m_n_occupant_classes;
+
+  std::vector<double> m_shell_distances;
+
+  /// \brief Neighbor site indices, and shell index, of each site, as
+  ///     `m_neighbors[l] = std::vector<std::pair<Index, Index>>{{l_2,
+  ///     shell_index}, ...}`
+  std::vector<std::vector<std::pair<Index, Index>>> m_neighbors;
+};
+
+/// \brief Collects symmetrically distinct configurations in one supercell,
+///     comparing canonical forms only when fingerprints are equal
+///
+/// Usage:
+/// \code
+/// ConfigFingerprintSet distinct(supercell);
+/// for (Configuration const &configuration : candidates) {
+///   if (distinct.insert(configuration)) {
+///     // configuration is not equivalent to any previously inserted
+///   }
+/// }
+/// \endcode
+///
+/// A candidate with a fingerprint that has not been seen before is inserted
+/// without generating its canonical form. Canonical forms are generated, and
+/// kept, only for configurations whose fingerprint is shared.
+class ConfigFingerprintSet {
+ public:
+  ConfigFingerprintSet(std::shared_ptr<Supercell const> const &_supercell,
+                       double max_pair_distance = -1.0);
+
+  /// \brief Insert a configuration, if not equivalent to any previously
+  ///     inserted configuration
+  bool insert(Configuration const &configuration);
+
+  /// \brief Number of distinct configurations
+  Index size() const;
+
+  /// \brief Distinct configurations, as inserted (not made canonical)
+  std::vector<Configuration> const &values() const;
+
+  /// \brief Number of canonical forms generated
+  Index n_canonical_forms() const;
+
+ private:
+  Configuration const &_canonical(Index i);
+
+  ConfigFingerprintCalculator m_calculator;
+
+  std::vector<Configuration> m_values;
+
+  std::vector<std::unique_ptr<Configuration>> m_canonical;
+
+  std::unordered_map<ConfigFingerprint, std::vector<Index>,
+                     ConfigFingerprintHash>
+      m_buckets;
+
+  Index m_n_canonical_forms;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
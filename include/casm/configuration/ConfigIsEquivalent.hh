@@ -93,6 +93,10 @@ inline ConfigIsEquivalent::ConfigIsEquivalent(
 
   if (m_check_occupation) {
     m_occupation_ptr = &dof_values.occupation;
+
+    // construct the combined permutation table, if within budget, so that
+    // occupation comparisons under symmetry use the gather-compare kernel
+    config().supercell->sym_info.combined_permutations->construct();
   }
 
   for (auto const &dof : dof_values.local_dof_values) {
@@ -3,6 +3,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "casm/configuration/Configuration.hh"
 #include "casm/configuration/definitions.hh"
@@ -40,6 +41,14 @@ struct ConfigurationRecord : public Comparisons<CRTPBase<ConfigurationRecord>> {
   friend struct Comparisons<CRTPBase<ConfigurationRecord>>;
 };
 
+/// \brief Hash of a configuration's supercell and occupation
+///
+/// Continuous DoF values are not included, so configurations that compare
+/// equal within tolerance always have equal hash values.
+struct ConfigurationOccupationHash {
+  std::size_t operator()(Configuration const &configuration) const;
+};
+
 /// \brief Data structure for holding / reading / writing canonical
 /// configurations
 ///
@@ -52,9 +61,33 @@ struct ConfigurationRecord : public Comparisons<CRTPBase<ConfigurationRecord>> {
 ///   use a std::vector<Configuration> or other container
 /// - Includes a map of supercell_name -> next configuration id that can
 ///   be used to automatically provide new configurations with sequential IDs
+/// - A hash index by configuration_name is kept consistent across insert and
+///   erase, so that `find_by_name`, `count_by_name`, and `erase_by_name` are
+///   O(1). If more than one record has the same configuration_name, the
+///   first, in set order, is found by name.
+/// - If `index_by_fingerprint` is true, a hash multimap by
+///   ConfigurationOccupationHash is also kept, so that `find`, `count`, and
+///   `erase` by Configuration only make full comparisons with records that
+///   have the same supercell and occupation
+/// - The non-const `data()` returns the underlying set for direct
+///   modification. Calling it invalidates the indexes. They are rebuilt by
+///   the next non-const ConfigurationSet member function call, and until
+///   then const lookups fall back to searching the set. Do not modify the
+///   set through a reference obtained from `data()` after calling other
+///   ConfigurationSet member functions.
+/// - Const member functions never modify the ConfigurationSet, so they may
+///   be called concurrently from multiple threads. Non-const member
+///   functions (including the non-const `data()`) must not be called
+///   concurrently with any other member function.
 class ConfigurationSet {
  public:
-  ConfigurationSet(std::map<std::string, Index> _next_config_id = {});
+  ConfigurationSet(std::map<std::string, Index> _next_config_id = {},
+                   bool _index_by_fingerprint = false);
+
+  ConfigurationSet(ConfigurationSet const &other);
+  ConfigurationSet(ConfigurationSet &&other) = default;
+  ConfigurationSet &operator=(ConfigurationSet const &other);
+  ConfigurationSet &operator=(ConfigurationSet &&other) = default;
 
   typedef std::set<ConfigurationRecord>::size_type size_type;
   typedef std::set<ConfigurationRecord>::iterator iterator;
@@ -107,11 +140,35 @@ class ConfigurationSet {
 
   std::set<ConfigurationRecord> const &data() const;
 
+  /// \brief If true, records are also indexed by ConfigurationOccupationHash
+  bool index_by_fingerprint() const;
+
  private:
+  /// \brief Add a record to the indexes
+  void _index(const_iterator it);
+
+  /// \brief Remove a record from the indexes
+  void _unindex(const_iterator it);
+
+  /// \brief Rebuild the indexes, if invalidated by `data()`
+  void _update_index();
+
   std::set<ConfigurationRecord> m_data;
 
   // map of supercell_name -> next id to assign to a new Configuration
   std::map<std::string, Index> m_next_config_id;
+
+  /// If true, maintain m_index_by_fingerprint
+  bool m_use_fingerprint_index;
+
+  /// False if `data()` may have been used to modify m_data
+  bool m_index_is_valid;
+
+  /// Index of records by configuration_name
+  std::unordered_multimap<std::string, const_iterator> m_index_by_name;
+
+  /// Index of records by ConfigurationOccupationHash
+  std::unordered_multimap<std::size_t, const_iterator> m_index_by_fingerprint;
 };
 
 /// \brief Make a map for finding ConfigurationRecord by configuration_name
@@ -0,0 +1,95 @@
+#ifndef CASM_config_LocalDoFTransformCache
+#define CASM_config_LocalDoFTransformCache
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+class SupercellSymOp;
+
+/// \brief Cache of local DoF values transformed by prim factor group
+///     operations
+///
+/// Local DoF values transformed by a SupercellSymOp only depend on the prim
+/// factor group operation, the lattice translation and the supercell factor
+/// group operation only permute sites. This caches the transformed, but not
+/// yet permuted, values by prim factor group index, so that applying or
+/// comparing many operations only requires permuting columns of the cached
+/// matrices.
+///
+/// Notes:
+/// - By default, the memory used by the cached values is limited to
+///   `default_max_bytes`.
+/// - If the cache is unbounded, or large enough for all prim factor group
+///   operations, all transformed values are constructed the first time
+///   any are requested, using one matrix product per sublattice.
+/// - Otherwise, transformed values are constructed as requested, and the
+///   least recently used are discarded to stay within the memory
+///   limit. At least two are always kept.
+/// - The cached values are only valid as long as the values the cache was
+///   constructed with are not modified. Use `clear` after modifying them.
+/// - Not safe to use from multiple threads at once.
+class LocalDoFTransformCache {
+ public:
+  /// \brief Default limit on the memory used by the cached values (64 MiB)
+  static constexpr Index default_max_bytes = Index(1) << 26;
+
+  /// \brief Constructor
+  LocalDoFTransformCache(Eigen::MatrixXd const &_values, DoFKey const &_key,
+                         Index _n_sublat,
+                         std::optional<Index> _max_bytes = default_max_bytes);
+
+  /// \brief Return local DoF values transformed by the prim factor group
+  ///     operation of `op`, before site permutation
+  Eigen::MatrixXd const &transformed(SupercellSymOp const &op) const;
+
+  /// \brief Return local DoF values transformed by a prim factor group
+  ///     operation, before site permutation
+  Eigen::MatrixXd const &transformed(Prim const &prim,
+                                     Index prim_fg_index) const;
+
+  /// \brief Number of transformed values currently cached
+  Index size() const;
+
+  /// \brief Erase all cached values
+  void clear() const;
+
+ private:
+  void _reset(Prim const &prim) const;
+
+  void _make_all() const;
+
+  void _make_one(Index prim_fg_index) const;
+
+  Eigen::MatrixXd const *m_values_ptr;
+
+  DoFKey m_key;
+
+  Index m_n_sublat;
+
+  Index m_n_vol;
+
+  std::optional<Index> m_max_bytes;
+
+  /// Prim of the cached values
+  mutable Prim const *m_prim;
+
+  /// Max number of cached values, for m_prim
+  mutable Index m_capacity;
+
+  /// Transformed values, by prim factor group index (empty if not cached)
+  mutable std::vector<Eigen::MatrixXd> m_transformed;
+
+  /// Cached prim factor group indices, least recently used first
+  mutable std::deque<Index> m_order;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
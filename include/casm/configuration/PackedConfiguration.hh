@@ -0,0 +1,133 @@
+#ifndef CASM_config_PackedConfiguration
+#define CASM_config_PackedConfiguration
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Holds supercells, which are referenced by a small integer handle
+///
+/// Notes:
+/// - Equivalent supercells (same prim and transformation matrix) share a
+///   handle
+/// - Handles are assigned in order of insertion, and are never invalidated
+/// - Thread-safe
+class SupercellHandleRegistry {
+ public:
+  typedef std::uint32_t handle_type;
+
+  /// \brief Return the handle for a supercell, inserting it if necessary
+  handle_type insert(std::shared_ptr<Supercell const> const &supercell);
+
+  /// \brief Return the supercell with the given handle
+  std::shared_ptr<Supercell const> const &supercell(handle_type handle) const;
+
+  /// \brief Number of supercells
+  Index size() const;
+
+ private:
+  mutable std::mutex m_mutex;
+
+  /// Supercells, by handle (std::deque, so that references remain valid)
+  std::deque<std::shared_ptr<Supercell const>> m_supercells;
+
+  std::map<std::shared_ptr<Supercell const>, handle_type,
+           CompareSharedSupercell>
+      m_handles;
+};
+
+/// \brief A compact configuration, for prim with only occupation DoF
+///
+/// Occupant indices are bit-packed into 64-bit words using 1, 2, or 4 bits
+/// per site (enough for the maximum number of occupants on any sublattice).
+/// Sites are packed starting from the most significant bits of the first
+/// word, and unused trailing bits are zero, so that comparing `words`
+/// lexicographically is equivalent to comparing occupation vectors
+/// lexicographically.
+///
+/// The supercell is referenced by a handle into a SupercellHandleRegistry.
+struct PackedConfiguration {
+  /// \brief Handle of the supercell in a SupercellHandleRegistry
+  SupercellHandleRegistry::handle_type supercell_handle = 0;
+
+  /// \brief Number of bits used for each site (1, 2, or 4)
+  std::uint8_t bits_per_site = 1;
+
+  /// \brief Number of sites
+  Index n_sites = 0;
+
+  /// \brief Packed occupation
+  std::vector<std::uint64_t> words;
+
+  /// \brief Return the occupant index on site l
+  int occupant(Index l) const {
+    Index sites_per_word = 64 / bits_per_site;
+    Index shift = 64 - bits_per_site * (l % sites_per_word + 1);
+    std::uint64_t mask = (std::uint64_t(1) << bits_per_site) - 1;
+    return (words[l / sites_per_word] >> shift) & mask;
+  }
+
+  /// \brief Less than comparison, by supercell handle, then occupation
+  ///
+  /// Within a supercell, this is consistent with Configuration ordering.
+  bool operator<(PackedConfiguration const &rhs) const {
+    if (supercell_handle != rhs.supercell_handle) {
+      return supercell_handle < rhs.supercell_handle;
+    }
+    return words < rhs.words;
+  }
+
+  bool operator==(PackedConfiguration const &rhs) const {
+    return supercell_handle == rhs.supercell_handle && words == rhs.words;
+  }
+
+  bool operator!=(PackedConfiguration const &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+/// \brief Hash a PackedConfiguration, for use with unordered containers
+struct PackedConfigurationHash {
+  std::size_t operator()(PackedConfiguration const &configuration) const;
+};
+
+/// \brief Return the number of bits per site used to pack configurations
+///     of a prim
+int packed_bits_per_site(Prim const &prim);
+
+/// \brief Pack occupation values
+PackedConfiguration pack(Eigen::VectorXi const &occupation,
+                         SupercellHandleRegistry::handle_type supercell_handle,
+                         int bits_per_site);
+
+/// \brief Unpack occupation values
+Eigen::VectorXi unpack_occupation(PackedConfiguration const &configuration);
+
+/// \brief Pack a Configuration
+PackedConfiguration pack(Configuration const &configuration,
+                         SupercellHandleRegistry &registry);
+
+/// \brief Unpack a PackedConfiguration
+Configuration unpack(PackedConfiguration const &configuration,
+                     SupercellHandleRegistry const &registry);
+
+/// \brief Return true if a PackedConfiguration is in canonical form
+bool is_canonical(PackedConfiguration const &configuration,
+                  SupercellHandleRegistry const &registry);
+
+/// \brief Return the canonical form of a PackedConfiguration
+PackedConfiguration make_canonical_form(
+    PackedConfiguration const &configuration,
+    SupercellHandleRegistry const &registry);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
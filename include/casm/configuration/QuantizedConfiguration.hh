@@ -0,0 +1,80 @@
+#ifndef CASM_config_QuantizedConfiguration
+#define CASM_config_QuantizedConfiguration
+
+#include <cstdint>
+#include <vector>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief A configuration with continuous DoF values snapped to an integer
+///     lattice, for exact comparison and hashing
+///
+/// Each continuous DoF value `x` is replaced by `tol * q`, where `q =
+/// std::llround(x / tol)`. All DoF values are stored as integers in `key`,
+/// so that comparisons are exact and do not need a tolerance:
+/// - global DoF values, by DoF type in `std::map` order, then
+/// - occupation, then
+/// - local DoF values, by DoF type in `std::map` order, by site, then by
+///   component (i.e. column-major).
+///
+/// This is the same order in which Configuration are compared, so ordering
+/// by `key` is consistent with Configuration ordering, except for values
+/// that differ by no more than `tol`, which Configuration comparison treats
+/// as equal.
+///
+/// Notes:
+/// - Only QuantizedConfiguration with the same `tol` should be compared
+/// - `configuration` and `key` must not be modified independently
+struct QuantizedConfiguration {
+  /// \brief Constructor, using the prim lattice tolerance
+  explicit QuantizedConfiguration(Configuration const &_configuration);
+
+  /// \brief Constructor
+  QuantizedConfiguration(Configuration const &_configuration, double _tol);
+
+  /// \brief Configuration, with continuous DoF values snapped to
+  ///     multiples of `tol`
+  Configuration configuration;
+
+  /// \brief Quantization tolerance
+  double tol;
+
+  /// \brief Quantized DoF values
+  std::vector<std::int64_t> key;
+
+  /// \brief Less than comparison, by `tol`, then supercell, then `key`
+  bool operator<(QuantizedConfiguration const &rhs) const;
+
+  bool operator==(QuantizedConfiguration const &rhs) const;
+
+  bool operator!=(QuantizedConfiguration const &rhs) const;
+};
+
+/// \brief Hash a QuantizedConfiguration, for use with unordered containers
+struct QuantizedConfigurationHash {
+  std::size_t operator()(QuantizedConfiguration const &configuration) const;
+};
+
+/// \brief Return DoF values quantized with tolerance `tol`
+std::vector<std::int64_t> make_quantized_dof_values(
+    clexulator::ConfigDoFValues const &dof_values, double tol);
+
+/// \brief Snap continuous DoF values to multiples of `tol`
+clexulator::ConfigDoFValues &snap(clexulator::ConfigDoFValues &dof_values,
+                                  double tol);
+
+/// \brief Return true if a QuantizedConfiguration is in canonical form
+bool is_canonical(QuantizedConfiguration const &configuration);
+
+/// \brief Return the canonical form of a QuantizedConfiguration
+QuantizedConfiguration make_canonical_form(
+    QuantizedConfiguration const &configuration);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -10,18 +10,23 @@
 namespace CASM {
 namespace config {
 
+class ThreadPool;
+
 /// \brief Specifies all the structural and symmetry information common for all
 /// configurations with the same supercell. All members are const.
 struct Supercell : public Comparisons<CRTPBase<Supercell>> {
   Supercell(std::shared_ptr<Prim const> const &_prim,
             Lattice const &_superlattice,
-            Index max_n_translation_permutations = 100);
+            Index max_n_translation_permutations = 100,
+            Index max_permutation_table_bytes = 1 << 27);
   Supercell(std::shared_ptr<Prim const> const &_prim,
             Superlattice const &_superlattice,
-            Index max_n_translation_permutations = 100);
+            Index max_n_translation_permutations = 100,
+            Index max_permutation_table_bytes = 1 << 27);
   Supercell(std::shared_ptr<Prim const> const &_prim,
             Eigen::Matrix3l const &_superlattice_matrix,
-            Index max_n_translation_permutations = 100);
+            Index max_n_translation_permutations = 100,
+            Index max_permutation_table_bytes = 1 << 27);
 
   /// \brief Species the primitive crystal structure (lattice and basis) and
   /// allowed degrees of freedom (DoF), and also symmetry representations
@@ -61,6 +66,28 @@ struct CompareSharedSupercell {
   }
 };
 
+/// \brief Construct the lazily constructed symmetry information of many
+///     supercells, in parallel
+void warm_sym_info(
+    std::vector<std::shared_ptr<Supercell const>> const &supercells,
+    ThreadPool &pool);
+
+/// \brief Return a shared Supercell, re-using an existing equivalent
+///     Supercell if one exists
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim,
+    Eigen::Matrix3l const &transformation_matrix_to_super);
+
+/// \brief Return a shared Supercell, re-using an existing equivalent
+///     Supercell if one exists
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim, Lattice const &superlattice);
+
+/// \brief Return a shared Supercell, re-using an existing equivalent
+///     Supercell if one exists
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim, Superlattice const &superlattice);
+
 }  // namespace config
 }  // namespace CASM
 
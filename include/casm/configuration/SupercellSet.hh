@@ -3,6 +3,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "casm/configuration/Supercell.hh"
 #include "casm/configuration/definitions.hh"
@@ -29,11 +30,40 @@ struct SupercellRecord : public Comparisons<CRTPBase<SupercellRecord>> {
   friend struct Comparisons<CRTPBase<SupercellRecord>>;
 };
 
+/// \brief Hash of an integer transformation matrix
+struct TransformationMatrixHash {
+  std::size_t operator()(Eigen::Matrix3l const &T) const;
+};
+
 /// \brief Data structure for holding / reading / writing supercells
+///
+/// Supercells are held in a `std::set<SupercellRecord>`. Hash indexes by
+/// transformation matrix and by canonical supercell name are kept
+/// consistent across insert and erase, so that `find`, `count`, `insert`,
+/// and `erase` by transformation matrix or canonical name are O(1).
+///
+/// Notes:
+/// - The non-const `data()` returns the underlying set for direct
+///   modification. Calling it invalidates the indexes. They are rebuilt by
+///   the next non-const SupercellSet member function call, and until then
+///   const lookups fall back to a linear search. Do not modify the set
+///   through a reference obtained from `data()` after calling other
+///   SupercellSet member functions.
+///
+/// Thread safety:
+/// - Const member functions never modify the SupercellSet, so they may be
+///   called concurrently from multiple threads
+/// - Non-const member functions (including the non-const `data()`) must not
+///   be called concurrently with any other member function
 class SupercellSet {
  public:
   SupercellSet(std::shared_ptr<Prim const> const &_prim);
 
+  SupercellSet(SupercellSet const &other);
+  SupercellSet(SupercellSet &&other) = default;
+  SupercellSet &operator=(SupercellSet const &other);
+  SupercellSet &operator=(SupercellSet &&other) = default;
+
   typedef std::set<SupercellRecord>::size_type size_type;
   typedef std::set<SupercellRecord>::iterator iterator;
   typedef std::set<SupercellRecord>::const_iterator const_iterator;
@@ -91,8 +121,27 @@ class SupercellSet {
   std::set<SupercellRecord> const &data() const;
 
  private:
+  /// \brief Add a record to the indexes
+  void _index(const_iterator it);
+
+  /// \brief Remove a record from the indexes
+  void _unindex(const_iterator it);
+
+  /// \brief Rebuild the indexes, if invalidated by `data()`
+  void _update_index();
+
   std::shared_ptr<Prim const> m_prim;
   std::set<SupercellRecord> m_data;
+
+  /// False if `data()` may have been used to modify m_data
+  bool m_index_is_valid;
+
+  /// Index of all records by transformation matrix
+  std::unordered_map<Eigen::Matrix3l, const_iterator, TransformationMatrixHash>
+      m_index_by_transformation_matrix;
+
+  /// Index of canonical records by supercell name
+  std::unordered_map<std::string, const_iterator> m_index_by_canonical_name;
 };
 
 /// \brief Make a map for finding canonical SupercellRecord by supercell_name
@@ -1,15 +1,251 @@
 #ifndef CASM_config_SupercellSymInfo
 #define CASM_config_SupercellSymInfo
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
 #include "casm/configuration/definitions.hh"
 #include "casm/configuration/sym_info/definitions.hh"
 
 namespace CASM {
 namespace config {
 
+/// \brief Flat table of combined factor group and translation permutations
+///
+/// Stores the permutations of all supercell operations, in the order of
+/// SupercellSymOp iteration, as one contiguous array of 16-bit (if the
+/// number of sites allows) or 32-bit indices:
+///
+/// \code
+/// permute_index(f, t, i) ==
+///     factor_group_permutations[f][translation_permutations[t][i]]
+/// \endcode
+class CombinedPermutationTable {
+ public:
+  /// \brief Constructor
+  CombinedPermutationTable(
+      std::vector<sym_info::Permutation> const &factor_group_permutations,
+      xtal::UnitCellIndexConverter const &unitcell_index_converter,
+      xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter);
+
+  /// \brief Number of bytes required for a table
+  static Index n_bytes(Index n_factor_group, Index n_translation,
+                       Index n_sites);
+
+  /// \brief Number of supercell factor group operations
+  Index n_factor_group() const { return m_n_factor_group; }
+
+  /// \brief Number of translations
+  Index n_translation() const { return m_n_translation; }
+
+  /// \brief Number of sites
+  Index n_sites() const { return m_n_sites; }
+
+  /// \brief Returns the index of the site containing the site DoF values that
+  ///     will be permuted onto site i by operation (f, t)
+  Index permute_index(Index f, Index t, Index i) const {
+    Index k = (f * m_n_translation + t) * m_n_sites + i;
+    return m_is_16bit ? Index(m_data_16bit[k]) : Index(m_data_32bit[k]);
+  }
+
+  /// \brief True if entries are 16-bit, else entries are 32-bit
+  bool is_16bit() const { return m_is_16bit; }
+
+  /// \brief Pointer to the permutation of operation (f, t), if entries are
+  ///     16-bit, else nullptr
+  std::uint16_t const *data_16bit(Index f, Index t) const {
+    if (!m_is_16bit) {
+      return nullptr;
+    }
+    return m_data_16bit.data() + (f * m_n_translation + t) * m_n_sites;
+  }
+
+  /// \brief Pointer to the permutation of operation (f, t), if entries are
+  ///     32-bit, else nullptr
+  std::uint32_t const *data_32bit(Index f, Index t) const {
+    if (m_is_16bit) {
+      return nullptr;
+    }
+    return m_data_32bit.data() + (f * m_n_translation + t) * m_n_sites;
+  }
+
+  /// \brief Copy the permutation of operation (f, t)
+  void copy_permutation(Index f, Index t,
+                        sym_info::Permutation &permutation) const;
+
+ private:
+  Index m_n_factor_group;
+  Index m_n_translation;
+  Index m_n_sites;
+  bool m_is_16bit;
+  std::vector<std::uint16_t> m_data_16bit;
+  std::vector<std::uint32_t> m_data_32bit;
+};
+
+/// \brief Constructs a CombinedPermutationTable on request, if within a
+///     byte budget
+///
+/// The table is constructed lazily, on the first call to `construct()`, if
+/// it fits within the byte budget. Canonical form and equivalence checks
+/// (ConfigIsEquivalent, make_canonical_forms) call `construct()`, so the
+/// table is available for repeated comparisons in one supercell. Other code
+/// uses `get_if_constructed()` and falls back to the factor group and
+/// translation permutations if the table is not available.
+///
+/// Thread-safe: The table is constructed once, by the first caller of
+/// `construct()`, and may then be shared across threads.
+class CombinedPermutationCache {
+ public:
+  /// \brief Constructor
+  CombinedPermutationCache(
+      std::shared_ptr<std::vector<sym_info::Permutation> const> const
+          &_factor_group_permutations,
+      Eigen::Matrix3l const &_transformation_matrix_to_super,
+      Index _n_sublattice, Index _max_n_bytes);
+
+  /// \brief True if the table fits within the byte budget
+  bool within_budget() const { return m_within_budget; }
+
+  /// \brief Return the table, constructing it if necessary, or nullptr if
+  ///     not within the byte budget
+  CombinedPermutationTable const *construct() const {
+    CombinedPermutationTable const *table =
+        m_table_ptr.load(std::memory_order_acquire);
+    if (table || !m_within_budget) {
+      return table;
+    }
+    return _construct();
+  }
+
+  /// \brief Return the table, if already constructed, else nullptr
+  CombinedPermutationTable const *get_if_constructed() const {
+    return m_table_ptr.load(std::memory_order_acquire);
+  }
+
+ private:
+  CombinedPermutationTable const *_construct() const;
+
+  /// Supercell factor group permutations, shared with SupercellSymInfo
+  std::shared_ptr<std::vector<sym_info::Permutation> const>
+      m_factor_group_permutations;
+  Eigen::Matrix3l m_transformation_matrix_to_super;
+  Index m_n_sublattice;
+  bool m_within_budget;
+
+  mutable std::once_flag m_once;
+  mutable std::unique_ptr<CombinedPermutationTable const> m_table;
+  mutable std::atomic<CombinedPermutationTable const *> m_table_ptr;
+};
+
+/// \brief A value constructed on first access
+///
+/// Thread-safe: The value is constructed once, by the first caller of
+/// `get()`, and may then be shared across threads. If construction throws,
+/// it is attempted again by the next caller.
+template <typename T>
+class LazyValue {
+ public:
+  LazyValue() : m_ptr(nullptr) {}
+
+  /// \brief Return the value, constructing it with `make()` on first use
+  template <typename MakeF>
+  T const &get(MakeF make) const {
+    T const *ptr = m_ptr.load(std::memory_order_acquire);
+    if (ptr) {
+      return *ptr;
+    }
+    std::call_once(m_once, [&]() {
+      m_value = std::make_unique<T const>(make());
+      m_ptr.store(m_value.get(), std::memory_order_release);
+    });
+    return *m_value;
+  }
+
+  /// \brief Return true if the value has been constructed
+  bool is_constructed() const {
+    return m_ptr.load(std::memory_order_acquire) != nullptr;
+  }
+
+ private:
+  mutable std::once_flag m_once;
+  mutable std::unique_ptr<T const> m_value;
+  mutable std::atomic<T const *> m_ptr;
+};
+
+/// \brief A member that is constructed on first access
+///
+/// Provides the access syntax of a data member of type T: implicit
+/// conversion to `T const &`, `*` and `->` (forwarded to T, if T is a
+/// pointer or optional), and `size()`, `empty()`, `operator[]`, `at()`,
+/// `begin()`, and `end()` (if T is a container). Copies share the
+/// constructed value.
+///
+/// Thread-safe: The value is constructed once, by the first access, and may
+/// then be shared across threads.
+template <typename T>
+class LazyMember {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param _make Constructs the value, on first access
+  explicit LazyMember(std::function<T()> _make)
+      : m_value(std::make_shared<LazyValue<T>>()), m_make(std::move(_make)) {}
+
+  /// \brief Return the value, constructing it on first use
+  T const &get() const { return m_value->get(m_make); }
+
+  /// \brief Return the value, constructing it on first use, sharing
+  ///     ownership with this member and its copies
+  std::shared_ptr<T const> get_shared() const {
+    return std::shared_ptr<T const>(m_value, &get());
+  }
+
+  /// \brief Return true if the value has been constructed
+  bool is_constructed() const { return m_value->is_constructed(); }
+
+  operator T const &() const { return get(); }
+
+  decltype(auto) operator*() const { return *get(); }
+
+  T const &operator->() const { return get(); }
+
+  bool has_value() const { return get().has_value(); }
+
+  Index size() const { return get().size(); }
+
+  bool empty() const { return get().empty(); }
+
+  decltype(auto) operator[](Index i) const { return get()[i]; }
+
+  decltype(auto) at(Index i) const { return get().at(i); }
+
+  auto begin() const { return get().begin(); }
+
+  auto end() const { return get().end(); }
+
+ private:
+  std::shared_ptr<LazyValue<T>> m_value;
+  std::function<T()> m_make;
+};
+
 /// \brief Data structure describing application of symmetry in a supercell
+///
+/// All members are constructed lazily, on first access, so that
+/// constructing a Supercell is cheap if its symmetry is never used.
+/// Construction is thread-safe, and copies of a SupercellSymInfo share
+/// the constructed members. Use `warm()`, or `warm_sym_info` for many
+/// supercells in parallel, to construct them in advance.
 struct SupercellSymInfo {
   /// \brief Constructor
+  SupercellSymInfo(std::shared_ptr<Prim const> const &prim,
+                   Superlattice const &superlattice,
+                   Index max_n_translation_permutations = 100,
+                   Index max_permutation_table_bytes = 1 << 27);
+
+  /// \brief Constructor (deprecated, the index converters are not used)
   SupercellSymInfo(
       std::shared_ptr<Prim const> const &prim, Superlattice const &superlattice,
       xtal::UnitCellIndexConverter const &unitcell_index_converter,
@@ -18,7 +254,7 @@ struct SupercellSymInfo {
 
   /// \brief The subgroup of the prim factor group that leaves
   /// the supercell lattice vectors invariant
-  std::shared_ptr<SymGroup const> factor_group;
+  LazyMember<std::shared_ptr<SymGroup const>> factor_group;
 
   /// \brief Describes how sites permute due to translations within the
   /// supercell
@@ -26,13 +262,51 @@ struct SupercellSymInfo {
   /// The number of translations is equal the supercell volume (as an integer
   /// multiple of the prim unit cell). Not populated for large supercells
   /// (n_unitcells > max_n_translation_permutations).
-  std::optional<std::vector<sym_info::Permutation>> translation_permutations;
+  LazyMember<std::optional<std::vector<sym_info::Permutation>>>
+      translation_permutations;
 
   /// \brief Describes how sites permute due to supercell factor group
   /// operations.
   ///
   /// There is one element for each element in the supercell factor group.
-  std::vector<sym_info::Permutation> factor_group_permutations;
+  LazyMember<std::vector<sym_info::Permutation>> factor_group_permutations;
+
+  /// \brief Integer point matrices of the supercell factor group operations
+  ///
+  /// These transform lattice translations, in fractional coordinates with
+  /// respect to the prim lattice. There is one element for each element in
+  /// the supercell factor group.
+  LazyMember<std::vector<Eigen::Matrix3l>> factor_group_point_matrices;
+
+  /// \brief Lattice translations relating products of supercell factor group
+  ///     operations
+  ///
+  /// For supercell factor group operations f1 and f2, with product
+  /// `f3 = factor_group->multiplication_table[f1][f2]`, applying f2 and
+  /// then f1 to a UnitCellCoord is equal to applying f3 and then translating
+  /// by `factor_group_product_translations[f1][f2]` (fractional coordinates
+  /// with respect to the prim lattice).
+  ///
+  /// Together with `factor_group->multiplication_table` and
+  /// `factor_group->inverse_index`, this allows finding products and
+  /// inverses of SupercellSymOp using only integer arithmetic.
+  LazyMember<std::vector<std::vector<Eigen::Vector3l>>>
+      factor_group_product_translations;
+
+  /// \brief Flat table of combined factor group and translation
+  ///     permutations, constructed lazily
+  ///
+  /// The table is constructed on the first call to
+  /// `combined_permutations->construct()`, by canonical form and equivalence
+  /// checks, and only if it requires no more than
+  /// max_permutation_table_bytes. It shares `factor_group_permutations`,
+  /// is shared by copies of this object, and may be used from multiple
+  /// threads.
+  LazyMember<std::shared_ptr<CombinedPermutationCache const>>
+      combined_permutations;
+
+  /// \brief Construct all lazily constructed members
+  void warm() const;
 };
 
 /// \brief Construct supercell factor group
@@ -56,6 +330,17 @@ std::vector<sym_info::Permutation> make_factor_group_permutations(
     sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep,
     xtal::UnitCellCoordIndexConverter const &bijk_index_converter);
 
+/// \brief Construct supercell factor group point matrices
+std::vector<Eigen::Matrix3l> make_factor_group_point_matrices(
+    std::vector<Index> const &head_group_index,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep);
+
+/// \brief Construct supercell factor group product translations
+std::vector<std::vector<Eigen::Vector3l>>
+make_factor_group_product_translations(
+    SymGroup const &factor_group,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep);
+
 }  // namespace config
 }  // namespace CASM
 
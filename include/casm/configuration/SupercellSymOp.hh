@@ -2,6 +2,7 @@
 #define CASM_config_SupercellSymOp
 
 #include <iterator>
+#include <type_traits>
 
 #include "casm/configuration/definitions.hh"
 #include "casm/configuration/sym_info/definitions.hh"
@@ -10,6 +11,45 @@
 namespace CASM {
 namespace config {
 
+class CombinedPermutationTable;
+
+/// \brief A trivially copyable, non-owning reference to a supercell operation
+///
+/// SupercellSymOpHandle holds a raw pointer to the supercell, a supercell
+/// factor group index, and a translation index. Copying it does not modify a
+/// reference count or allocate, so it is suitable for storing operations and
+/// passing them around in hot loops. The supercell must outlive the handle.
+///
+/// Convert to a SupercellSymOp with
+/// `SupercellSymOp(shared_supercell, handle)`, or re-point an existing
+/// SupercellSymOp, without copying it, with `SupercellSymOp::reset(handle)`.
+struct SupercellSymOpHandle {
+  Supercell const *supercell = nullptr;
+  Index supercell_factor_group_index = 0;
+  Index translation_index = 0;
+
+  /// \brief Less than comparison, in SupercellSymOp iteration order
+  bool operator<(SupercellSymOpHandle const &rhs) const {
+    if (supercell_factor_group_index == rhs.supercell_factor_group_index) {
+      return translation_index < rhs.translation_index;
+    }
+    return supercell_factor_group_index < rhs.supercell_factor_group_index;
+  }
+
+  bool operator==(SupercellSymOpHandle const &rhs) const {
+    return supercell == rhs.supercell &&
+           supercell_factor_group_index == rhs.supercell_factor_group_index &&
+           translation_index == rhs.translation_index;
+  }
+
+  bool operator!=(SupercellSymOpHandle const &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+static_assert(std::is_trivially_copyable<SupercellSymOpHandle>::value,
+              "SupercellSymOpHandle must be trivially copyable");
+
 /// \brief Represents and allows iteration over symmetry operations consistent
 /// with a given Supercell, combining pure factor group and pure translation
 /// operations.
@@ -63,6 +103,10 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
                  Index _supercell_factor_group_index,
                  Eigen::Vector3d const &_translation_cart);
 
+  /// Construct SupercellSymOp from a handle
+  SupercellSymOp(std::shared_ptr<Supercell const> const &_supercell,
+                 SupercellSymOpHandle const &_handle);
+
   /// \brief Make supercell symop begin iterator
   static SupercellSymOp begin(
       std::shared_ptr<Supercell const> const &_supercell);
@@ -88,6 +132,13 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
 
   xtal::UnitCell translation_frac() const;
 
+  /// \brief Return a non-owning handle to this operation
+  SupercellSymOpHandle handle() const;
+
+  /// \brief Set this to the operation referenced by a handle, without
+  ///     changing the supercell
+  SupercellSymOp &reset(SupercellSymOpHandle const &_handle);
+
   /// \brief Returns the index of the site containing the site DoF values that
   ///     will be permuted onto site i
   Index permute_index(Index i) const;
@@ -122,6 +173,10 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
   /// translation permutation
   sym_info::Permutation combined_permute() const;
 
+  /// Sets `permutation` to the combination of factor group operation
+  /// permutation and translation permutation, re-using its storage
+  void combined_permute(sym_info::Permutation &permutation) const;
+
   /// \brief Returns the inverse supercell operation
   SupercellSymOp inverse() const;
 
@@ -139,6 +194,9 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
   /// \brief Equality comparison (used to implement operator==)
   bool eq_impl(const SupercellSymOp &iter) const;
 
+  /// \brief Update the cached permutation pointers for the current operation
+  void _update_permute_ptrs();
+
   std::shared_ptr<Supercell const> m_supercell;
 
   /// \brief Supercell factor group index
@@ -183,8 +241,43 @@ class SupercellSymOp : public Comparisons<CRTPBase<SupercellSymOp>> {
 
   /// \brief Index of translation currently stored in m_tmp_translation_permute
   mutable Index m_tmp_translation_index;
+
+  /// \brief Use to hold current translation, as a UnitCell, for
+  ///     calculating permute_index without a translation permutation
+  mutable Eigen::Vector3l m_tmp_translation_frac;
+
+  /// \brief Index of translation currently stored in m_tmp_translation_frac
+  mutable Index m_tmp_translation_frac_index;
+
+  /// \brief Combined permutation table, if constructed when this operation
+  ///     was last constructed or changed, else nullptr
+  ///
+  /// The permute pointers are resolved by `_update_permute_ptrs` when the
+  /// operation is constructed, incremented, decremented, or reset, so that
+  /// `permute_index` does not access the lazily constructed SupercellSymInfo
+  /// members on every call.
+  CombinedPermutationTable const *m_table;
+
+  /// \brief Factor group permutation for the current operation, or nullptr
+  ///     if m_table is used or this is an end iterator
+  Index const *m_fg_permute;
+
+  /// \brief Translation permutation for the current operation, if held by
+  ///     SupercellSymInfo and m_table is not used, else nullptr
+  Index const *m_trans_permute;
 };
 
+/// \brief Return non-owning handles to the operations in [begin, end)
+template <typename SupercellSymOpIt>
+std::vector<SupercellSymOpHandle> make_handles(SupercellSymOpIt begin,
+                                               SupercellSymOpIt end) {
+  std::vector<SupercellSymOpHandle> handles;
+  for (auto it = begin; it != end; ++it) {
+    handles.push_back(it->handle());
+  }
+  return handles;
+}
+
 /// \brief Return inverse SymOp
 SymOp inverse(SymOp const &op);
 
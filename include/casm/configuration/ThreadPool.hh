@@ -0,0 +1,68 @@
+#ifndef CASM_config_ThreadPool
+#define CASM_config_ThreadPool
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief A fixed size pool of worker threads
+///
+/// Usage:
+/// \code
+/// ThreadPool pool(8);
+/// std::vector<double> result(n);
+/// pool.parallel_for(n, [&](Index begin, Index end) {
+///   for (Index i = begin; i < end; ++i) {
+///     result[i] = f(i);
+///   }
+/// });
+/// \endcode
+///
+/// Notes:
+/// - `parallel_for` blocks until all work is complete and re-throws the
+///   first exception thrown by a task
+/// - `parallel_for` must not be called from within a task running on the
+///   same pool
+class ThreadPool {
+ public:
+  /// \brief Constructor
+  explicit ThreadPool(Index _n_threads = 0);
+
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  /// \brief Number of worker threads
+  Index size() const;
+
+  /// \brief Partition [0, n) into contiguous blocks and call f(begin, end)
+  ///     for each block, in parallel
+  void parallel_for(Index n, std::function<void(Index, Index)> f,
+                    Index n_blocks = -1);
+
+ private:
+  void _work();
+
+  std::vector<std::thread> m_threads;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop;
+};
+
+/// \brief Partition [0, n) into `n_blocks` contiguous blocks
+std::vector<std::pair<Index, Index>> make_blocks(Index n, Index n_blocks);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
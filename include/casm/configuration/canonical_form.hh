@@ -30,12 +30,56 @@ SymOp to_canonical(Supercell const &supercell);
 ///     supercell lattice
 SymOp from_canonical(Supercell const &supercell);
 
+/// \brief Results of a canonical supercell search
+struct SupercellCanonicalSearchResult {
+  /// \brief The transformation matrix of the canonical supercell
+  Eigen::Matrix3l canonical_transformation_matrix;
+
+  /// \brief True if the supercell is the canonical supercell
+  bool is_canonical;
+
+  /// \brief Index into the prim point group of the first operation that
+  ///     makes the supercell lattice canonical
+  Index to_canonical_index;
+
+  /// \brief Index into the prim point group of the inverse of
+  ///     `to_canonical_index`, which makes the supercell lattice from the
+  ///     canonical supercell lattice
+  Index from_canonical_index;
+
+  /// \brief Indices into the prim point group of the operations that leave
+  ///     the supercell lattice invariant
+  std::vector<Index> invariant_subgroup_indices;
+};
+
+/// \brief Find the canonical supercell, the operations to and from it, and
+///     the invariant subgroup in a single search using integer arithmetic
+SupercellCanonicalSearchResult canonical_supercell_search(
+    Supercell const &supercell);
+
+/// \brief Find the canonical supercell, the operations to and from it, and
+///     the invariant subgroup, given a supercell transformation matrix
+SupercellCanonicalSearchResult canonical_supercell_search(
+    std::shared_ptr<Prim const> const &prim, Eigen::Matrix3l const &T);
+
 /// \brief Return the supercell with distinct symmetrically equivalent lattices
 std::vector<std::shared_ptr<Supercell const>> make_equivalents(
     Supercell const &supercell);
 
 // --- Configuration ---
 
+/// \brief Return true if configuration is in canonical form, using all
+///     operations consistent with its supercell
+bool is_canonical(Configuration const &configuration);
+
+/// \brief Return the configuration that compares greater to all equivalents in
+///     the same supercell, using all operations consistent with its supercell
+Configuration make_canonical_form(Configuration const &configuration);
+
+/// \brief Return rep that makes a configuration canonical, using all
+///     operations consistent with its supercell
+SupercellSymOp to_canonical(Configuration const &configuration);
+
 /// \brief Return true if configuration is in canonical form
 template <typename SupercellSymOpIt>
 bool is_canonical(Configuration const &configuration, SupercellSymOpIt begin,
@@ -90,6 +134,25 @@ std::vector<std::vector<SupercellSymOp>> make_equivalence_map(
     std::vector<ConfigurationWithProperties> const &equivalents_with_properties,
     SupercellSymOpIt begin, SupercellSymOpIt end);
 
+/// \brief Distinct symmetrically equivalent configurations, and the
+///     operations that generate each
+struct EquivalentsResult {
+  /// \brief The distinct equivalent configurations, in the same order as
+  ///     returned by `make_equivalents`
+  std::vector<Configuration> equivalents;
+
+  /// \brief The operations, in `[begin, end)` order, that satisfy
+  ///     `equivalents[i] == copy_apply(op, configuration)`
+  std::vector<std::vector<SupercellSymOp>> equivalence_map;
+};
+
+/// \brief Return the distinct symmetrically equivalent configurations, by
+///     applying one operation per left coset of the invariant subgroup
+template <typename SupercellSymOpIt>
+EquivalentsResult make_equivalents_by_cosets(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end);
+
 /// \brief Return true if the operation does not mix given sites and other
 /// sites
 bool site_indices_are_invariant(SupercellSymOp const &op,
@@ -153,8 +216,18 @@ Configuration make_canonical_form(Configuration const &configuration,
 template <typename SupercellSymOpIt>
 SupercellSymOp to_canonical(Configuration const &configuration,
                             SupercellSymOpIt begin, SupercellSymOpIt end) {
+  if (begin == end) {
+    throw std::runtime_error("Error in to_canonical: no operations");
+  }
+  // the greatest so far is re-pointed with a handle, rather than copied
   ConfigCompare compare_f(configuration);
-  return *std::max_element(begin, end, compare_f);
+  SupercellSymOp _to_canonical(*begin);
+  for (auto it = begin; it != end; ++it) {
+    if (compare_f(_to_canonical, *it)) {
+      _to_canonical.reset(it->handle());
+    }
+  }
+  return _to_canonical;
 }
 
 /// \brief Return rep that makes a configuration from the canonical
@@ -171,19 +244,19 @@ SupercellSymOp from_canonical(Configuration const &configuration,
   // alternate version: the lowest index element that transforms canonical form
   // to this
   ConfigCompare compare_f(configuration);
-  auto _to_canonical = begin;
-  auto _from_canonical = _to_canonical->inverse();
+  SupercellSymOp _to_canonical(*begin);
+  SupercellSymOp _from_canonical = _to_canonical.inverse();
   for (auto it = begin; it < end; ++it) {
-    if (compare_f(*_to_canonical, *it)) {
-      _to_canonical = it;
-      _from_canonical = _to_canonical->inverse();
+    if (compare_f(_to_canonical, *it)) {
+      _to_canonical.reset(it->handle());
+      _from_canonical.reset(it->inverse().handle());
     }
     // other permutations that result in canonical config may have a lower index
     // inverse
-    else if (!compare_f(*it, *_to_canonical)) {
-      auto it_inv = it->inverse();
-      if (it_inv < _from_canonical) {
-        _from_canonical = it_inv;
+    else if (!compare_f(*it, _to_canonical)) {
+      SupercellSymOpHandle it_inv = it->inverse().handle();
+      if (it_inv < _from_canonical.handle()) {
+        _from_canonical.reset(it_inv);
       }
     }
   }
@@ -387,6 +460,101 @@ std::vector<SupercellSymOp> make_invariant_subgroup(
                                  config_factor_group.end());
 }
 
+/// \brief Return the distinct symmetrically equivalent configurations, by
+///     applying one operation per left coset of the invariant subgroup
+///
+/// The result is the same as `make_equivalents(configuration, begin, end)`,
+/// but is obtained by:
+/// - finding the subgroup, H, of `[begin, end)` that leaves `configuration`
+///   invariant, using in-place comparisons,
+/// - applying only one operation, g, per left coset gH, since all operations
+///   in gH generate the same equivalent configuration.
+///
+/// This makes |G|/|H| configuration copies, instead of |G|, and also gives
+/// the equivalence map as a by-product.
+///
+/// \param configuration The configuration
+/// \param begin,end The operations used to generate the equivalents. Must
+///     form a group of operations of `configuration.supercell`.
+///
+/// \returns An EquivalentsResult, with `equivalence_map[i]` being the
+///     operations in `[begin, end)` which generate `equivalents[i]` from
+///     `configuration`.
+///
+/// \throws If `[begin, end)` is not closed under multiplication
+template <typename SupercellSymOpIt>
+EquivalentsResult make_equivalents_by_cosets(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end) {
+  std::vector<SupercellSymOpHandle> ops = make_handles(begin, end);
+  EquivalentsResult result;
+  if (ops.empty()) {
+    return result;
+  }
+  SupercellSymOp op(*begin);
+
+  // position of each operation in ops, by `f * n_translations + t`
+  Supercell const &supercell = *configuration.supercell;
+  Index n_translations = supercell.unitcell_index_converter.total_sites();
+  Index n_factor_group = supercell.sym_info.factor_group->element.size();
+  std::vector<Index> position(n_factor_group * n_translations, -1);
+  for (Index i = 0; i < ops.size(); ++i) {
+    position[ops[i].supercell_factor_group_index * n_translations +
+             ops[i].translation_index] = i;
+  }
+
+  std::vector<SupercellSymOp> subgroup =
+      make_invariant_subgroup(configuration, begin, end);
+
+  // each left coset, g*H, generates one distinct equivalent: g*h applied to
+  // configuration is equal to g applied to configuration
+  std::vector<bool> is_assigned(ops.size(), false);
+  std::vector<std::pair<Configuration, std::vector<Index>>> cosets;
+  for (Index i = 0; i < ops.size(); ++i) {
+    if (is_assigned[i]) {
+      continue;
+    }
+    op.reset(ops[i]);
+    std::vector<Index> coset;
+    for (auto const &h : subgroup) {
+      SupercellSymOp product = op * h;
+      Index j = position[product.supercell_factor_group_index() *
+                             n_translations +
+                         product.translation_index()];
+      if (j == -1 || is_assigned[j]) {
+        throw std::runtime_error(
+            "Error in make_equivalents_by_cosets: operations do not form a "
+            "group");
+      }
+      is_assigned[j] = true;
+      coset.push_back(j);
+    }
+    if (!is_assigned[i]) {
+      throw std::runtime_error(
+          "Error in make_equivalents_by_cosets: operations do not form a "
+          "group");
+    }
+    std::sort(coset.begin(), coset.end());
+    cosets.emplace_back(copy_apply(op, configuration), std::move(coset));
+  }
+
+  std::sort(cosets.begin(), cosets.end(),
+            [](std::pair<Configuration, std::vector<Index>> const &A,
+               std::pair<Configuration, std::vector<Index>> const &B) {
+              return A.first < B.first;
+            });
+
+  for (auto &coset : cosets) {
+    result.equivalents.push_back(std::move(coset.first));
+    std::vector<SupercellSymOp> coset_ops;
+    for (Index j : coset.second) {
+      coset_ops.emplace_back(op.supercell(), ops[j]);
+    }
+    result.equivalence_map.push_back(std::move(coset_ops));
+  }
+  return result;
+}
+
 }  // namespace config
 }  // namespace CASM
 
@@ -0,0 +1,203 @@
+#ifndef CASM_config_canonical_form_parallel
+#define CASM_config_canonical_form_parallel
+
+#include "casm/configuration/canonical_form.hh"
+
+namespace CASM {
+namespace config {
+
+class ThreadPool;
+
+/// \brief Return rep that makes a configuration canonical, comparing
+///     operations in parallel
+template <typename SupercellSymOpIt>
+SupercellSymOp to_canonical(Configuration const &configuration,
+                            SupercellSymOpIt begin, SupercellSymOpIt end,
+                            ThreadPool &pool);
+
+/// \brief Return the configuration that compares greater to all equivalents in
+///     the same supercell, comparing operations in parallel
+template <typename SupercellSymOpIt>
+Configuration make_canonical_form(Configuration const &configuration,
+                                  SupercellSymOpIt begin, SupercellSymOpIt end,
+                                  ThreadPool &pool);
+
+/// \brief Return rep that leave configuration invariant, comparing operations
+///     in parallel
+template <typename SupercellSymOpIt>
+std::vector<SupercellSymOp> make_invariant_subgroup(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end, ThreadPool &pool);
+
+/// \brief Return the distinct symmetrically equivalent configurations,
+///     applying operations in parallel
+template <typename SupercellSymOpIt>
+std::vector<Configuration> make_equivalents(Configuration const &configuration,
+                                            SupercellSymOpIt begin,
+                                            SupercellSymOpIt end,
+                                            ThreadPool &pool);
+
+}  // namespace config
+}  // namespace CASM
+
+// --- Implementation ---
+
+#include "casm/configuration/ThreadPool.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Return rep that makes a configuration canonical, comparing
+///     operations in parallel
+///
+/// The result, `rep`, is the first in `[begin, end)` that satisfies:
+///     canonical_configuration == copy_apply(rep, configuration)
+///
+/// Each block of operations is reduced to its first greatest element, then
+/// blocks are reduced in order, so the result is the same as the serial
+/// version, independent of the number of threads.
+template <typename SupercellSymOpIt>
+SupercellSymOp to_canonical(Configuration const &configuration,
+                            SupercellSymOpIt begin, SupercellSymOpIt end,
+                            ThreadPool &pool) {
+  std::vector<SupercellSymOpHandle> ops = make_handles(begin, end);
+  if (ops.empty()) {
+    throw std::runtime_error("Error in to_canonical: no operations");
+  }
+  SupercellSymOp const prototype(*begin);
+  std::vector<std::pair<Index, Index>> blocks =
+      make_blocks(ops.size(), 4 * pool.size());
+  std::vector<Index> block_max(blocks.size());
+  pool.parallel_for(
+      blocks.size(),
+      [&](Index block_begin, Index block_end) {
+        // each thread re-points its own ops, which avoids shared reference
+        // count updates
+        ConfigCompare compare_f(configuration);
+        SupercellSymOp best_op(prototype);
+        SupercellSymOp op(prototype);
+        for (Index i = block_begin; i < block_end; ++i) {
+          Index best = blocks[i].first;
+          best_op.reset(ops[best]);
+          for (Index j = best + 1; j < blocks[i].second; ++j) {
+            if (compare_f(best_op, op.reset(ops[j]))) {
+              best = j;
+              best_op.reset(ops[j]);
+            }
+          }
+          block_max[i] = best;
+        }
+      },
+      blocks.size());
+
+  ConfigCompare compare_f(configuration);
+  SupercellSymOp best_op(prototype);
+  SupercellSymOp op(prototype);
+  best_op.reset(ops[block_max[0]]);
+  for (Index i : block_max) {
+    if (compare_f(best_op, op.reset(ops[i]))) {
+      best_op.reset(ops[i]);
+    }
+  }
+  return best_op;
+}
+
+/// \brief Return the configuration that compares greater to all equivalents in
+///     the same supercell, comparing operations in parallel
+///
+/// The result, `canonical_configuration` satisfies for all `rep` in `[begin,
+/// end)`:
+///     canonical_configuration >= copy_apply(rep, configuration)
+template <typename SupercellSymOpIt>
+Configuration make_canonical_form(Configuration const &configuration,
+                                  SupercellSymOpIt begin, SupercellSymOpIt end,
+                                  ThreadPool &pool) {
+  return copy_apply(to_canonical(configuration, begin, end, pool),
+                    configuration);
+}
+
+/// \brief Return rep that leave configuration invariant, comparing operations
+///     in parallel
+///
+/// The results, `rep`, are the elements in `[begin, end)` that satisfy:
+///     configuration == copy_apply(rep, configuration)
+///
+/// The results are in the same order as the serial version.
+template <typename SupercellSymOpIt>
+std::vector<SupercellSymOp> make_invariant_subgroup(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end, ThreadPool &pool) {
+  std::vector<SupercellSymOpHandle> ops = make_handles(begin, end);
+  std::vector<SupercellSymOp> result;
+  if (ops.empty()) {
+    return result;
+  }
+  SupercellSymOp const prototype(*begin);
+  std::vector<std::pair<Index, Index>> blocks =
+      make_blocks(ops.size(), 4 * pool.size());
+  std::vector<std::vector<SupercellSymOpHandle>> block_subgroup(
+      blocks.size());
+  pool.parallel_for(
+      blocks.size(),
+      [&](Index block_begin, Index block_end) {
+        ConfigIsEquivalent equal_to_f(configuration);
+        SupercellSymOp op(prototype);
+        for (Index i = block_begin; i < block_end; ++i) {
+          for (Index j = blocks[i].first; j < blocks[i].second; ++j) {
+            if (equal_to_f(op.reset(ops[j]))) {
+              block_subgroup[i].push_back(ops[j]);
+            }
+          }
+        }
+      },
+      blocks.size());
+
+  for (auto const &subgroup : block_subgroup) {
+    for (auto const &handle : subgroup) {
+      result.emplace_back(prototype.supercell(), handle);
+    }
+  }
+  return result;
+}
+
+/// \brief Return the distinct symmetrically equivalent configurations,
+///     applying operations in parallel
+///
+/// The result is the same, and in the same order, as the serial version.
+template <typename SupercellSymOpIt>
+std::vector<Configuration> make_equivalents(Configuration const &configuration,
+                                            SupercellSymOpIt begin,
+                                            SupercellSymOpIt end,
+                                            ThreadPool &pool) {
+  std::vector<SupercellSymOpHandle> ops = make_handles(begin, end);
+  if (ops.empty()) {
+    return std::vector<Configuration>();
+  }
+  SupercellSymOp const prototype(*begin);
+  std::vector<std::pair<Index, Index>> blocks =
+      make_blocks(ops.size(), 4 * pool.size());
+  std::vector<std::set<Configuration>> block_equivalents(blocks.size());
+  pool.parallel_for(
+      blocks.size(),
+      [&](Index block_begin, Index block_end) {
+        SupercellSymOp op(prototype);
+        for (Index i = block_begin; i < block_end; ++i) {
+          for (Index j = blocks[i].first; j < blocks[i].second; ++j) {
+            block_equivalents[i].emplace(
+                copy_apply(op.reset(ops[j]), configuration));
+          }
+        }
+      },
+      blocks.size());
+
+  std::set<Configuration> equivalents;
+  for (auto &block : block_equivalents) {
+    equivalents.insert(block.begin(), block.end());
+  }
+  return std::vector<Configuration>(equivalents.begin(), equivalents.end());
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
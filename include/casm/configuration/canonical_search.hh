@@ -0,0 +1,107 @@
+#ifndef CASM_config_canonical_search
+#define CASM_config_canonical_search
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+class ThreadPool;
+class TranslationArithmetic;
+
+/// \brief Results of a canonical form search
+struct CanonicalFormSearchResult {
+  CanonicalFormSearchResult(Configuration const &_canonical_configuration,
+                            SupercellSymOp const &_to_canonical,
+                            std::vector<SupercellSymOp> const &_invariant_subgroup);
+
+  /// \brief The configuration that compares greater to all equivalents
+  ///     generated by the searched operations
+  Configuration canonical_configuration;
+
+  /// \brief The first operation that makes the configuration canonical
+  SupercellSymOp to_canonical;
+
+  /// \brief The searched operations that leave the configuration invariant
+  std::vector<SupercellSymOp> invariant_subgroup;
+};
+
+/// \brief Find the canonical form, the operation that makes a configuration
+///     canonical, and the invariant subgroup in a single search
+CanonicalFormSearchResult canonical_form_search(
+    Configuration const &configuration, std::vector<SupercellSymOp> const &ops);
+
+/// \brief Canonical forms of many configurations
+struct CanonicalFormsResult {
+  /// \brief The canonical configurations, in the order of the input
+  ///     configurations
+  std::vector<Configuration> canonical_configurations;
+
+  /// \brief The operations that make each input configuration canonical
+  std::vector<SupercellSymOp> to_canonical;
+};
+
+/// \brief Return reps that make configurations canonical, for configurations
+///     in the same supercell
+std::vector<SupercellSymOp> to_canonical(
+    std::vector<Configuration const *> const &configurations,
+    TranslationArithmetic const &arithmetic);
+
+/// \brief Make canonical forms of many configurations, sharing precomputed
+///     tables for configurations in the same supercell
+CanonicalFormsResult make_canonical_forms(
+    std::vector<Configuration> const &configurations, Index block_size = 64,
+    Index max_table_size = 1 << 22);
+
+/// \brief Make canonical forms of many configurations, sharing precomputed
+///     tables for configurations in the same supercell and processing blocks
+///     in parallel
+CanonicalFormsResult make_canonical_forms(
+    std::vector<Configuration> const &configurations, ThreadPool &pool,
+    Index block_size = 64, Index max_table_size = 1 << 22);
+
+/// \brief Find the canonical form, the operation that makes a configuration
+///     canonical, and the invariant subgroup in a single search
+template <typename SupercellSymOpIt>
+CanonicalFormSearchResult canonical_form_search(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end);
+
+}  // namespace config
+}  // namespace CASM
+
+// --- Implementation ---
+
+namespace CASM {
+namespace config {
+
+/// \brief Find the canonical form, the operation that makes a configuration
+///     canonical, and the invariant subgroup in a single search
+///
+/// The results are the same as, but obtained faster than:
+/// \code
+/// CanonicalFormSearchResult(
+///     make_canonical_form(configuration, begin, end),
+///     to_canonical(configuration, begin, end),
+///     make_invariant_subgroup(configuration, begin, end));
+/// \endcode
+///
+/// See `canonical_form_search(Configuration const &,
+/// std::vector<SupercellSymOp> const &)` for details.
+template <typename SupercellSymOpIt>
+CanonicalFormSearchResult canonical_form_search(
+    Configuration const &configuration, SupercellSymOpIt begin,
+    SupercellSymOpIt end) {
+  std::vector<SupercellSymOp> ops;
+  for (auto it = begin; it != end; ++it) {
+    ops.push_back(*it);
+  }
+  return canonical_form_search(configuration, ops);
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
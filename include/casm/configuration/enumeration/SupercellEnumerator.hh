@@ -0,0 +1,107 @@
+#ifndef CASM_config_enum_SupercellEnumerator
+#define CASM_config_enum_SupercellEnumerator
+
+#include <array>
+#include <string>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+class ThreadPool;
+
+/// Enumerate over canonical supercells, in order of increasing volume
+///
+/// Hermite normal form (HNF) transformation matrices are generated directly
+/// for each volume. A HNF, H, is kept only if it is the greatest of the HNF
+/// of `R * H`, for all prim point group operations R in integer fractional
+/// coordinates, so one supercell is generated per orbit of equivalent
+/// supercells. Results are returned in canonical form, as by
+/// `make_canonical_form(Supercell const &)`.
+///
+/// Example:
+/// \code
+/// std::vector<std::shared_ptr<Supercell const>> supercells;
+/// SupercellEnumerator enumerator(prim, 1, 24);
+/// while (enumerator.is_valid()) {
+///   supercells.push_back(enumerator.value());
+///   enumerator.advance();
+/// }
+/// \endcode
+///
+/// If a ThreadPool is given, consecutive volumes are enumerated in parallel,
+/// one volume per task, and results are returned in the same order as the
+/// serial enumeration.
+///
+class SupercellEnumerator {
+ public:
+  /// \brief Constructor
+  SupercellEnumerator(
+      std::shared_ptr<Prim const> const &prim, Index min_volume,
+      Index max_volume, std::string dirs = "abc",
+      Eigen::Matrix3l const &unit_cell = Eigen::Matrix3l::Identity());
+
+  /// \brief Constructor, enumerating volumes in parallel
+  SupercellEnumerator(std::shared_ptr<Prim const> const &prim,
+                      Index min_volume, Index max_volume, std::string dirs,
+                      Eigen::Matrix3l const &unit_cell, ThreadPool &pool);
+
+  /// \brief Get the current Supercell
+  std::shared_ptr<Supercell const> const &value() const;
+
+  /// \brief Generate the next Supercell
+  void advance();
+
+  /// \brief Return true if `value` is valid, false if no more valid values
+  bool is_valid() const;
+
+ private:
+  SupercellEnumerator(std::shared_ptr<Prim const> const &prim,
+                      Index min_volume, Index max_volume, std::string dirs,
+                      Eigen::Matrix3l const &unit_cell, ThreadPool *pool);
+
+  /// \brief Enumerate the next volume(s) with results
+  void _load();
+
+  /// \brief Return canonical supercells of a particular volume
+  std::vector<std::shared_ptr<Supercell const>> _enumerate_volume(
+      Index volume) const;
+
+  /// \brief Return true if H is the greatest of its equivalent HNF
+  bool _is_canonical_hnf(Eigen::Matrix3l const &H) const;
+
+  std::shared_ptr<Prim const> m_prim;
+
+  Index m_max_volume;
+
+  /// Unit cell, as a transformation matrix of the prim lattice
+  Eigen::Matrix3l m_unit_cell;
+
+  /// If m_dirs[i], enumerate along unit cell vector i
+  std::array<bool, 3> m_dirs;
+
+  /// Point group operations that preserve the unit cell and dirs
+  /// restrictions, in fractional coordinates of the unit cell
+  std::vector<Eigen::Matrix3l> m_point_matrices;
+
+  /// True if m_point_matrices is a proper subgroup of the prim point group
+  bool m_is_restricted;
+
+  /// If not null, enumerate volumes in parallel
+  ThreadPool *m_pool;
+
+  /// Next volume to enumerate
+  Index m_next_volume;
+
+  /// Supercells of the most recently enumerated volume(s)
+  std::vector<std::shared_ptr<Supercell const>> m_batch;
+
+  /// Index of the current supercell in m_batch
+  Index m_index;
+};
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef CASM_config_fused_apply
+#define CASM_config_fused_apply
+
+#include <map>
+#include <string>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/LocalDoFTransformCache.hh"
+#include "casm/configuration/sym_info/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+class SupercellSymOp;
+
+/// \brief Re-usable buffers for `fused_apply`
+///
+/// A workspace may be used with any ops and configurations, re-using its
+/// storage, but must not be used by more than one thread at a time.
+struct FusedApplyWorkspace {
+  /// \brief Combined site permutation of the most recently applied op
+  sym_info::Permutation permutation;
+
+  /// \brief Prim of the cached property matrices
+  Prim const *prim = nullptr;
+
+  /// \brief Property value transformation matrices, by property name, then
+  ///     by prim factor group index (empty if not yet constructed)
+  std::map<std::string, std::vector<Eigen::MatrixXd>> property_matrices;
+
+  /// \brief Input whose transformed local DoF values are cached
+  ConfigDoFValues const *cached_input = nullptr;
+
+  /// \brief Transformed local DoF values of `cached_input`, by DoF type
+  std::map<DoFKey, LocalDoFTransformCache> local_dof_caches;
+
+  /// \brief Return the matrix that transforms property values
+  Eigen::MatrixXd const &property_matrix(std::string const &key,
+                                         SupercellSymOp const &op);
+
+  /// \brief Cache transformed local DoF values of an input
+  void cache_local_dof_values(Configuration const &input);
+
+  /// \brief Erase cached transformed local DoF values
+  void clear_local_dof_values();
+};
+
+/// \brief Apply a symmetry operation to ConfigDoFValues, writing the result
+///     to an output in a single pass over sites
+void fused_apply(SupercellSymOp const &op, ConfigDoFValues const &input,
+                 ConfigDoFValues &output, FusedApplyWorkspace &workspace);
+
+/// \brief Apply a symmetry operation to a Configuration, writing the result
+///     to an output in a single pass over sites
+void fused_apply(SupercellSymOp const &op, Configuration const &input,
+                 Configuration &output, FusedApplyWorkspace &workspace);
+
+/// \brief Apply a symmetry operation to a configuration with properties,
+///     writing the result to an output in a single pass over sites
+void fused_apply(SupercellSymOp const &op,
+                 ConfigurationWithProperties const &input,
+                 ConfigurationWithProperties &output,
+                 FusedApplyWorkspace &workspace);
+
+/// \brief Apply many symmetry operations to one configuration
+template <typename SupercellSymOpIt, typename ConfigurationType>
+void fused_apply(SupercellSymOpIt begin, SupercellSymOpIt end,
+                 ConfigurationType const &input,
+                 std::vector<ConfigurationType> &output,
+                 FusedApplyWorkspace &workspace);
+
+// --- Implementation ---
+
+namespace fused_apply_impl {
+
+inline Configuration const &configuration(Configuration const &input) {
+  return input;
+}
+
+inline Configuration const &configuration(
+    ConfigurationWithProperties const &input) {
+  return input.configuration;
+}
+
+}  // namespace fused_apply_impl
+
+/// \brief Apply many symmetry operations to one configuration
+///
+/// Sets `output[i]` to the result of applying the i-th operation in
+/// [begin, end) to `input`. Existing elements of `output` are re-used.
+/// Local DoF values of `input` transformed by each prim factor group
+/// operation are computed once and re-used for all operations, so that
+/// each operation only requires permuting columns.
+///
+/// \param begin,end Range of SupercellSymOp
+/// \param input A Configuration or ConfigurationWithProperties
+/// \param output Output configurations, resized to `std::distance(begin,
+///     end)`
+/// \param workspace Re-usable buffers
+template <typename SupercellSymOpIt, typename ConfigurationType>
+void fused_apply(SupercellSymOpIt begin, SupercellSymOpIt end,
+                 ConfigurationType const &input,
+                 std::vector<ConfigurationType> &output,
+                 FusedApplyWorkspace &workspace) {
+  Index n = std::distance(begin, end);
+  if (output.size() > n) {
+    output.erase(output.begin() + n, output.end());
+  }
+  while (output.size() < n) {
+    output.push_back(input);
+  }
+  workspace.cache_local_dof_values(fused_apply_impl::configuration(input));
+  Index i = 0;
+  for (auto it = begin; it != end; ++it, ++i) {
+    fused_apply(*it, input, output[i], workspace);
+  }
+  workspace.clear_local_dof_values();
+}
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
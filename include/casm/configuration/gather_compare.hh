@@ -0,0 +1,61 @@
+#ifndef CASM_config_gather_compare
+#define CASM_config_gather_compare
+
+#include <cstdint>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+class CombinedPermutationTable;
+
+/// \brief Occupation values, optionally read through a permutation
+///
+/// Value `i` is:
+/// - `values[perm_16bit[i]]`, if perm_16bit is not null,
+/// - `values[perm_32bit[i]]`, if perm_32bit is not null,
+/// - `values[op->permute_index(i)]`, if op is not null,
+/// - `values[i]`, otherwise.
+struct PermutedOccupation {
+  int const *values = nullptr;
+  std::uint16_t const *perm_16bit = nullptr;
+  std::uint32_t const *perm_32bit = nullptr;
+  SupercellSymOp const *op = nullptr;
+
+  int operator[](Index i) const;
+};
+
+/// \brief Occupation values, not permuted
+PermutedOccupation make_permuted_occupation(int const *values);
+
+/// \brief Occupation values, permuted by the supercell operation (f, t)
+PermutedOccupation make_permuted_occupation(
+    int const *values, CombinedPermutationTable const &table,
+    Index supercell_factor_group_index, Index translation_index);
+
+/// \brief Occupation values, permuted by a supercell operation
+PermutedOccupation make_permuted_occupation(
+    int const *values, CombinedPermutationTable const &table,
+    SupercellSymOp const &op);
+
+/// \brief Occupation values, permuted by a supercell operation, using the
+///     combined permutation table if it is within the byte budget
+PermutedOccupation make_permuted_occupation(int const *values,
+                                            SupercellSymOp const &op);
+
+/// \brief Return the combined permutation table for the supercell of an
+///     operation, constructing it if necessary, or nullptr if it is not
+///     within the byte budget
+CombinedPermutationTable const *combined_permutation_table(
+    SupercellSymOp const &op);
+
+/// \brief Return the first index, in [0, n), where lhs and rhs differ, or n
+///     if they are equal
+Index find_first_difference(PermutedOccupation const &lhs,
+                            PermutedOccupation const &rhs, Index n);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef CASM_config_hermite_normal_form
+#define CASM_config_hermite_normal_form
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Return true if Hermite normal form A is less than B
+bool hermite_normal_form_less(Eigen::Matrix3l const &A,
+                              Eigen::Matrix3l const &B);
+
+/// \brief Return integer point operation matrices, in fractional
+///     coordinates of a lattice
+std::vector<Eigen::Matrix3l> make_fractional_point_matrices(
+    Lattice const &lattice, std::vector<SymOp> const &ops);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef CASM_config_ConfigurationSet_binary_io
+#define CASM_config_ConfigurationSet_binary_io
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+namespace binary_io_impl {
+class SupercellTableReader;
+}
+
+namespace config {
+struct Configuration;
+struct ConfigurationRecord;
+class ConfigurationSet;
+struct Prim;
+struct Supercell;
+class SupercellSet;
+
+/// \brief Read-only, memory-mapped view of a binary configuration file
+///
+/// Binary configuration files are written by `to_binary`. The file is
+/// memory-mapped when opened, and only the header and DoF table are
+/// validated, so that opening is fast regardless of file size. Supercells
+/// and ConfigurationRecord are constructed when accessed.
+///
+/// File format (all values in native byte order, each section aligned to 8
+/// bytes):
+/// - Header: magic "CASMCFGB", byte order mark, version, and counts
+/// - DoF table: name and dimension of each global DoF type, then of each
+///   local DoF type, in `std::map` order
+/// - Supercell table: transformation matrix of each supercell, as 9 int64,
+///   row-major
+/// - Record table: for each record, supercell index, offset of the first
+///   site in the site columns, and supercell_name and configuration_id as
+///   offsets into the string table
+/// - Next configuration id table: supercell_name and next id
+/// - Global DoF columns: for each global DoF type, `dim` doubles per record
+/// - Local DoF columns: for each local DoF type, `dim` doubles per site,
+///   by record (i.e. the column-major values of each record, concatenated)
+/// - Occupation column: one int32 per site, by record
+/// - String table
+///
+/// Notes:
+/// - Records are stored in ConfigurationSet order.
+/// - Supercell and record access are thread-safe.
+class MappedConfigurationSet {
+ public:
+  /// \brief Open and memory-map a binary configuration file
+  MappedConfigurationSet(std::string const &path,
+                         std::shared_ptr<Prim const> const &prim);
+
+  ~MappedConfigurationSet();
+
+  MappedConfigurationSet(MappedConfigurationSet const &) = delete;
+  MappedConfigurationSet &operator=(MappedConfigurationSet const &) = delete;
+
+  /// \brief The prim
+  std::shared_ptr<Prim const> const &prim() const;
+
+  /// \brief Number of supercells in the supercell table
+  Index n_supercells() const;
+
+  /// \brief Return a supercell from the supercell table
+  std::shared_ptr<Supercell const> supercell(Index supercell_index) const;
+
+  /// \brief Number of configuration records
+  Index size() const;
+
+  /// \brief Return the supercell table index of a record
+  Index supercell_index(Index record_index) const;
+
+  /// \brief Return the supercell_name of a record
+  std::string supercell_name(Index record_index) const;
+
+  /// \brief Return the configuration_id of a record
+  std::string configuration_id(Index record_index) const;
+
+  /// \brief Return the configuration of a record
+  Configuration configuration(Index record_index) const;
+
+  /// \brief Return a record
+  ConfigurationRecord record(Index record_index) const;
+
+  /// \brief IDs, by supercell_name, used to automatically ID new
+  ///     configurations
+  std::map<std::string, Index> next_config_id() const;
+
+  /// \brief Header and table layout (implementation detail)
+  struct Layout;
+
+ private:
+  void _read_layout(std::string const &path);
+
+  std::string _string(std::uint64_t offset, std::uint64_t size) const;
+
+  std::shared_ptr<Prim const> m_prim;
+
+  /// Mapped file
+  void *m_data;
+  std::size_t m_size;
+
+  std::unique_ptr<Layout> m_layout;
+
+  /// Supercells, constructed when first requested
+  std::unique_ptr<binary_io_impl::SupercellTableReader> m_supercells;
+};
+
+}  // namespace config
+
+/// \brief Write supercells and configurations to a binary configuration file
+void to_binary(config::SupercellSet const &supercells,
+               config::ConfigurationSet const &configurations,
+               std::string const &path);
+
+/// \brief Read all supercells and configurations from a binary configuration
+///     file
+void from_binary(config::SupercellSet &supercells,
+                 config::ConfigurationSet &configurations,
+                 std::string const &path,
+                 std::shared_ptr<config::Prim const> const &prim);
+
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef CASM_config_ConfigurationSet_compressed_io
+#define CASM_config_ConfigurationSet_compressed_io
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace binary_io_impl {
+class SupercellTableReader;
+}
+
+namespace config {
+struct ConfigurationRecord;
+class ConfigurationSet;
+struct Prim;
+struct Supercell;
+class SupercellSet;
+
+/// \brief Random access to a block-compressed configuration file
+///
+/// Block-compressed configuration files are written by
+/// `to_compressed_binary`. When opened, the header, metadata, and block index
+/// are read. Records are read by decompressing the block that contains them,
+/// and the most recently decompressed block is kept.
+///
+/// File format (all values in native byte order):
+/// - Header: magic "CASMCFGZ", byte order mark, version, block size, number
+///   of records, number of blocks, and offset of the block index
+/// - Metadata (zlib compressed): DoF names and dimensions, supercell
+///   transformation matrices, and next configuration ids
+/// - Blocks (each zlib compressed): up to `block_size` records, stored by
+///   column: supercell indices and names, then occupation, then global DoF
+///   values, then local DoF values
+/// - Block index: for each block, offset, compressed size, and uncompressed
+///   size
+///
+/// Occupation is pre-encoded before compression. If the previous record in
+/// the block is in the same supercell, the difference from its occupation is
+/// encoded, otherwise the occupation itself. The result is run-length
+/// encoded as (value, count) pairs of variable-length integers, so that
+/// dilute configurations, and sequences of similar configurations, compress
+/// to a few bytes each.
+///
+/// Notes:
+/// - Records are stored in ConfigurationSet order.
+/// - Supercell and record access are thread-safe.
+class CompressedConfigurationSet {
+ public:
+  /// \brief Open a block-compressed configuration file
+  CompressedConfigurationSet(std::string const &path,
+                             std::shared_ptr<Prim const> const &prim);
+
+  ~CompressedConfigurationSet();
+
+  CompressedConfigurationSet(CompressedConfigurationSet const &) = delete;
+  CompressedConfigurationSet &operator=(CompressedConfigurationSet const &) =
+      delete;
+
+  /// \brief The prim
+  std::shared_ptr<Prim const> const &prim() const;
+
+  /// \brief Number of supercells in the supercell table
+  Index n_supercells() const;
+
+  /// \brief Return a supercell from the supercell table
+  std::shared_ptr<Supercell const> supercell(Index supercell_index) const;
+
+  /// \brief Number of configuration records
+  Index size() const;
+
+  /// \brief Maximum number of records per block
+  Index block_size() const;
+
+  /// \brief Number of blocks
+  Index n_blocks() const;
+
+  /// \brief Return all records in a block
+  std::vector<ConfigurationRecord> block(Index block_index) const;
+
+  /// \brief Return a record
+  ConfigurationRecord record(Index record_index) const;
+
+  /// \brief IDs, by supercell_name, used to automatically ID new
+  ///     configurations
+  std::map<std::string, Index> const &next_config_id() const;
+
+  /// \brief Header, metadata, and block index (implementation detail)
+  struct Layout;
+
+ private:
+  std::shared_ptr<std::vector<ConfigurationRecord> const> _block(
+      Index block_index) const;
+
+  std::vector<ConfigurationRecord> _read_block(Index block_index) const;
+
+  std::string m_path;
+
+  std::shared_ptr<Prim const> m_prim;
+
+  std::unique_ptr<Layout> m_layout;
+
+  /// Supercells, constructed when first requested
+  std::unique_ptr<binary_io_impl::SupercellTableReader> m_supercells;
+
+  /// Most recently read block
+  mutable std::mutex m_block_mutex;
+  mutable Index m_block_index;
+  mutable std::shared_ptr<std::vector<ConfigurationRecord> const> m_block;
+};
+
+}  // namespace config
+
+/// \brief Write supercells and configurations to a block-compressed
+///     configuration file
+void to_compressed_binary(config::SupercellSet const &supercells,
+                          config::ConfigurationSet const &configurations,
+                          std::string const &path, Index block_size = 1024,
+                          int compression_level = -1);
+
+/// \brief Read all supercells and configurations from a block-compressed
+///     configuration file
+void from_compressed_binary(config::SupercellSet &supercells,
+                            config::ConfigurationSet &configurations,
+                            std::string const &path,
+                            std::shared_ptr<config::Prim const> const &prim);
+
+}  // namespace CASM
+
+#endif
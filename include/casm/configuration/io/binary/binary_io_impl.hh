@@ -0,0 +1,109 @@
+#ifndef CASM_config_binary_io_impl
+#define CASM_config_binary_io_impl
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/definitions.hh"
+
+namespace CASM {
+
+// these are implementation details shared by the binary and
+// block-compressed configuration file formats
+namespace binary_io_impl {
+
+/// \brief Names and dimensions of DoF types, in `std::map` order
+struct DoFTable {
+  std::vector<DoFKey> global_dof_name;
+  std::vector<Index> global_dof_dim;
+  std::vector<DoFKey> local_dof_name;
+  std::vector<Index> local_dof_dim;
+};
+
+/// \brief Make the DoF table of a prim
+DoFTable make_dof_table(config::Prim const &prim);
+
+/// \brief Throw if a DoF table read from a file is inconsistent with a prim
+void throw_if_inconsistent(DoFTable const &dof_table, config::Prim const &prim,
+                           std::string const &reader_name,
+                           std::string const &path);
+
+/// \brief Assigns supercell table indices when writing a file
+///
+/// Supercells are indexed by transformation matrix, in order of first use.
+class SupercellTableWriter {
+ public:
+  /// \brief Return the index of a supercell, adding it if new
+  std::uint64_t add(config::Supercell const &supercell);
+
+  /// \brief Number of supercells added
+  Index size() const;
+
+  /// \brief Transformation matrices, by supercell index
+  std::vector<Eigen::Matrix3l> const &transformation_matrices() const;
+
+ private:
+  std::unordered_map<Eigen::Matrix3l, std::uint64_t,
+                     config::TransformationMatrixHash>
+      m_index;
+  std::vector<Eigen::Matrix3l> m_transformation_matrices;
+};
+
+/// \brief Supercells of a file's supercell table, constructed with
+///     `make_shared_supercell` the first time they are requested
+///
+/// Thread-safe.
+class SupercellTableReader {
+ public:
+  /// \brief Constructor
+  SupercellTableReader(
+      std::shared_ptr<config::Prim const> const &_prim, Index _n_supercells,
+      std::function<Eigen::Matrix3l(Index)> _transformation_matrix);
+
+  /// \brief Number of supercells in the supercell table
+  Index size() const;
+
+  /// \brief Return a supercell, or throw if `supercell_index` is invalid
+  std::shared_ptr<config::Supercell const> supercell(
+      Index supercell_index, std::string const &reader_name) const;
+
+ private:
+  std::shared_ptr<config::Prim const> m_prim;
+  std::function<Eigen::Matrix3l(Index)> m_transformation_matrix;
+
+  mutable std::mutex m_mutex;
+  mutable std::vector<std::shared_ptr<config::Supercell const>> m_supercells;
+};
+
+/// \brief Insert all supercells and records of an opened configuration
+///     file into a SupercellSet and ConfigurationSet
+///
+/// \param supercells All supercells in the supercell table are inserted
+/// \param configurations Cleared, then all records are inserted, and
+///     `next_config_id` is set
+/// \param file A MappedConfigurationSet or CompressedConfigurationSet
+template <typename ConfigurationFile>
+void read_all(config::SupercellSet &supercells,
+              config::ConfigurationSet &configurations,
+              ConfigurationFile const &file) {
+  configurations.clear();
+  for (Index i = 0; i < file.n_supercells(); ++i) {
+    supercells.insert(file.supercell(i));
+  }
+  for (Index i = 0; i < file.size(); ++i) {
+    configurations.insert(file.record(i));
+  }
+  configurations.set_next_config_id(file.next_config_id());
+}
+
+}  // namespace binary_io_impl
+}  // namespace CASM
+
+#endif
@@ -1,16 +1,23 @@
 #ifndef CASM_config_Configuration_json_io
 #define CASM_config_Configuration_json_io
 
+#include <functional>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+
+#include "casm/global/definitions.hh"
 
 namespace CASM {
 namespace config {
 struct Configuration;
+struct ConfigurationRecord;
 class ConfigurationSet;
 struct Prim;
 class SupercellSet;
+class ThreadPool;
 }  // namespace config
 
 class jsonParser;
@@ -24,6 +31,73 @@ void from_json(config::SupercellSet &supercells,
 jsonParser &to_json(config::ConfigurationSet const &configurations,
                     jsonParser &json);
 
+/// \brief Read configuration records one at a time from a configurations
+///     JSON stream
+std::map<std::string, Index> stream_from_json(
+    config::SupercellSet &supercells, std::istream &in,
+    std::function<void(config::ConfigurationRecord const &)> f);
+
+/// \brief Read configuration records from a configurations JSON stream,
+///     processing batches of records in parallel
+std::map<std::string, Index> stream_from_json(
+    config::SupercellSet &supercells, std::istream &in,
+    std::function<void(config::ConfigurationRecord const &)> f,
+    config::ThreadPool &pool, Index batch_size = 1024);
+
+/// \brief Write configuration records one at a time to a configurations
+///     JSON stream
+///
+/// Usage:
+/// \code
+/// ConfigurationJsonStreamWriter writer(out);
+/// for (auto const &record : records) {
+///   writer.write(record);
+/// }
+/// writer.finish(next_config_id);
+/// \endcode
+///
+/// Notes:
+/// - The output has the same format as `to_json(ConfigurationSet const &,
+///   jsonParser &)`, without indentation and with one configuration per line
+/// - Records must be grouped by supercell_name, as when iterating over a
+///   ConfigurationSet
+/// - `finish` must be called to complete the document
+class ConfigurationJsonStreamWriter {
+ public:
+  /// \brief Constructor, writes the beginning of the document
+  explicit ConfigurationJsonStreamWriter(std::ostream &out);
+
+  ConfigurationJsonStreamWriter(ConfigurationJsonStreamWriter const &) =
+      delete;
+  ConfigurationJsonStreamWriter &operator=(
+      ConfigurationJsonStreamWriter const &) = delete;
+
+  /// \brief Write a configuration record
+  void write(config::ConfigurationRecord const &record);
+
+  /// \brief Write next configuration ids and complete the document
+  void finish(std::map<std::string, Index> const &next_config_id);
+
+ private:
+  std::ostream &m_out;
+
+  /// Supercell names already written, including the current supercell
+  std::set<std::string> m_supercell_names;
+
+  /// Name of the supercell currently being written
+  std::string m_supercell_name;
+
+  /// True if a supercell object is open
+  bool m_supercell_open;
+
+  bool m_finished;
+};
+
+/// \brief Write a ConfigurationSet to a configurations JSON stream, one
+///     record at a time
+void stream_to_json(config::ConfigurationSet const &configurations,
+                    std::ostream &out);
+
 template <typename T>
 struct jsonConstructor;
 template <typename T>
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "casm/global/eigen.hh"
+
 namespace CASM {
 namespace xtal {
 class Lattice;
@@ -11,6 +13,9 @@ struct SymOp;
 }  // namespace xtal
 namespace config {
 
+/// \brief Return a string representing the HNF of a matrix
+std::string hermite_normal_form_name(const Eigen::Matrix3l &matrix);
+
 /// \brief Make the supercell name of a superlattice
 std::string make_supercell_name(xtal::Lattice const &prim_lattice,
                                 xtal::Lattice const &superlattice);
@@ -0,0 +1,95 @@
+#ifndef CASM_config_translation_search
+#define CASM_config_translation_search
+
+#include "casm/configuration/definitions.hh"
+#include "casm/crystallography/UnitCellCoord.hh"
+
+namespace CASM {
+namespace config {
+
+struct Supercell;
+
+/// \brief Lattice translation arithmetic on linear unit cell indices
+///
+/// The translations of a supercell form a finite abelian group, isomorphic to
+/// the group of unit cells within the supercell, with addition of unit cells
+/// modulo the superlattice. UnitCellIndexConverter (which uses the Smith
+/// normal form of the transformation matrix) brings sums and differences back
+/// within the supercell.
+///
+/// Notes:
+/// - Holds a reference to the UnitCellIndexConverter, which must outlive
+///   this object
+class TranslationArithmetic {
+ public:
+  TranslationArithmetic(
+      xtal::UnitCellIndexConverter const &_unitcell_index_converter,
+      Index max_table_size = 0);
+
+  /// \brief Number of unit cells (and translations) in the supercell
+  Index size() const { return m_unitcell.size(); }
+
+  /// \brief Index of unit cell `n` translated by translation `t`
+  Index add(Index n, Index t) const {
+    if (m_add_table.size()) {
+      return m_add_table[t * size() + n];
+    }
+    return _add(n, t);
+  }
+
+  /// \brief Index of unit cell `n` translated by the inverse of translation
+  ///     `t`
+  Index subtract(Index n, Index t) const {
+    if (m_subtract_table.size()) {
+      return m_subtract_table[t * size() + n];
+    }
+    return _subtract(n, t);
+  }
+
+  /// \brief Returns the index of the site whose value is permuted onto site
+  ///     `l` by translation `t`
+  Index permute_index(Index l, Index t) const {
+    Index n_vol = size();
+    return (l / n_vol) * n_vol + subtract(l % n_vol, t);
+  }
+
+ private:
+  Index _add(Index n, Index t) const;
+
+  Index _subtract(Index n, Index t) const;
+
+  xtal::UnitCellIndexConverter const &m_unitcell_index_converter;
+  std::vector<xtal::UnitCell> m_unitcell;
+
+  // optional tabulated results, with index `t * size() + n`
+  std::vector<int> m_add_table;
+  std::vector<int> m_subtract_table;
+};
+
+/// \brief Return occupation values after applying only the factor group
+///     part of a supercell operation
+Eigen::VectorXi make_factor_group_occupation(
+    Eigen::VectorXi const &occupation, Supercell const &supercell,
+    Index supercell_factor_group_index);
+
+/// \brief Return the translations that make occupation values
+///     lexicographically greatest
+std::vector<Index> find_max_translations(Eigen::VectorXi const &values,
+                                         Supercell const &supercell);
+
+/// \brief Return the translations, out of a set of candidates, that make
+///     occupation values lexicographically greatest
+std::vector<Index> find_max_translations(
+    Eigen::VectorXi const &values, Supercell const &supercell,
+    std::vector<Index> candidate_translation_indices);
+
+/// \brief Return the translations, out of a set of candidates, that make
+///     occupation values lexicographically greatest
+std::vector<Index> find_max_translations(
+    Eigen::VectorXi const &values, TranslationArithmetic const &arithmetic,
+    std::vector<Index> candidate_translation_indices);
+
+}  // namespace config
+}  // namespace CASM
+
+#endif
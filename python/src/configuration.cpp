@@ -437,7 +437,7 @@ PYBIND11_MODULE(_configuration, m) {
       .def(
           "factor_group",
           [](std::shared_ptr<config::Supercell const> const &supercell) {
-            return supercell->sym_info.factor_group;
+            return supercell->sym_info.factor_group.get();
           },
           "Returns the supercell factor group, which is the subgroup of the "
           "prim factor group that leaves the supercell lattice vectors "
@@ -445,7 +445,7 @@ PYBIND11_MODULE(_configuration, m) {
       .def(
           "factor_group_permutations",
           [](std::shared_ptr<config::Supercell const> const &supercell) {
-            return supercell->sym_info.factor_group_permutations;
+            return supercell->sym_info.factor_group_permutations.get();
           },
           "Returns the factor group permutations, where "
           "`factor_group_permutations()[i]` describes how "
@@ -458,7 +458,7 @@ PYBIND11_MODULE(_configuration, m) {
       .def(
           "translation_permutations",
           [](std::shared_ptr<config::Supercell const> const &supercell) {
-            return supercell->sym_info.translation_permutations;
+            return supercell->sym_info.translation_permutations.get();
           },
           "Returns the translation permutations, where "
           "`translations_permutations()[i]` describes how the translation "
@@ -1245,9 +1245,22 @@ PYBIND11_MODULE(_configuration, m) {
           py::arg("version") = std::string("2.0"));
 
   pyConfigurationSet
-      .def(py::init<>(),
+      .def(py::init([](bool index_by_fingerprint) {
+             return std::make_shared<config::ConfigurationSet>(
+                 std::map<std::string, Index>{}, index_by_fingerprint);
+           }),
+           py::arg("index_by_fingerprint") = false,
            R"pbdoc(
           Construct an empty ConfigurationSet
+
+          Parameters
+          ----------
+          index_by_fingerprint : bool = False
+              If True, also index configurations by a hash of their
+              supercell and occupation, so that checking if a
+              :class:`~libcasm.configuration.Configuration` is in the set
+              only makes full comparisons with configurations that have the
+              same supercell and occupation.
           )pbdoc")
       .def("empty", &config::ConfigurationSet::empty,
            "Returns True if the ConfigurationSet is empty")
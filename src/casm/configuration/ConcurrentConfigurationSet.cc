@@ -0,0 +1,214 @@
+#include "casm/configuration/ConcurrentConfigurationSet.hh"
+
+#include <algorithm>
+#include <functional>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/supercell_name.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {  // (anonymous)
+
+/// \brief Return the supercell name of a configuration, from the Hermite
+///     normal form of the supercell transformation matrix
+///
+/// Throws if the configuration is not in its canonical supercell.
+std::string make_configuration_supercell_name(
+    Configuration const &configuration) {
+  Supercell const &supercell = *configuration.supercell;
+  if (!is_canonical(supercell)) {
+    throw std::runtime_error(
+        "Error in ConcurrentConfigurationSet::insert: configuration is not in "
+        "its canonical supercell");
+  }
+  return hermite_normal_form_name(
+      supercell.superlattice.transformation_matrix_to_super());
+}
+
+/// \brief Configuration to be inserted by `insert_range`
+struct PendingInsert {
+  Index shard_index;
+  std::string const *supercell_name;
+  Configuration const *configuration;
+};
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param _n_shards Number of shards. Supercell names are distributed over
+///     shards by hash, so more shards than producer threads reduces lock
+///     contention. Must be >= 1.
+ConcurrentConfigurationSet::ConcurrentConfigurationSet(Index _n_shards) {
+  if (_n_shards < 1) {
+    throw std::runtime_error(
+        "Error in ConcurrentConfigurationSet: n_shards must be >= 1");
+  }
+  m_shards = std::vector<Shard>(_n_shards);
+}
+
+/// \brief Number of shards
+Index ConcurrentConfigurationSet::n_shards() const { return m_shards.size(); }
+
+/// \brief Total number of configurations
+Index ConcurrentConfigurationSet::size() const {
+  Index result = 0;
+  for (auto const &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto const &value : shard.data) {
+      result += value.second.size();
+    }
+  }
+  return result;
+}
+
+bool ConcurrentConfigurationSet::empty() const { return size() == 0; }
+
+void ConcurrentConfigurationSet::clear() {
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.data.clear();
+  }
+}
+
+/// \brief Insert a Configuration, determining the supercell name
+///
+/// \returns True if inserted, false if an equal configuration was already
+///     present
+///
+/// \throws If the configuration is not in its canonical supercell
+bool ConcurrentConfigurationSet::insert(Configuration const &configuration) {
+  return insert(make_configuration_supercell_name(configuration),
+                configuration);
+}
+
+/// \brief Insert a Configuration with known supercell name
+///
+/// \returns True if inserted, false if an equal configuration was already
+///     present
+bool ConcurrentConfigurationSet::insert(std::string const &supercell_name,
+                                        Configuration const &configuration) {
+  Shard &shard = m_shards[_shard_index(supercell_name)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.data[supercell_name].insert(configuration).second;
+}
+
+/// \brief Insert many configurations, taking each shard lock once
+///
+/// Supercell names are determined once per distinct supercell, and
+/// configurations are sorted by shard and de-duplicated before any lock is
+/// taken, so that each shard is locked at most once and only for the
+/// insertions.
+///
+/// \returns Number of configurations inserted
+///
+/// \throws If any configuration is not in its canonical supercell, in which
+///     case no configurations are inserted
+Index ConcurrentConfigurationSet::insert_range(
+    std::vector<Configuration> const &configurations) {
+  std::map<Supercell const *, std::string> supercell_names;
+  std::vector<PendingInsert> pending;
+  pending.reserve(configurations.size());
+  for (auto const &configuration : configurations) {
+    auto it = supercell_names.find(configuration.supercell.get());
+    if (it == supercell_names.end()) {
+      it = supercell_names
+               .emplace(configuration.supercell.get(),
+                        make_configuration_supercell_name(configuration))
+               .first;
+    }
+    pending.push_back({_shard_index(it->second), &it->second, &configuration});
+  }
+
+  auto less = [](PendingInsert const &lhs, PendingInsert const &rhs) {
+    if (lhs.shard_index != rhs.shard_index) {
+      return lhs.shard_index < rhs.shard_index;
+    }
+    if (*lhs.supercell_name != *rhs.supercell_name) {
+      return *lhs.supercell_name < *rhs.supercell_name;
+    }
+    return *lhs.configuration < *rhs.configuration;
+  };
+  std::sort(pending.begin(), pending.end(), less);
+  auto equal = [&](PendingInsert const &lhs, PendingInsert const &rhs) {
+    return !less(lhs, rhs) && !less(rhs, lhs);
+  };
+  pending.erase(std::unique(pending.begin(), pending.end(), equal),
+                pending.end());
+
+  Index n_inserted = 0;
+  auto begin = pending.begin();
+  while (begin != pending.end()) {
+    Index shard_index = begin->shard_index;
+    auto end = begin;
+    while (end != pending.end() && end->shard_index == shard_index) {
+      ++end;
+    }
+
+    Shard &shard = m_shards[shard_index];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::set<Configuration> *set = nullptr;
+    std::string const *set_name = nullptr;
+    for (auto it = begin; it != end; ++it) {
+      if (set_name == nullptr || *set_name != *it->supercell_name) {
+        set = &shard.data[*it->supercell_name];
+        set_name = it->supercell_name;
+      }
+      auto size_before = set->size();
+      set->emplace_hint(set->end(), *it->configuration);
+      n_inserted += set->size() - size_before;
+    }
+    begin = end;
+  }
+  return n_inserted;
+}
+
+/// \brief Insert all configurations into a ConfigurationSet, assigning
+///     configuration ids in a deterministic order
+///
+/// Configurations are inserted with `ConfigurationSet::insert(supercell_name,
+/// configuration)` in order of supercell name and then Configuration, so
+/// new configurations are given sequential ids starting from the
+/// ConfigurationSet's next configuration id for their supercell. The
+/// resulting ids do not depend on the number of shards, the number of
+/// producer threads, or the order in which configurations were inserted.
+///
+/// All shard locks are held during the merge.
+///
+/// \returns Number of configurations inserted into `configurations`
+Index ConcurrentConfigurationSet::merge_into(
+    ConfigurationSet &configurations) const {
+  std::vector<std::unique_lock<std::mutex>> locks;
+  for (auto const &shard : m_shards) {
+    locks.emplace_back(shard.mutex);
+  }
+
+  std::map<std::string, std::set<Configuration> const *> by_name;
+  for (auto const &shard : m_shards) {
+    for (auto const &value : shard.data) {
+      by_name.emplace(value.first, &value.second);
+    }
+  }
+
+  Index n_inserted = 0;
+  for (auto const &value : by_name) {
+    for (auto const &configuration : *value.second) {
+      if (configurations.insert(value.first, configuration).second) {
+        ++n_inserted;
+      }
+    }
+  }
+  return n_inserted;
+}
+
+Index ConcurrentConfigurationSet::_shard_index(
+    std::string const &supercell_name) const {
+  return std::hash<std::string>()(supercell_name) % m_shards.size();
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,340 @@
+#include "casm/configuration/ConfigFingerprint.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Make occupant classes, the orbits of (sublattice index, occupant
+///     index) under the prim factor group
+///
+/// \returns occupant_class, as `occupant_class[b][s]`, with class indices
+///     assigned in order of first appearance
+std::vector<std::vector<Index>> _make_occupant_class(Prim const &prim) {
+  auto const &basis = prim.basicstructure->basis();
+  auto const &sym_info = prim.sym_info;
+
+  std::vector<std::vector<Index>> occupant_class;
+  for (auto const &site : basis) {
+    occupant_class.emplace_back(
+        std::max(Index(site.occupant_dof().size()), Index(1)), -1);
+  }
+
+  Index n_class = 0;
+  for (Index b = 0; b < occupant_class.size(); ++b) {
+    for (Index s = 0; s < occupant_class[b].size(); ++s) {
+      if (occupant_class[b][s] != -1) {
+        continue;
+      }
+      for (Index g = 0; g < sym_info.unitcellcoord_symgroup_rep.size(); ++g) {
+        Index b_after =
+            sym_info.unitcellcoord_symgroup_rep[g].sublattice_index[b];
+        Index s_after = s;
+        if (sym_info.has_occupation_dofs &&
+            s < sym_info.occ_symgroup_rep[g][b].size()) {
+          s_after = sym_info.occ_symgroup_rep[g][b][s];
+        }
+        occupant_class[b_after][s_after] = n_class;
+      }
+      ++n_class;
+    }
+  }
+  return occupant_class;
+}
+
+/// \brief Neighbors of a prim site: (unitcell offset, neighbor sublattice,
+///     distance)
+struct PrimNeighbor {
+  xtal::UnitCell offset;
+  Index sublattice_index;
+  double distance;
+};
+
+/// \brief Make all neighbors, with distance in (0, max_distance + tol], of
+///     each prim sublattice
+std::vector<std::vector<PrimNeighbor>> _make_prim_neighbors(
+    xtal::BasicStructure const &prim, double max_distance) {
+  double tol = prim.lattice().tol();
+  Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+  Eigen::Matrix3d const &L_inv = prim.lattice().inv_lat_column_mat();
+  auto const &basis = prim.basis();
+
+  std::vector<std::vector<PrimNeighbor>> neighbors(basis.size());
+  for (Index b = 0; b < basis.size(); ++b) {
+    for (Index b_2 = 0; b_2 < basis.size(); ++b_2) {
+      Eigen::Vector3d dr = basis[b_2].const_cart() - basis[b].const_cart();
+      Eigen::Vector3d df = L_inv * dr;
+
+      // range of unitcell offsets that can be within max_distance
+      Eigen::Vector3l begin, end;
+      for (Index i = 0; i < 3; ++i) {
+        double r = (max_distance + tol) * L_inv.row(i).norm();
+        begin(i) = std::floor(-r - df(i));
+        end(i) = std::ceil(r - df(i)) + 1;
+      }
+
+      for (Index i = begin(0); i < end(0); ++i) {
+        for (Index j = begin(1); j < end(1); ++j) {
+          for (Index k = begin(2); k < end(2); ++k) {
+            xtal::UnitCell offset(i, j, k);
+            double d = (L * offset.cast<double>() + dr).norm();
+            if (d > tol && d <= max_distance + tol) {
+              neighbors[b].push_back({offset, b_2, d});
+            }
+          }
+        }
+      }
+    }
+  }
+  return neighbors;
+}
+
+/// \brief Default max_pair_distance: the minimum distance between distinct
+///     sites, among sites in neighboring unit cells
+double _default_max_pair_distance(xtal::BasicStructure const &prim) {
+  double tol = prim.lattice().tol();
+  Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+  auto const &basis = prim.basis();
+  double min_distance = -1.0;
+  for (Index b = 0; b < basis.size(); ++b) {
+    for (Index b_2 = 0; b_2 < basis.size(); ++b_2) {
+      Eigen::Vector3d dr = basis[b_2].const_cart() - basis[b].const_cart();
+      for (Index i = -1; i <= 1; ++i) {
+        for (Index j = -1; j <= 1; ++j) {
+          for (Index k = -1; k <= 1; ++k) {
+            double d = (L * Eigen::Vector3d(i, j, k) + dr).norm();
+            if (d > tol && (min_distance < 0.0 || d < min_distance)) {
+              min_distance = d;
+            }
+          }
+        }
+      }
+    }
+  }
+  return min_distance;
+}
+
+}  // namespace
+
+bool ConfigFingerprint::operator==(ConfigFingerprint const &rhs) const {
+  return occupant_class_counts == rhs.occupant_class_counts &&
+         pair_counts == rhs.pair_counts;
+}
+
+bool ConfigFingerprint::operator!=(ConfigFingerprint const &rhs) const {
+  return !(*this == rhs);
+}
+
+std::size_t ConfigFingerprintHash::operator()(
+    ConfigFingerprint const &fingerprint) const {
+  std::size_t seed = 0;
+  auto combine = [&](Index value) {
+    seed ^= std::hash<Index>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) +
+            (seed >> 2);
+  };
+  for (Index value : fingerprint.occupant_class_counts) {
+    combine(value);
+  }
+  for (Index value : fingerprint.pair_counts) {
+    combine(value);
+  }
+  return seed;
+}
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell of configurations to calculate
+///     fingerprints for
+/// \param max_pair_distance Pairs of sites with distance less than or equal
+///     to this are counted. If < 0, the minimum distance between distinct
+///     sites is used (i.e. nearest neighbor pairs). If 0, no pairs are
+///     counted.
+ConfigFingerprintCalculator::ConfigFingerprintCalculator(
+    std::shared_ptr<Supercell const> const &_supercell,
+    double max_pair_distance)
+    : supercell(_supercell) {
+  xtal::BasicStructure const &prim = *supercell->prim->basicstructure;
+  double tol = prim.lattice().tol();
+
+  m_occupant_class = _make_occupant_class(*supercell->prim);
+  m_n_occupant_classes = 0;
+  for (auto const &sublattice_class : m_occupant_class) {
+    for (Index c : sublattice_class) {
+      m_n_occupant_classes = std::max(m_n_occupant_classes, c + 1);
+    }
+  }
+
+  if (max_pair_distance < 0.0) {
+    max_pair_distance = _default_max_pair_distance(prim);
+  }
+  if (max_pair_distance <= 0.0) {
+    return;
+  }
+
+  std::vector<std::vector<PrimNeighbor>> prim_neighbors =
+      _make_prim_neighbors(prim, max_pair_distance);
+
+  // distinct distances -> shells
+  std::vector<double> distances;
+  for (auto const &sublattice_neighbors : prim_neighbors) {
+    for (auto const &neighbor : sublattice_neighbors) {
+      distances.push_back(neighbor.distance);
+    }
+  }
+  std::sort(distances.begin(), distances.end());
+  for (double d : distances) {
+    if (m_shell_distances.empty() || d - m_shell_distances.back() > tol) {
+      m_shell_distances.push_back(d);
+    }
+  }
+  auto shell_index = [&](double d) {
+    Index i = 0;
+    while (i + 1 < m_shell_distances.size() &&
+           d - m_shell_distances[i] > tol) {
+      ++i;
+    }
+    return i;
+  };
+
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  Index n_sites = converter.total_sites();
+  m_neighbors.resize(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    xtal::UnitCellCoord bijk = converter(l);
+    for (auto const &neighbor : prim_neighbors[bijk.sublattice()]) {
+      xtal::UnitCellCoord bijk_2(neighbor.sublattice_index,
+                                 bijk.unitcell() + neighbor.offset);
+      m_neighbors[l].emplace_back(converter(bijk_2),
+                                  shell_index(neighbor.distance));
+    }
+  }
+}
+
+/// \brief Calculate the fingerprint of a configuration
+///
+/// \param configuration A configuration, which must be in `supercell`
+///
+/// Pairs are counted over all sites and all neighbor vectors, so in small
+/// supercells a pair of sites may be counted more than once, via periodic
+/// images. The counts are still invariant.
+ConfigFingerprint ConfigFingerprintCalculator::operator()(
+    Configuration const &configuration) const {
+  if (configuration.supercell != supercell &&
+      !(*configuration.supercell == *supercell)) {
+    throw std::runtime_error(
+        "Error in ConfigFingerprintCalculator: configuration supercell does "
+        "not match");
+  }
+  auto const &converter = supercell->unitcellcoord_index_converter;
+  Index n_sites = converter.total_sites();
+  Index n_class = m_n_occupant_classes;
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+
+  std::vector<Index> site_class(n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    Index b = converter(l).sublattice();
+    Index s = occupation.size() ? occupation(l) : 0;
+    site_class[l] = m_occupant_class[b][s];
+  }
+
+  ConfigFingerprint fingerprint;
+  fingerprint.occupant_class_counts.resize(n_class, 0);
+  fingerprint.pair_counts.resize(m_shell_distances.size() * n_class * n_class,
+                                 0);
+  for (Index l = 0; l < n_sites; ++l) {
+    Index c = site_class[l];
+    ++fingerprint.occupant_class_counts[c];
+    for (auto const &neighbor : m_neighbors[l]) {
+      Index c_2 = site_class[neighbor.first];
+      Index shell = neighbor.second;
+      ++fingerprint.pair_counts[(shell * n_class + c) * n_class + c_2];
+    }
+  }
+  return fingerprint;
+}
+
+/// \brief Number of occupant classes
+Index ConfigFingerprintCalculator::n_occupant_classes() const {
+  return m_n_occupant_classes;
+}
+
+/// \brief Distances of the pair shells that are counted
+std::vector<double> const &ConfigFingerprintCalculator::shell_distances()
+    const {
+  return m_shell_distances;
+}
+
+/// \brief Constructor
+///
+/// \param _supercell The supercell of configurations to collect
+/// \param max_pair_distance Passed to ConfigFingerprintCalculator
+ConfigFingerprintSet::ConfigFingerprintSet(
+    std::shared_ptr<Supercell const> const &_supercell,
+    double max_pair_distance)
+    : m_calculator(_supercell, max_pair_distance), m_n_canonical_forms(0) {}
+
+/// \brief Insert a configuration, if not equivalent to any previously
+///     inserted configuration
+///
+/// \param configuration A configuration, which must be in the supercell of
+///     this set
+///
+/// \returns True if inserted (not equivalent to any previously inserted
+///     configuration), false otherwise
+bool ConfigFingerprintSet::insert(Configuration const &configuration) {
+  std::vector<Index> &bucket = m_buckets[m_calculator(configuration)];
+  if (!bucket.empty()) {
+    Configuration canonical_configuration = make_canonical_form(configuration);
+    ++m_n_canonical_forms;
+    for (Index i : bucket) {
+      if (_canonical(i) == canonical_configuration) {
+        return false;
+      }
+    }
+    m_canonical.emplace_back(
+        std::make_unique<Configuration>(canonical_configuration));
+  } else {
+    m_canonical.emplace_back();
+  }
+  bucket.push_back(m_values.size());
+  m_values.push_back(configuration);
+  return true;
+}
+
+/// \brief Number of distinct configurations
+Index ConfigFingerprintSet::size() const { return m_values.size(); }
+
+/// \brief Distinct configurations, as inserted (not made canonical)
+std::vector<Configuration> const &ConfigFingerprintSet::values() const {
+  return m_values;
+}
+
+/// \brief Number of canonical forms generated
+///
+/// This is the number of inserted configurations whose fingerprint was
+/// already present, plus the number of previously inserted configurations
+/// whose canonical form was needed for comparison.
+Index ConfigFingerprintSet::n_canonical_forms() const {
+  return m_n_canonical_forms;
+}
+
+Configuration const &ConfigFingerprintSet::_canonical(Index i) {
+  if (!m_canonical[i]) {
+    m_canonical[i] =
+        std::make_unique<Configuration>(make_canonical_form(m_values[i]));
+    ++m_n_canonical_forms;
+  }
+  return *m_canonical[i];
+}
+
+}  // namespace config
+}  // namespace CASM
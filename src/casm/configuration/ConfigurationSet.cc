@@ -1,5 +1,10 @@
 #include "casm/configuration/ConfigurationSet.hh"
 
+#include <algorithm>
+#include <functional>
+
+#include "casm/configuration/ConfigIsEquivalent.hh"
+#include "casm/configuration/SupercellSet.hh"
 #include "casm/configuration/supercell_name.hh"
 
 namespace CASM {
@@ -13,8 +18,55 @@ ConfigurationRecord::ConfigurationRecord(Configuration const &_configuration,
       configuration_id(_configuration_id),
       configuration_name(supercell_name + "/" + configuration_id) {}
 
-ConfigurationSet::ConfigurationSet(std::map<std::string, Index> _next_config_id)
-    : m_next_config_id(_next_config_id) {}
+std::size_t ConfigurationOccupationHash::operator()(
+    Configuration const &configuration) const {
+  std::size_t seed = TransformationMatrixHash()(
+      configuration.supercell->superlattice.transformation_matrix_to_super());
+  Eigen::VectorXi const &occupation = configuration.dof_values.occupation;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    seed ^= std::hash<int>()(occupation[l]) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+  }
+  return seed;
+}
+
+/// \brief Constructor
+///
+/// \param _next_config_id Map of supercell_name -> next id to assign to a
+///     new Configuration
+/// \param _index_by_fingerprint If true, index records by
+///     ConfigurationOccupationHash so that finding records by Configuration
+///     only makes full comparisons with records with the same supercell and
+///     occupation. Otherwise, records are found by `std::set::find`.
+ConfigurationSet::ConfigurationSet(std::map<std::string, Index> _next_config_id,
+                                   bool _index_by_fingerprint)
+    : m_next_config_id(_next_config_id),
+      m_use_fingerprint_index(_index_by_fingerprint),
+      m_index_is_valid(true) {}
+
+/// \brief Copy constructor
+///
+/// Indexes hold iterators into the set, so they are rebuilt rather than
+/// copied.
+ConfigurationSet::ConfigurationSet(ConfigurationSet const &other)
+    : m_data(other.m_data),
+      m_next_config_id(other.m_next_config_id),
+      m_use_fingerprint_index(other.m_use_fingerprint_index),
+      m_index_is_valid(false) {
+  _update_index();
+}
+
+/// \brief Copy assignment
+ConfigurationSet &ConfigurationSet::operator=(ConfigurationSet const &other) {
+  if (this != &other) {
+    m_data = other.m_data;
+    m_next_config_id = other.m_next_config_id;
+    m_use_fingerprint_index = other.m_use_fingerprint_index;
+    m_index_is_valid = false;
+    _update_index();
+  }
+  return *this;
+}
 
 bool ConfigurationSet::empty() const { return m_data.empty(); }
 
@@ -22,7 +74,12 @@ ConfigurationSet::size_type ConfigurationSet::size() const {
   return m_data.size();
 }
 
-void ConfigurationSet::clear() { return m_data.clear(); }
+void ConfigurationSet::clear() {
+  m_data.clear();
+  m_index_by_name.clear();
+  m_index_by_fingerprint.clear();
+  m_index_is_valid = true;
+}
 
 ConfigurationSet::const_iterator ConfigurationSet::begin() const {
   return m_data.begin();
@@ -52,9 +109,17 @@ std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
   }
   Index &configuration_id = it->second;
 
+  _update_index();
+  if (m_use_fingerprint_index) {
+    auto existing = find(configuration);
+    if (existing != end()) {
+      return std::make_pair(existing, false);
+    }
+  }
   auto res = m_data.insert(ConfigurationRecord(
       configuration, supercell_name, std::to_string(configuration_id)));
   if (res.second) {
+    _index(res.first);
     ++configuration_id;
   }
   return res;
@@ -63,25 +128,60 @@ std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
 /// \brief Insert ConfigurationRecord, allowing custom configuration_id
 std::pair<ConfigurationSet::iterator, bool> ConfigurationSet::insert(
     ConfigurationRecord const &record) {
-  return m_data.insert(record);
+  _update_index();
+  auto res = m_data.insert(record);
+  if (res.second) {
+    _index(res.first);
+  }
+  return res;
 }
 
+/// \brief Find a configuration
+///
+/// Uses the fingerprint index, if enabled and not invalidated by `data()`,
+/// else `std::set::find`.
 ConfigurationSet::const_iterator ConfigurationSet::find(
     Configuration const &configuration) const {
-  ConfigurationRecord record(configuration, "", "");
-  return m_data.find(record);
+  if (!m_use_fingerprint_index || !m_index_is_valid) {
+    ConfigurationRecord record(configuration, "", "");
+    return m_data.find(record);
+  }
+  auto range = m_index_by_fingerprint.equal_range(
+      ConfigurationOccupationHash()(configuration));
+  if (range.first == range.second) {
+    return end();
+  }
+  ConfigIsEquivalent equal_to(configuration);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (equal_to(it->second->configuration)) {
+      return it->second;
+    }
+  }
+  return end();
 }
 
+/// \brief Find a configuration by name
+///
+/// O(1) using the index, or a linear search if the index has been
+/// invalidated by `data()`. If more than one record has the same
+/// configuration_name, the first, in set order, is returned.
 ConfigurationSet::const_iterator ConfigurationSet::find_by_name(
     std::string configuration_name) const {
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->configuration_name == configuration_name) {
-      return it;
+  if (!m_index_is_valid) {
+    return std::find_if(begin(), end(),
+                        [&](ConfigurationRecord const &record) {
+                          return record.configuration_name ==
+                                 configuration_name;
+                        });
+  }
+  auto range = m_index_by_name.equal_range(configuration_name);
+  const_iterator result = end();
+  for (auto name_it = range.first; name_it != range.second; ++name_it) {
+    if (result == end() || *name_it->second < *result) {
+      result = name_it->second;
     }
   }
-  return end;
+  return result;
 }
 
 ConfigurationSet::size_type ConfigurationSet::count(
@@ -101,26 +201,30 @@ ConfigurationSet::size_type ConfigurationSet::count_by_name(
 }
 
 ConfigurationSet::const_iterator ConfigurationSet::erase(const_iterator it) {
+  _update_index();
+  _unindex(it);
   return m_data.erase(it);
 }
 
 ConfigurationSet::size_type ConfigurationSet::erase(
     Configuration const &configuration) {
+  _update_index();
   auto it = find(configuration);
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  erase(it);
   return 1;
 }
 
 ConfigurationSet::size_type ConfigurationSet::erase_by_name(
     std::string configuration_name) {
+  _update_index();
   auto it = find_by_name(configuration_name);
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  erase(it);
   return 1;
 }
 
@@ -136,12 +240,69 @@ std::map<std::string, Index> const &ConfigurationSet::next_config_id() const {
   return m_next_config_id;
 }
 
-std::set<ConfigurationRecord> &ConfigurationSet::data() { return m_data; }
+/// \brief Access the underlying set, for direct modification
+///
+/// Invalidates the indexes, which are rebuilt by the next non-const
+/// ConfigurationSet member function call. Until then, const lookups search
+/// the set directly.
+std::set<ConfigurationRecord> &ConfigurationSet::data() {
+  m_index_is_valid = false;
+  return m_data;
+}
 
 std::set<ConfigurationRecord> const &ConfigurationSet::data() const {
   return m_data;
 }
 
+/// \brief If true, records are also indexed by ConfigurationOccupationHash
+bool ConfigurationSet::index_by_fingerprint() const {
+  return m_use_fingerprint_index;
+}
+
+/// \brief Add a record to the indexes
+void ConfigurationSet::_index(const_iterator it) {
+  m_index_by_name.emplace(it->configuration_name, it);
+  if (m_use_fingerprint_index) {
+    m_index_by_fingerprint.emplace(
+        ConfigurationOccupationHash()(it->configuration), it);
+  }
+}
+
+/// \brief Remove a record from the indexes
+void ConfigurationSet::_unindex(const_iterator it) {
+  auto name_range = m_index_by_name.equal_range(it->configuration_name);
+  for (auto name_it = name_range.first; name_it != name_range.second;
+       ++name_it) {
+    if (name_it->second == it) {
+      m_index_by_name.erase(name_it);
+      break;
+    }
+  }
+  if (m_use_fingerprint_index) {
+    auto range = m_index_by_fingerprint.equal_range(
+        ConfigurationOccupationHash()(it->configuration));
+    for (auto f_it = range.first; f_it != range.second; ++f_it) {
+      if (f_it->second == it) {
+        m_index_by_fingerprint.erase(f_it);
+        break;
+      }
+    }
+  }
+}
+
+/// \brief Rebuild the indexes, if invalidated by `data()`
+void ConfigurationSet::_update_index() {
+  if (m_index_is_valid) {
+    return;
+  }
+  m_index_by_name.clear();
+  m_index_by_fingerprint.clear();
+  for (auto it = m_data.begin(); it != m_data.end(); ++it) {
+    _index(it);
+  }
+  m_index_is_valid = true;
+}
+
 /// \brief Make a map for finding ConfigurationRecord by configuration_name
 std::map<std::string, ConfigurationRecord const *>
 make_index_by_configuration_name(
@@ -75,7 +75,7 @@ std::shared_ptr<Supercell const> FromStructure::make_supercell(
   Eigen::Matrix3d L_ideal = U.inverse() * L_mapped;
 
   double xtal_tol = m_xtal_prim->lattice().tol();
-  return std::make_shared<Supercell>(m_prim, xtal::Lattice(L_ideal, xtal_tol));
+  return make_shared_supercell(m_prim, xtal::Lattice(L_ideal, xtal_tol));
 }
 
 Eigen::MatrixXd const &FromStructure::get_local_property_or_throw(
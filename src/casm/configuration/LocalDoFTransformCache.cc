@@ -0,0 +1,157 @@
+#include "casm/configuration/LocalDoFTransformCache.hh"
+
+#include <algorithm>
+
+#include "casm/clexulator/ConfigDoFValuesTools.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/PrimSymInfo.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param _values Local DoF values, as columns by site index. Not copied,
+///     and must outlive the cache.
+/// \param _key DoF type, used to obtain the matrix rep
+/// \param _n_sublat Number of sublattices in the prim
+/// \param _max_bytes Limit on the memory used by the cached values. If
+///     std::nullopt, all prim factor group operations are cached.
+LocalDoFTransformCache::LocalDoFTransformCache(
+    Eigen::MatrixXd const &_values, DoFKey const &_key, Index _n_sublat,
+    std::optional<Index> _max_bytes)
+    : m_values_ptr(&_values),
+      m_key(_key),
+      m_n_sublat(_n_sublat),
+      m_n_vol(_values.cols() / _n_sublat),
+      m_max_bytes(_max_bytes),
+      m_prim(nullptr),
+      m_capacity(0) {}
+
+/// \brief Return local DoF values transformed by the prim factor group
+///     operation of `op`, before site permutation
+///
+/// The result is equal to the values before site permutation in
+/// `copy_apply(op, dof_values)`, such that:
+///
+///     after.col(l) == transformed(op).col(op.combined_permute()[l])
+///
+/// The returned reference remains valid until the next-but-one call to
+/// `transformed`, or `clear`.
+Eigen::MatrixXd const &LocalDoFTransformCache::transformed(
+    SupercellSymOp const &op) const {
+  return transformed(*op.supercell()->prim, op.prim_factor_group_index());
+}
+
+/// \brief Return local DoF values transformed by a prim factor group
+///     operation, before site permutation
+Eigen::MatrixXd const &LocalDoFTransformCache::transformed(
+    Prim const &prim, Index prim_fg_index) const {
+  if (m_prim != &prim) {
+    _reset(prim);
+  }
+  if (m_transformed[prim_fg_index].size() == 0) {
+    if (m_capacity >= Index(m_transformed.size())) {
+      _make_all();
+    } else {
+      _make_one(prim_fg_index);
+    }
+  } else if (m_capacity < Index(m_transformed.size())) {
+    // bounded: mark as most recently used
+    auto it = std::find(m_order.begin(), m_order.end(), prim_fg_index);
+    m_order.erase(it);
+    m_order.push_back(prim_fg_index);
+  }
+  return m_transformed[prim_fg_index];
+}
+
+/// \brief Number of transformed values currently cached
+Index LocalDoFTransformCache::size() const { return m_order.size(); }
+
+/// \brief Erase all cached values
+void LocalDoFTransformCache::clear() const {
+  for (Index prim_fg_index : m_order) {
+    m_transformed[prim_fg_index].resize(0, 0);
+  }
+  m_order.clear();
+}
+
+void LocalDoFTransformCache::_reset(Prim const &prim) const {
+  m_prim = &prim;
+  m_order.clear();
+  m_transformed.clear();
+  Index n_fg = prim.sym_info.local_dof_symgroup_rep.at(m_key).size();
+  m_transformed.resize(n_fg);
+
+  m_capacity = n_fg;
+  if (m_max_bytes.has_value()) {
+    Index bytes_per_value =
+        std::max(Index(m_values_ptr->size() * sizeof(double)), Index(1));
+    m_capacity = std::max(*m_max_bytes / bytes_per_value, Index(2));
+  }
+}
+
+/// Construct values for all prim factor group operations, with one matrix
+/// product per sublattice for all operations
+void LocalDoFTransformCache::_make_all() const {
+  using clexulator::sublattice_block;
+  Eigen::MatrixXd const &before = *m_values_ptr;
+  sym_info::LocalDoFSymGroupRep const &rep =
+      m_prim->sym_info.local_dof_symgroup_rep.at(m_key);
+  Index n_fg = rep.size();
+
+  m_order.clear();
+  for (Index i = 0; i < n_fg; ++i) {
+    m_transformed[i] = before;
+    m_order.push_back(i);
+  }
+  if (n_fg == 0) {
+    return;
+  }
+
+  Eigen::MatrixXd stacked_M;
+  Eigen::MatrixXd stacked_after;
+  for (Index b = 0; b < m_n_sublat; ++b) {
+    Index dim = rep[0][b].cols();
+    if (dim == 0) continue;
+    stacked_M.resize(n_fg * dim, dim);
+    for (Index i = 0; i < n_fg; ++i) {
+      stacked_M.middleRows(i * dim, dim) = rep[i][b];
+    }
+    stacked_after.noalias() =
+        stacked_M * sublattice_block(before, b, m_n_vol).topRows(dim);
+    for (Index i = 0; i < n_fg; ++i) {
+      sublattice_block(m_transformed[i], b, m_n_vol).topRows(dim) =
+          stacked_after.middleRows(i * dim, dim);
+    }
+  }
+}
+
+/// Construct values for one prim factor group operation, discarding the
+/// least recently used if at capacity
+void LocalDoFTransformCache::_make_one(Index prim_fg_index) const {
+  using clexulator::sublattice_block;
+  while (Index(m_order.size()) >= m_capacity) {
+    m_transformed[m_order.front()].resize(0, 0);
+    m_order.pop_front();
+  }
+
+  Eigen::MatrixXd const &before = *m_values_ptr;
+  sym_info::LocalDoFSymOpRep const &op_rep =
+      m_prim->sym_info.local_dof_symgroup_rep.at(m_key)[prim_fg_index];
+  Eigen::MatrixXd &after = m_transformed[prim_fg_index];
+  after = before;
+  for (Index b = 0; b < m_n_sublat; ++b) {
+    Eigen::MatrixXd const &M = op_rep[b];
+    Index dim = M.cols();
+    if (dim == 0) continue;
+    sublattice_block(after, b, m_n_vol).topRows(dim).noalias() =
+        M * sublattice_block(before, b, m_n_vol).topRows(dim);
+  }
+  m_order.push_back(prim_fg_index);
+}
+
+}  // namespace config
+}  // namespace CASM
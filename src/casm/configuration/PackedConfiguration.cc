@@ -0,0 +1,264 @@
+#include "casm/configuration/PackedConfiguration.hh"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/translation_search.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Set `result` to the occupation values after applying only the
+///     factor group part of a supercell operation, reading occupants
+///     directly from packed words
+///
+/// Equivalent to `make_factor_group_occupation(unpack_occupation(
+/// configuration), supercell, supercell_factor_group_index)`.
+void _make_factor_group_occupation(PackedConfiguration const &configuration,
+                                   Supercell const &supercell,
+                                   Index supercell_factor_group_index,
+                                   Eigen::VectorXi &result) {
+  PrimSymInfo const &prim_sym_info = supercell.prim->sym_info;
+  sym_info::Permutation const &factor_group_permute =
+      supercell.sym_info.factor_group_permutations.at(
+          supercell_factor_group_index);
+  Index n_vol = supercell.superlattice.size();
+  Index n_sites = configuration.n_sites;
+
+  if (prim_sym_info.has_aniso_occs) {
+    Index prim_fg_index = supercell.sym_info.factor_group
+                              ->head_group_index[supercell_factor_group_index];
+    auto const &occ_op_rep = prim_sym_info.occ_symgroup_rep[prim_fg_index];
+    for (Index l = 0; l < n_sites; ++l) {
+      Index l_before = factor_group_permute[l];
+      result[l] =
+          occ_op_rep[l_before / n_vol][configuration.occupant(l_before)];
+    }
+  } else {
+    for (Index l = 0; l < n_sites; ++l) {
+      result[l] = configuration.occupant(factor_group_permute[l]);
+    }
+  }
+}
+
+/// \brief Pack `values[arithmetic.permute_index(l, t)]` into `candidate`,
+///     if the result is greater than `best`
+///
+/// Words are packed and compared one at a time, so candidates that are
+/// less than `best` are usually rejected after the first word.
+///
+/// \returns True if the packed result is greater than `best`, in which case
+///     `candidate` holds it; otherwise the contents of `candidate` are
+///     unspecified.
+bool _pack_if_greater(Eigen::VectorXi const &values,
+                      TranslationArithmetic const &arithmetic, Index t,
+                      int bits_per_site, std::vector<std::uint64_t> const &best,
+                      std::vector<std::uint64_t> &candidate) {
+  Index n_sites = values.size();
+  Index sites_per_word = 64 / bits_per_site;
+  bool is_greater = false;
+  Index l = 0;
+  for (Index w = 0; w < best.size(); ++w) {
+    std::uint64_t word = 0;
+    Index l_end = std::min(l + sites_per_word, n_sites);
+    for (int shift = 64 - bits_per_site; l < l_end;
+         ++l, shift -= bits_per_site) {
+      word |= std::uint64_t(values[arithmetic.permute_index(l, t)]) << shift;
+    }
+    candidate[w] = word;
+    if (!is_greater) {
+      if (word < best[w]) {
+        return false;
+      }
+      is_greater = (word > best[w]);
+    }
+  }
+  return is_greater;
+}
+
+/// \brief Return the lexicographically greatest equivalent packed occupation
+std::vector<std::uint64_t> _make_canonical_words(
+    PackedConfiguration const &configuration, Supercell const &supercell) {
+  TranslationArithmetic arithmetic(supercell.unitcell_index_converter);
+  std::vector<Index> all_translations(arithmetic.size());
+  std::iota(all_translations.begin(), all_translations.end(), 0);
+  Index n_factor_group = supercell.sym_info.factor_group_permutations.size();
+
+  std::vector<std::uint64_t> canonical_words = configuration.words;
+  std::vector<std::uint64_t> candidate(canonical_words.size());
+  Eigen::VectorXi fg_occupation(configuration.n_sites);
+  for (Index f = 0; f < n_factor_group; ++f) {
+    _make_factor_group_occupation(configuration, supercell, f, fg_occupation);
+    // all returned translations give the same occupation
+    Index t =
+        find_max_translations(fg_occupation, arithmetic, all_translations)[0];
+    if (_pack_if_greater(fg_occupation, arithmetic, t,
+                         configuration.bits_per_site, canonical_words,
+                         candidate)) {
+      canonical_words.swap(candidate);
+    }
+  }
+  return canonical_words;
+}
+
+}  // namespace
+
+/// \brief Return the handle for a supercell, inserting it if necessary
+SupercellHandleRegistry::handle_type SupercellHandleRegistry::insert(
+    std::shared_ptr<Supercell const> const &supercell) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_handles.find(supercell);
+  if (it != m_handles.end()) {
+    return it->second;
+  }
+  handle_type handle = m_supercells.size();
+  m_supercells.push_back(supercell);
+  m_handles.emplace(supercell, handle);
+  return handle;
+}
+
+/// \brief Return the supercell with the given handle
+std::shared_ptr<Supercell const> const &SupercellHandleRegistry::supercell(
+    handle_type handle) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (handle >= m_supercells.size()) {
+    throw std::runtime_error(
+        "Error in SupercellHandleRegistry::supercell: invalid handle");
+  }
+  return m_supercells[handle];
+}
+
+/// \brief Number of supercells
+Index SupercellHandleRegistry::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_supercells.size();
+}
+
+std::size_t PackedConfigurationHash::operator()(
+    PackedConfiguration const &configuration) const {
+  std::size_t seed = std::hash<std::uint32_t>()(configuration.supercell_handle);
+  for (std::uint64_t word : configuration.words) {
+    seed ^= std::hash<std::uint64_t>()(word) + 0x9e3779b97f4a7c15ULL +
+            (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+/// \brief Return the number of bits per site used to pack configurations
+///     of a prim
+///
+/// \returns 1, 2, or 4, the fewest bits that can hold the maximum number of
+///     occupants on any sublattice
+///
+/// \throws If the prim has continuous DoF, or more than 16 occupants on a
+///     sublattice
+int packed_bits_per_site(Prim const &prim) {
+  if (prim.global_dof_info.size() || prim.local_dof_info.size()) {
+    throw std::runtime_error(
+        "Error in packed_bits_per_site: only prim with no continuous DoF "
+        "may be packed");
+  }
+  Index max_n_occupants = 1;
+  for (auto const &site : prim.basicstructure->basis()) {
+    max_n_occupants =
+        std::max(max_n_occupants, Index(site.occupant_dof().size()));
+  }
+  for (int bits : {1, 2, 4}) {
+    if (max_n_occupants <= (Index(1) << bits)) {
+      return bits;
+    }
+  }
+  throw std::runtime_error(
+      "Error in packed_bits_per_site: more than 16 occupants on a sublattice");
+}
+
+/// \brief Pack occupation values
+///
+/// \param occupation Occupation values, each in [0, 2^bits_per_site)
+/// \param supercell_handle Supercell handle
+/// \param bits_per_site Number of bits per site (1, 2, or 4)
+PackedConfiguration pack(Eigen::VectorXi const &occupation,
+                         SupercellHandleRegistry::handle_type supercell_handle,
+                         int bits_per_site) {
+  PackedConfiguration configuration;
+  configuration.supercell_handle = supercell_handle;
+  configuration.bits_per_site = bits_per_site;
+  configuration.n_sites = occupation.size();
+
+  Index sites_per_word = 64 / bits_per_site;
+  configuration.words.resize(
+      (configuration.n_sites + sites_per_word - 1) / sites_per_word, 0);
+  for (Index l = 0; l < configuration.n_sites; ++l) {
+    Index shift = 64 - bits_per_site * (l % sites_per_word + 1);
+    configuration.words[l / sites_per_word] |= std::uint64_t(occupation[l])
+                                               << shift;
+  }
+  return configuration;
+}
+
+/// \brief Unpack occupation values
+Eigen::VectorXi unpack_occupation(PackedConfiguration const &configuration) {
+  Eigen::VectorXi occupation(configuration.n_sites);
+  for (Index l = 0; l < configuration.n_sites; ++l) {
+    occupation[l] = configuration.occupant(l);
+  }
+  return occupation;
+}
+
+/// \brief Pack a Configuration
+///
+/// \param configuration A configuration, with a prim that has only
+///     occupation DoF
+/// \param registry Registry used to obtain the supercell handle. The
+///     configuration's supercell is inserted if not already present.
+PackedConfiguration pack(Configuration const &configuration,
+                         SupercellHandleRegistry &registry) {
+  auto const &supercell = configuration.supercell;
+  return pack(configuration.dof_values.occupation, registry.insert(supercell),
+              packed_bits_per_site(*supercell->prim));
+}
+
+/// \brief Unpack a PackedConfiguration
+Configuration unpack(PackedConfiguration const &configuration,
+                     SupercellHandleRegistry const &registry) {
+  Configuration result(registry.supercell(configuration.supercell_handle));
+  result.dof_values.occupation = unpack_occupation(configuration);
+  return result;
+}
+
+/// \brief Return true if a PackedConfiguration is in canonical form
+///
+/// Equivalent to `is_canonical(unpack(configuration, registry))`.
+bool is_canonical(PackedConfiguration const &configuration,
+                  SupercellHandleRegistry const &registry) {
+  return make_canonical_form(configuration, registry) == configuration;
+}
+
+/// \brief Return the canonical form of a PackedConfiguration
+///
+/// Equivalent to `pack(make_canonical_form(unpack(configuration, registry)))`,
+/// but works on the packed occupation directly: for each supercell factor
+/// group operation, the translations giving the greatest occupation are found
+/// with `find_max_translations`, and the result is packed and compared word
+/// by word against the greatest result so far.
+PackedConfiguration make_canonical_form(
+    PackedConfiguration const &configuration,
+    SupercellHandleRegistry const &registry) {
+  Supercell const &supercell =
+      *registry.supercell(configuration.supercell_handle);
+  PackedConfiguration result;
+  result.supercell_handle = configuration.supercell_handle;
+  result.bits_per_site = configuration.bits_per_site;
+  result.n_sites = configuration.n_sites;
+  result.words = _make_canonical_words(configuration, supercell);
+  return result;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,317 @@
+#include "casm/configuration/QuantizedConfiguration.hh"
+
+#include <cmath>
+#include <functional>
+#include <map>
+#include <stdexcept>
+
+#include "casm/configuration/LocalDoFTransformCache.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+void _check_tol(double tol) {
+  if (!(tol > 0.0)) {
+    throw std::runtime_error(
+        "Error in QuantizedConfiguration: tol must be positive");
+  }
+}
+
+std::int64_t _quantize(double x, double tol) { return std::llround(x / tol); }
+
+/// Write quantized DoF values to `key`, re-using its storage
+void _make_quantized_dof_values(clexulator::ConfigDoFValues const &dof_values,
+                                double tol, std::vector<std::int64_t> &key) {
+  key.clear();
+  for (auto const &dof : dof_values.global_dof_values) {
+    Eigen::VectorXd const &values = dof.second;
+    for (Index i = 0; i < values.size(); ++i) {
+      key.push_back(_quantize(values[i], tol));
+    }
+  }
+  Eigen::VectorXi const &occupation = dof_values.occupation;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    key.push_back(occupation[l]);
+  }
+  for (auto const &dof : dof_values.local_dof_values) {
+    Eigen::MatrixXd const &values = dof.second;
+    for (Index i = 0; i < values.size(); ++i) {
+      key.push_back(_quantize(values.data()[i], tol));
+    }
+  }
+}
+
+int _compare(std::int64_t lhs, std::int64_t rhs) {
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+/// Cache local DoF values transformed by prim factor group operations
+std::map<DoFKey, LocalDoFTransformCache> _make_local_dof_caches(
+    Configuration const &configuration) {
+  Index n_sublat =
+      configuration.supercell->prim->basicstructure->basis().size();
+  std::map<DoFKey, LocalDoFTransformCache> local_dof_caches;
+  for (auto const &dof : configuration.dof_values.local_dof_values) {
+    local_dof_caches.emplace(
+        std::piecewise_construct, std::forward_as_tuple(dof.first),
+        std::forward_as_tuple(dof.second, dof.first, n_sublat));
+  }
+  return local_dof_caches;
+}
+
+/// \brief Visit the quantized DoF values of a configuration transformed by
+///     `op`, in `key` order, without constructing the transformed
+///     configuration
+///
+/// \param op Symmetry operation
+/// \param configuration Quantized configuration to transform
+/// \param local_dof_caches Local DoF values of `configuration`, transformed
+///     by prim factor group operations, by DoF type
+/// \param f Called as `int f(std::int64_t value)` for each value, in turn,
+///     until it returns a non-zero value
+///
+/// \returns The first non-zero value returned by `f`, or 0
+template <typename F>
+int _for_each_transformed_value(
+    SupercellSymOp const &op, QuantizedConfiguration const &configuration,
+    std::map<DoFKey, LocalDoFTransformCache> const &local_dof_caches, F f) {
+  clexulator::ConfigDoFValues const &dof_values =
+      configuration.configuration.dof_values;
+  double tol = configuration.tol;
+  PrimSymInfo const &prim_sym_info = op.supercell()->prim->sym_info;
+  Index prim_fg_index = op.prim_factor_group_index();
+  Index n_vol = op.supercell()->superlattice.size();
+
+  // global DoF
+  for (auto const &dof : dof_values.global_dof_values) {
+    Eigen::MatrixXd const &M =
+        prim_sym_info.global_dof_symgroup_rep.at(dof.first)[prim_fg_index];
+    Eigen::VectorXd transformed = M * dof.second;
+    for (Index i = 0; i < transformed.size(); ++i) {
+      if (int c = f(_quantize(transformed[i], tol))) {
+        return c;
+      }
+    }
+  }
+
+  // occupation
+  Eigen::VectorXi const &occupation = dof_values.occupation;
+  if (prim_sym_info.has_aniso_occs) {
+    sym_info::OccSymOpRep const &occ_rep =
+        prim_sym_info.occ_symgroup_rep[prim_fg_index];
+    for (Index l = 0; l < occupation.size(); ++l) {
+      Index before = op.permute_index(l);
+      if (int c = f(occ_rep[before / n_vol][occupation[before]])) {
+        return c;
+      }
+    }
+  } else {
+    for (Index l = 0; l < occupation.size(); ++l) {
+      if (int c = f(occupation[op.permute_index(l)])) {
+        return c;
+      }
+    }
+  }
+
+  // local DoF
+  for (auto const &dof : dof_values.local_dof_values) {
+    Eigen::MatrixXd const &transformed =
+        local_dof_caches.at(dof.first).transformed(op);
+    for (Index l = 0; l < transformed.cols(); ++l) {
+      Index before = op.permute_index(l);
+      for (Index i = 0; i < transformed.rows(); ++i) {
+        if (int c = f(_quantize(transformed(i, before), tol))) {
+          return c;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+/// \brief Compare `key` to the key of a configuration transformed by `op`
+///
+/// Transformed values are quantized and compared one at a time, in `key`
+/// order, stopping at the first difference, as in ConfigCompare.
+///
+/// \returns A negative value if `key` is less than the key of the
+///     transformed configuration, zero if equal, else a positive value
+int _compare_key(
+    std::vector<std::int64_t> const &key, SupercellSymOp const &op,
+    QuantizedConfiguration const &configuration,
+    std::map<DoFKey, LocalDoFTransformCache> const &local_dof_caches) {
+  Index k = 0;
+  return _for_each_transformed_value(
+      op, configuration, local_dof_caches,
+      [&](std::int64_t value) { return _compare(key[k++], value); });
+}
+
+/// \brief Set `key` to the key of a configuration transformed by `op`
+void _make_key(SupercellSymOp const &op,
+               QuantizedConfiguration const &configuration,
+               std::map<DoFKey, LocalDoFTransformCache> const &local_dof_caches,
+               std::vector<std::int64_t> &key) {
+  key.clear();
+  _for_each_transformed_value(op, configuration, local_dof_caches,
+                              [&](std::int64_t value) {
+                                key.push_back(value);
+                                return 0;
+                              });
+}
+
+}  // namespace
+
+/// \brief Constructor, using the prim lattice tolerance
+QuantizedConfiguration::QuantizedConfiguration(
+    Configuration const &_configuration)
+    : QuantizedConfiguration(
+          _configuration,
+          _configuration.supercell->prim->basicstructure->lattice().tol()) {}
+
+/// \brief Constructor
+///
+/// \param _configuration Configuration to quantize. Continuous DoF values
+///     are snapped to the nearest multiple of `_tol`.
+/// \param _tol Quantization tolerance. Must be positive.
+QuantizedConfiguration::QuantizedConfiguration(
+    Configuration const &_configuration, double _tol)
+    : configuration(_configuration), tol(_tol) {
+  _check_tol(tol);
+  snap(configuration.dof_values, tol);
+  _make_quantized_dof_values(configuration.dof_values, tol, key);
+}
+
+/// \brief Less than comparison, by `tol`, then supercell, then `key`
+///
+/// Comparing `tol` first makes this consistent with `operator==`, which
+/// treats QuantizedConfiguration with different `tol` as not equal.
+bool QuantizedConfiguration::operator<(
+    QuantizedConfiguration const &rhs) const {
+  if (tol != rhs.tol) {
+    return tol < rhs.tol;
+  }
+  if (configuration.supercell != rhs.configuration.supercell &&
+      *configuration.supercell != *rhs.configuration.supercell) {
+    return *configuration.supercell < *rhs.configuration.supercell;
+  }
+  return key < rhs.key;
+}
+
+bool QuantizedConfiguration::operator==(
+    QuantizedConfiguration const &rhs) const {
+  if (configuration.supercell != rhs.configuration.supercell &&
+      *configuration.supercell != *rhs.configuration.supercell) {
+    return false;
+  }
+  return tol == rhs.tol && key == rhs.key;
+}
+
+bool QuantizedConfiguration::operator!=(
+    QuantizedConfiguration const &rhs) const {
+  return !(*this == rhs);
+}
+
+std::size_t QuantizedConfigurationHash::operator()(
+    QuantizedConfiguration const &configuration) const {
+  std::size_t seed = TransformationMatrixHash()(
+      configuration.configuration.supercell->superlattice
+          .transformation_matrix_to_super());
+  for (std::int64_t value : configuration.key) {
+    seed ^= std::hash<std::int64_t>()(value) + 0x9e3779b97f4a7c15ULL +
+            (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+/// \brief Return DoF values quantized with tolerance `tol`
+///
+/// \returns Global DoF values, by DoF type, then occupation, then local DoF
+///     values, by DoF type, by site, then by component. Continuous values
+///     `x` are quantized as `std::llround(x / tol)`.
+std::vector<std::int64_t> make_quantized_dof_values(
+    clexulator::ConfigDoFValues const &dof_values, double tol) {
+  _check_tol(tol);
+  std::vector<std::int64_t> key;
+  _make_quantized_dof_values(dof_values, tol, key);
+  return key;
+}
+
+/// \brief Snap continuous DoF values to multiples of `tol`
+clexulator::ConfigDoFValues &snap(clexulator::ConfigDoFValues &dof_values,
+                                  double tol) {
+  _check_tol(tol);
+  auto _snap = [=](double x) { return tol * _quantize(x, tol); };
+  for (auto &dof : dof_values.global_dof_values) {
+    dof.second = dof.second.unaryExpr(_snap);
+  }
+  for (auto &dof : dof_values.local_dof_values) {
+    dof.second = dof.second.unaryExpr(_snap);
+  }
+  return dof_values;
+}
+
+/// \brief Return true if a QuantizedConfiguration is in canonical form
+///
+/// A QuantizedConfiguration is canonical if its `key` compares greater than
+/// or equal to the `key` of all equivalents in the same supercell, each
+/// quantized after applying the symmetry operation. Comparisons are exact,
+/// and stop at the first value that differs.
+bool is_canonical(QuantizedConfiguration const &configuration) {
+  auto const &supercell = configuration.configuration.supercell;
+  std::map<DoFKey, LocalDoFTransformCache> local_dof_caches =
+      _make_local_dof_caches(configuration.configuration);
+  auto begin = SupercellSymOp::begin(supercell);
+  auto end = SupercellSymOp::end(supercell);
+  for (auto it = begin; it != end; ++it) {
+    if (_compare_key(configuration.key, *it, configuration,
+                     local_dof_caches) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return the canonical form of a QuantizedConfiguration
+///
+/// The canonical form is the equivalent in the same supercell, quantized
+/// after applying the symmetry operation, with the greatest `key`. Keys are
+/// compared while applying each operation, stopping at the first value that
+/// differs, and only the key of a new greatest equivalent is constructed in
+/// full.
+///
+/// Notes:
+/// - Snapping commutes with operations whose DoF matrix representations are
+///   signed permutations (i.e. cubic point groups with Cartesian DoF
+///   bases). Otherwise, equivalent configurations with values within
+///   rounding of a multiple of `tol` may have different canonical forms.
+QuantizedConfiguration make_canonical_form(
+    QuantizedConfiguration const &configuration) {
+  auto const &supercell = configuration.configuration.supercell;
+  std::map<DoFKey, LocalDoFTransformCache> local_dof_caches =
+      _make_local_dof_caches(configuration.configuration);
+  std::vector<std::int64_t> max_key = configuration.key;
+  auto begin = SupercellSymOp::begin(supercell);
+  auto end = SupercellSymOp::end(supercell);
+  SupercellSymOp op = *begin;
+  bool found_greater = false;
+  for (auto it = begin; it != end; ++it) {
+    if (_compare_key(max_key, *it, configuration, local_dof_caches) < 0) {
+      _make_key(*it, configuration, local_dof_caches, max_key);
+      op = *it;
+      found_greater = true;
+    }
+  }
+  if (!found_greater) {
+    return configuration;
+  }
+  return QuantizedConfiguration(copy_apply(op, configuration.configuration),
+                                configuration.tol);
+}
+
+}  // namespace config
+}  // namespace CASM
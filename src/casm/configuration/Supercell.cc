@@ -1,36 +1,45 @@
 #include "casm/configuration/Supercell.hh"
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+
 #include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/ThreadPool.hh"
 
 namespace CASM {
 namespace config {
 
 Supercell::Supercell(std::shared_ptr<Prim const> const &_prim,
                      Lattice const &_superlattice,
-                     Index max_n_translation_permutations)
+                     Index max_n_translation_permutations,
+                     Index max_permutation_table_bytes)
     : Supercell(_prim,
                 Superlattice(_prim->basicstructure->lattice(), _superlattice),
-                max_n_translation_permutations) {}
+                max_n_translation_permutations, max_permutation_table_bytes) {}
 
 Supercell::Supercell(std::shared_ptr<Prim const> const &_prim,
                      Superlattice const &_superlattice,
-                     Index max_n_translation_permutations)
+                     Index max_n_translation_permutations,
+                     Index max_permutation_table_bytes)
     : prim(_prim),
       superlattice(_superlattice),
       unitcell_index_converter(superlattice.transformation_matrix_to_super()),
       unitcellcoord_index_converter(
           superlattice.transformation_matrix_to_super(),
           prim->basicstructure->basis().size()),
-      sym_info(prim, superlattice, unitcell_index_converter,
-               unitcellcoord_index_converter, max_n_translation_permutations) {}
+      sym_info(prim, superlattice, max_n_translation_permutations,
+               max_permutation_table_bytes) {}
 
 Supercell::Supercell(std::shared_ptr<Prim const> const &_prim,
                      Eigen::Matrix3l const &_superlattice_matrix,
-                     Index max_n_translation_permutations)
+                     Index max_n_translation_permutations,
+                     Index max_permutation_table_bytes)
     : Supercell(
           _prim,
           Superlattice(_prim->basicstructure->lattice(), _superlattice_matrix),
-          max_n_translation_permutations) {}
+          max_n_translation_permutations, max_permutation_table_bytes) {}
 
 /// \brief Less than comparison of Supercell
 bool Supercell::operator<(Supercell const &B) const {
@@ -59,5 +68,170 @@ bool Supercell::eq_impl(Supercell const &B) const {
          B.superlattice.transformation_matrix_to_super();
 }
 
+/// \brief Construct the lazily constructed symmetry information of many
+///     supercells, in parallel
+///
+/// SupercellSymInfo members are constructed on first access. Use this to
+/// construct them in advance, for example after reading many supercells,
+/// so the cost is not paid later by a single thread.
+///
+/// \param supercells Supercells
+/// \param pool Thread pool
+void warm_sym_info(
+    std::vector<std::shared_ptr<Supercell const>> const &supercells,
+    ThreadPool &pool) {
+  pool.parallel_for(supercells.size(), [&](Index begin, Index end) {
+    for (Index i = begin; i < end; ++i) {
+      supercells[i]->sym_info.warm();
+    }
+  });
+}
+
+namespace {
+
+/// \brief Process-wide registry of shared Supercell, used by
+///     make_shared_supercell
+///
+/// Notes:
+/// - Supercell are referenced by `(prim address, transformation matrix)`.
+///   A live Supercell keeps its prim alive, so the prim address can not be
+///   re-used while the entry is valid.
+/// - Entries hold std::weak_ptr, so the registry does not extend the
+///   lifetime of any Supercell. Expired entries are removed as the registry
+///   grows.
+/// - The registry mutex is only held for lookup. Each entry has its own
+///   mutex, held while constructing the Supercell, so that equivalent
+///   Supercell are constructed once while different Supercell may be
+///   constructed concurrently.
+class SupercellRegistry {
+ public:
+  std::shared_ptr<Supercell const> get(
+      std::shared_ptr<Prim const> const &prim,
+      Eigen::Matrix3l const &transformation_matrix_to_super) {
+    std::shared_ptr<Entry> entry;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      Key key(prim.get(), transformation_matrix_to_super);
+      auto it = m_entries.find(key);
+      if (it == m_entries.end()) {
+        if (m_entries.size() >= m_next_purge_size) {
+          _purge();
+        }
+        it = m_entries.emplace(key, std::make_shared<Entry>()).first;
+      }
+      entry = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    std::shared_ptr<Supercell const> supercell = entry->supercell.lock();
+    if (!supercell) {
+      supercell = std::make_shared<Supercell const>(
+          prim, transformation_matrix_to_super);
+      entry->supercell = supercell;
+    }
+    return supercell;
+  }
+
+ private:
+  struct Entry {
+    std::mutex mutex;
+    std::weak_ptr<Supercell const> supercell;
+  };
+
+  struct Key {
+    Key(Prim const *_prim, Eigen::Matrix3l const &_T) : prim(_prim) {
+      std::copy(_T.data(), _T.data() + 9, T);
+    }
+
+    Prim const *prim;
+    long T[9];
+
+    bool operator<(Key const &rhs) const {
+      if (prim != rhs.prim) {
+        return std::less<Prim const *>()(prim, rhs.prim);
+      }
+      return std::lexicographical_compare(T, T + 9, rhs.T, rhs.T + 9);
+    }
+  };
+
+  /// \brief Erase expired entries (requires m_mutex)
+  ///
+  /// Entries that are being constructed (entry mutex held) are kept.
+  void _purge() {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+      std::unique_lock<std::mutex> entry_lock(it->second->mutex,
+                                              std::try_to_lock);
+      if (entry_lock.owns_lock() && it->second->supercell.expired()) {
+        entry_lock.unlock();
+        it = m_entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    m_next_purge_size = std::max(Index(64), Index(2 * m_entries.size()));
+  }
+
+  std::mutex m_mutex;
+  std::map<Key, std::shared_ptr<Entry>> m_entries;
+  Index m_next_purge_size = 64;
+};
+
+SupercellRegistry &supercell_registry() {
+  static SupercellRegistry registry;
+  return registry;
+}
+
+}  // namespace
+
+/// \brief Return a shared Supercell, re-using an existing equivalent
+///     Supercell if one exists
+///
+/// Constructing a Supercell constructs its SupercellSymInfo, which can be
+/// expensive. This function keeps a process-wide, thread-safe registry of
+/// the Supercell it has constructed, so that a Supercell with the same prim
+/// and transformation matrix is returned if one is still in use elsewhere.
+///
+/// Notes:
+/// - Only Supercell with default construction parameters are shared.
+/// - The registry does not keep Supercell alive. If all other references to
+///   a Supercell are released, it will be constructed again when next
+///   requested.
+///
+/// \param prim The prim
+/// \param transformation_matrix_to_super The transformation matrix, T,
+///     such that `S = P * T`, where S and P are the supercell and prim lattice
+///     column vector matrices.
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim,
+    Eigen::Matrix3l const &transformation_matrix_to_super) {
+  return supercell_registry().get(prim, transformation_matrix_to_super);
+}
+
+/// \brief Return a shared Supercell, re-using an existing equivalent
+///     Supercell if one exists
+///
+/// Equivalent to:
+/// \code
+/// make_shared_supercell(
+///     prim, Superlattice(prim->basicstructure->lattice(), superlattice));
+/// \endcode
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim, Lattice const &superlattice) {
+  return make_shared_supercell(
+      prim, Superlattice(prim->basicstructure->lattice(), superlattice));
+}
+
+/// \brief Return a shared Supercell, re-using an existing equivalent
+///     Supercell if one exists
+///
+/// Supercell are identified by their transformation matrix, so the
+/// superlattice of the result is the prim lattice transformed by
+/// `superlattice.transformation_matrix_to_super()`.
+std::shared_ptr<Supercell const> make_shared_supercell(
+    std::shared_ptr<Prim const> const &prim, Superlattice const &superlattice) {
+  return make_shared_supercell(prim,
+                               superlattice.transformation_matrix_to_super());
+}
+
 }  // namespace config
 }  // namespace CASM
@@ -1,5 +1,7 @@
 #include "casm/configuration/SupercellSet.hh"
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <set>
 
@@ -16,17 +18,16 @@ SupercellRecord::SupercellRecord(
     : supercell(throw_if_equal_to_nullptr(
           _supercell,
           "Error in SupercellRecord constructor: value == nullptr")),
-      supercell_name(
-          make_supercell_name(supercell->superlattice.prim_lattice(),
-                              supercell->superlattice.superlattice())),
-      is_canonical(config::is_canonical(*supercell)) {
+      supercell_name(hermite_normal_form_name(
+          supercell->superlattice.transformation_matrix_to_super())) {
+  SupercellCanonicalSearchResult result =
+      canonical_supercell_search(*this->supercell);
+  this->is_canonical = result.is_canonical;
   if (this->is_canonical) {
     this->canonical_supercell_name = this->supercell_name;
   } else {
-    auto canonical_supercell = make_canonical_form(*this->supercell);
     this->canonical_supercell_name =
-        make_supercell_name(canonical_supercell->superlattice.prim_lattice(),
-                            canonical_supercell->superlattice.superlattice());
+        hermite_normal_form_name(result.canonical_transformation_matrix);
   }
 }
 
@@ -34,20 +35,56 @@ bool SupercellRecord::operator<(SupercellRecord const &rhs) const {
   return *this->supercell < *rhs.supercell;
 }
 
+/// \brief Hash of an integer transformation matrix
+std::size_t TransformationMatrixHash::operator()(
+    Eigen::Matrix3l const &T) const {
+  std::size_t seed = 0;
+  for (Index i = 0; i < 9; ++i) {
+    seed ^= std::hash<long>()(T.data()[i]) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+  }
+  return seed;
+}
+
 SupercellSet::SupercellSet(std::shared_ptr<Prim const> const &_prim)
-    : m_prim(_prim), m_data() {
+    : m_prim(_prim), m_data(), m_index_is_valid(true) {
   if (m_prim == nullptr) {
     throw std::runtime_error("Error constructing SupercellSet: prim is empty");
   }
 }
 
+/// \brief Copy constructor
+///
+/// Indexes hold iterators into the set, so they are rebuilt rather than
+/// copied.
+SupercellSet::SupercellSet(SupercellSet const &other)
+    : m_prim(other.m_prim), m_data(other.m_data), m_index_is_valid(false) {
+  _update_index();
+}
+
+/// \brief Copy assignment
+SupercellSet &SupercellSet::operator=(SupercellSet const &other) {
+  if (this != &other) {
+    m_prim = other.m_prim;
+    m_data = other.m_data;
+    m_index_is_valid = false;
+    _update_index();
+  }
+  return *this;
+}
+
 std::shared_ptr<Prim const> SupercellSet::prim() const { return m_prim; }
 
 bool SupercellSet::empty() const { return m_data.empty(); }
 
 SupercellSet::size_type SupercellSet::size() const { return m_data.size(); }
 
-void SupercellSet::clear() { m_data.clear(); }
+void SupercellSet::clear() {
+  m_data.clear();
+  m_index_by_transformation_matrix.clear();
+  m_index_by_canonical_name.clear();
+  m_index_is_valid = true;
+}
 
 SupercellSet::const_iterator SupercellSet::begin() const {
   return m_data.begin();
@@ -57,21 +94,36 @@ SupercellSet::const_iterator SupercellSet::end() const { return m_data.end(); }
 
 std::pair<SupercellSet::iterator, bool> SupercellSet::insert(
     std::shared_ptr<Supercell const> supercell) {
-  return m_data.emplace(supercell);
+  _update_index();
+  auto it = find(supercell);
+  if (it != end()) {
+    return std::make_pair(it, false);
+  }
+  auto result = m_data.emplace(supercell);
+  _index(result.first);
+  return result;
 }
 
 std::pair<SupercellSet::iterator, bool> SupercellSet::insert(
     SupercellRecord const &record) {
-  return m_data.insert(record);
+  _update_index();
+  auto result = m_data.insert(record);
+  if (result.second) {
+    _index(result.first);
+  }
+  return result;
 }
 
 std::pair<SupercellSet::iterator, bool> SupercellSet::insert(
     Eigen::Matrix3l const &transformation_matrix_to_super) {
+  _update_index();
   auto it = find(transformation_matrix_to_super);
   if (it == end()) {
-    auto supercell = std::make_shared<Supercell const>(
-        m_prim, transformation_matrix_to_super);
-    return m_data.emplace(supercell);
+    auto supercell =
+        make_shared_supercell(m_prim, transformation_matrix_to_super);
+    auto result = m_data.emplace(supercell);
+    _index(result.first);
+    return result;
   } else {
     return std::make_pair(it, false);
   }
@@ -91,13 +143,13 @@ std::pair<SupercellSet::iterator, bool> SupercellSet::insert(
 ///
 std::pair<SupercellSet::iterator, bool> SupercellSet::insert_canonical(
     std::string supercell_name) {
+  _update_index();
   auto it = find_canonical_by_name(supercell_name);
   if (it == end()) {
-    auto supercell = std::make_shared<Supercell const>(
+    auto supercell = make_shared_supercell(
         m_prim, make_superlattice_from_supercell_name(
                     m_prim->basicstructure->lattice(), supercell_name));
-    auto canonical_supercell = make_canonical_form(*supercell);
-    auto result = m_data.emplace(canonical_supercell);
+    auto result = insert(make_canonical_form(*supercell));
     if (result.first->canonical_supercell_name != supercell_name) {
       throw std::runtime_error(
           "Error in SupercellSet::insert_canonical: supercell_name is not the "
@@ -109,8 +161,15 @@ std::pair<SupercellSet::iterator, bool> SupercellSet::insert_canonical(
   }
 }
 
+/// \brief Find a supercell
+///
+/// Supercells with the same prim as this set are found by transformation
+/// matrix, without constructing a SupercellRecord.
 SupercellSet::const_iterator SupercellSet::find(
     std::shared_ptr<Supercell const> supercell) const {
+  if (supercell != nullptr && supercell->prim == m_prim) {
+    return find(supercell->superlattice.transformation_matrix_to_super());
+  }
   return m_data.find(SupercellRecord(supercell));
 }
 
@@ -119,34 +178,50 @@ SupercellSet::const_iterator SupercellSet::find(
   return m_data.find(record);
 }
 
+/// \brief Find a supercell by transformation matrix
+///
+/// O(1) using the index, or a linear search if the index has been
+/// invalidated by `data()`.
 SupercellSet::const_iterator SupercellSet::find(
     Eigen::Matrix3l const &transformation_matrix_to_super) const {
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->supercell->superlattice.transformation_matrix_to_super() ==
-        transformation_matrix_to_super) {
-      return it;
-    }
+  if (!m_index_is_valid) {
+    return std::find_if(begin(), end(), [&](SupercellRecord const &record) {
+      return record.supercell->superlattice.transformation_matrix_to_super() ==
+             transformation_matrix_to_super;
+    });
+  }
+  auto it = m_index_by_transformation_matrix.find(
+      transformation_matrix_to_super);
+  if (it == m_index_by_transformation_matrix.end()) {
+    return end();
   }
-  return end;
+  return it->second;
 }
 
+/// \brief Find a canonical supercell by name
+///
+/// O(1) using the index, or a linear search if the index has been
+/// invalidated by `data()`.
 SupercellSet::const_iterator SupercellSet::find_canonical_by_name(
     std::string name) const {
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->is_canonical && it->supercell_name == name) {
-      return it;
-    }
+  if (!m_index_is_valid) {
+    return std::find_if(begin(), end(), [&](SupercellRecord const &record) {
+      return record.is_canonical && record.supercell_name == name;
+    });
+  }
+  auto it = m_index_by_canonical_name.find(name);
+  if (it == m_index_by_canonical_name.end()) {
+    return end();
   }
-  return end;
+  return it->second;
 }
 
 SupercellSet::size_type SupercellSet::count(
     std::shared_ptr<Supercell const> supercell) const {
-  return m_data.count(SupercellRecord(supercell));
+  if (find(supercell) != end()) {
+    return 1;
+  }
+  return 0;
 }
 
 SupercellSet::size_type SupercellSet::count(
@@ -164,54 +239,103 @@ SupercellSet::size_type SupercellSet::count(
 
 SupercellSet::size_type SupercellSet::count_canonical_by_name(
     std::string name) const {
-  SupercellSet::size_type n = 0;
-  auto it = this->begin();
-  auto end = this->end();
-  for (; it != end; ++it) {
-    if (it->is_canonical && it->supercell_name == name) {
-      ++n;
-    }
+  if (find_canonical_by_name(name) != end()) {
+    return 1;
   }
-  return n;
+  return 0;
 }
 
 SupercellSet::const_iterator SupercellSet::erase(const_iterator it) {
+  _update_index();
+  _unindex(it);
   return m_data.erase(it);
 }
 
 SupercellSet::size_type SupercellSet::erase(
     std::shared_ptr<Supercell const> supercell) {
-  return m_data.erase(SupercellRecord(supercell));
+  _update_index();
+  auto it = find(supercell);
+  if (it == end()) {
+    return 0;
+  }
+  erase(it);
+  return 1;
 }
 
 SupercellSet::size_type SupercellSet::erase(SupercellRecord const &record) {
-  return m_data.erase(record);
+  auto it = find(record);
+  if (it == end()) {
+    return 0;
+  }
+  erase(it);
+  return 1;
 }
 
 SupercellSet::size_type SupercellSet::erase(
     Eigen::Matrix3l const &transformation_matrix_to_super) {
+  _update_index();
   auto it = find(transformation_matrix_to_super);
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  erase(it);
   return 1;
 }
 
 SupercellSet::size_type SupercellSet::erase_canonical_by_name(
     std::string name) {
+  _update_index();
   auto it = find_canonical_by_name(name);
   if (it == end()) {
     return 0;
   }
-  m_data.erase(it);
+  erase(it);
   return 1;
 }
 
-std::set<SupercellRecord> &SupercellSet::data() { return m_data; }
+/// \brief Access the underlying set, for direct modification
+///
+/// Invalidates the indexes, which are rebuilt by the next non-const
+/// SupercellSet member function call. Until then, const lookups use a linear
+/// search.
+std::set<SupercellRecord> &SupercellSet::data() {
+  m_index_is_valid = false;
+  return m_data;
+}
 
 std::set<SupercellRecord> const &SupercellSet::data() const { return m_data; }
 
+/// \brief Add a record to the indexes
+void SupercellSet::_index(const_iterator it) {
+  m_index_by_transformation_matrix.emplace(
+      it->supercell->superlattice.transformation_matrix_to_super(), it);
+  if (it->is_canonical) {
+    m_index_by_canonical_name.emplace(it->supercell_name, it);
+  }
+}
+
+/// \brief Remove a record from the indexes
+void SupercellSet::_unindex(const_iterator it) {
+  m_index_by_transformation_matrix.erase(
+      it->supercell->superlattice.transformation_matrix_to_super());
+  if (it->is_canonical) {
+    m_index_by_canonical_name.erase(it->supercell_name);
+  }
+}
+
+/// \brief Rebuild the indexes, if invalidated by `data()`
+void SupercellSet::_update_index() {
+  if (m_index_is_valid) {
+    return;
+  }
+  m_index_by_transformation_matrix.clear();
+  m_index_by_canonical_name.clear();
+  for (auto it = m_data.begin(); it != m_data.end(); ++it) {
+    _index(it);
+  }
+  m_index_is_valid = true;
+}
+
 std::map<std::string, SupercellRecord const *>
 make_index_by_canonical_supercell_name(
     std::set<SupercellRecord> const &supercells) {
@@ -232,7 +356,7 @@ SupercellRecord const *find_or_add_canonical_supercell_by_name(
   SupercellRecord const *s = nullptr;
   auto it = index_by_supercell_name.find(supercell_name);
   if (it == index_by_supercell_name.end()) {
-    auto supercell = std::make_shared<Supercell const>(
+    auto supercell = make_shared_supercell(
         prim, make_superlattice_from_supercell_name(
                   prim->basicstructure->lattice(), supercell_name));
     auto canonical_supercell = make_canonical_form(*supercell);
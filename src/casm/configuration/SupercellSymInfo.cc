@@ -1,5 +1,8 @@
 #include "casm/configuration/SupercellSymInfo.hh"
 
+#include <cstdlib>
+#include <limits>
+
 #include "casm/configuration/Prim.hh"
 #include "casm/crystallography/LinearIndexConverter.hh"
 #include "casm/crystallography/Superlattice.hh"
@@ -10,30 +13,95 @@ namespace config {
 
 /// \brief Constructor
 ///
-/// \brief prim Prim associated with this supercell
-/// \brief superlattice Superlattice for this supercell
-/// \brief ijk_index_converter UnitCell and linear unit cell index conversions
-///     in this supercell.
-/// \brief bijk_index_converter UnitCellCoord and linear site index conversions
-///     in this supercell.
-/// \brief max_n_translation_permutations If superlattice.size() is greater than
-///     max_n_translation_permutations, do not populate
+/// Members are constructed lazily, on first access.
+///
+/// \param prim Prim associated with this supercell
+/// \param superlattice Superlattice for this supercell
+/// \param max_n_translation_permutations If superlattice.size() is greater
+///     than max_n_translation_permutations, do not populate
 ///     SupercellSymInfo::translation_permutations (default=100).
+/// \param max_permutation_table_bytes If the table of combined factor group
+///     and translation permutations requires more than
+///     max_permutation_table_bytes, it is never constructed
+///     (default=2^27, 128 MiB, which allows the table for supercells of up to
+///     ~1000 unit cells with 48 factor group operations and one site per
+///     unit cell). Otherwise, it is constructed lazily, on the first call to
+///     `combined_permutations->construct()`.
+SupercellSymInfo::SupercellSymInfo(std::shared_ptr<Prim const> const &prim,
+                                   Superlattice const &superlattice,
+                                   Index max_n_translation_permutations,
+                                   Index max_permutation_table_bytes)
+    : factor_group([prim, T = superlattice.transformation_matrix_to_super()]() {
+        Superlattice superlattice(prim->basicstructure->lattice(), T);
+        return std::make_shared<SymGroup const>(
+            make_factor_group(prim, superlattice));
+      }),
+      translation_permutations(
+          [prim, T = superlattice.transformation_matrix_to_super(),
+           max_n_translation_permutations]()
+              -> std::optional<std::vector<sym_info::Permutation>> {
+            if (std::abs(T.determinant()) > max_n_translation_permutations) {
+              return std::nullopt;
+            }
+            xtal::UnitCellIndexConverter unitcell_index_converter(T);
+            xtal::UnitCellCoordIndexConverter unitcellcoord_index_converter(
+                T, prim->basicstructure->basis().size());
+            return make_translation_permutations(
+                unitcell_index_converter, unitcellcoord_index_converter);
+          }),
+      factor_group_permutations(
+          [prim, T = superlattice.transformation_matrix_to_super(),
+           factor_group = factor_group]() {
+            xtal::UnitCellCoordIndexConverter unitcellcoord_index_converter(
+                T, prim->basicstructure->basis().size());
+            return make_factor_group_permutations(
+                factor_group->head_group_index,
+                prim->sym_info.unitcellcoord_symgroup_rep,
+                unitcellcoord_index_converter);
+          }),
+      factor_group_point_matrices([prim, factor_group = factor_group]() {
+        return make_factor_group_point_matrices(
+            factor_group->head_group_index,
+            prim->sym_info.unitcellcoord_symgroup_rep);
+      }),
+      factor_group_product_translations([prim, factor_group = factor_group]() {
+        return make_factor_group_product_translations(
+            *factor_group, prim->sym_info.unitcellcoord_symgroup_rep);
+      }),
+      combined_permutations(
+          [prim, T = superlattice.transformation_matrix_to_super(),
+           max_permutation_table_bytes,
+           factor_group_permutations = factor_group_permutations]() {
+            return std::make_shared<CombinedPermutationCache const>(
+                factor_group_permutations.get_shared(), T,
+                prim->basicstructure->basis().size(),
+                max_permutation_table_bytes);
+          }) {}
+
+/// \brief Constructor (deprecated, the index converters are not used)
+///
+/// Equivalent to `SupercellSymInfo(prim, superlattice,
+/// max_n_translation_permutations)`. Kept for compatibility with code
+/// written when members were constructed eagerly using the supercell index
+/// converters.
 SupercellSymInfo::SupercellSymInfo(
     std::shared_ptr<Prim const> const &prim, Superlattice const &superlattice,
     xtal::UnitCellIndexConverter const &unitcell_index_converter,
     xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter,
     Index max_n_translation_permutations)
-    : factor_group(std::make_shared<SymGroup const>(
-          make_factor_group(prim, superlattice))),
-      factor_group_permutations(make_factor_group_permutations(
-          factor_group->head_group_index,
-          prim->sym_info.unitcellcoord_symgroup_rep,
-          unitcellcoord_index_converter)) {
-  if (superlattice.size() <= max_n_translation_permutations) {
-    translation_permutations = make_translation_permutations(
-        unitcell_index_converter, unitcellcoord_index_converter);
-  }
+    : SupercellSymInfo(prim, superlattice, max_n_translation_permutations) {}
+
+/// \brief Construct all lazily constructed members
+///
+/// The combined permutation table is not constructed, it is constructed
+/// lazily, on the first call to `combined_permutations->construct()`.
+void SupercellSymInfo::warm() const {
+  factor_group.get();
+  translation_permutations.get();
+  factor_group_permutations.get();
+  factor_group_point_matrices.get();
+  factor_group_product_translations.get();
+  combined_permutations.get();
 }
 
 /// \brief Construct supercell factor group
@@ -136,5 +204,182 @@ std::vector<sym_info::Permutation> make_factor_group_permutations(
   return factor_group_permutations;
 }
 
+/// \brief Constructor
+///
+/// \param factor_group_permutations Supercell factor group permutations
+/// \param unitcell_index_converter UnitCell and linear unit cell index
+///     conversions in this supercell. Generates translations within the
+///     supercell.
+/// \param unitcellcoord_index_converter UnitCellCoord and linear site index
+///     conversions in this supercell.
+CombinedPermutationTable::CombinedPermutationTable(
+    std::vector<sym_info::Permutation> const &factor_group_permutations,
+    xtal::UnitCellIndexConverter const &unitcell_index_converter,
+    xtal::UnitCellCoordIndexConverter const &unitcellcoord_index_converter)
+    : m_n_factor_group(factor_group_permutations.size()),
+      m_n_translation(unitcell_index_converter.total_sites()),
+      m_n_sites(unitcellcoord_index_converter.total_sites()),
+      m_is_16bit(m_n_sites <= std::numeric_limits<std::uint16_t>::max()) {
+  Index size = m_n_factor_group * m_n_translation * m_n_sites;
+  if (m_is_16bit) {
+    m_data_16bit.resize(size);
+  } else {
+    m_data_32bit.resize(size);
+  }
+
+  // translation permutations are made one at a time, and combined with all
+  // factor group permutations
+  for (Index t = 0; t < m_n_translation; ++t) {
+    sym_info::Permutation trans_perm = make_translation_permutation(
+        t, unitcell_index_converter, unitcellcoord_index_converter);
+    for (Index f = 0; f < m_n_factor_group; ++f) {
+      sym_info::Permutation const &fg_perm = factor_group_permutations[f];
+      Index k = (f * m_n_translation + t) * m_n_sites;
+      for (Index i = 0; i < m_n_sites; ++i, ++k) {
+        if (m_is_16bit) {
+          m_data_16bit[k] = fg_perm[trans_perm[i]];
+        } else {
+          m_data_32bit[k] = fg_perm[trans_perm[i]];
+        }
+      }
+    }
+  }
+}
+
+/// \brief Number of bytes required for a table
+Index CombinedPermutationTable::n_bytes(Index n_factor_group,
+                                        Index n_translation, Index n_sites) {
+  Index width = (n_sites <= std::numeric_limits<std::uint16_t>::max())
+                    ? sizeof(std::uint16_t)
+                    : sizeof(std::uint32_t);
+  return n_factor_group * n_translation * n_sites * width;
+}
+
+/// \brief Copy the permutation of operation (f, t)
+///
+/// \param f Supercell factor group index
+/// \param t Translation index
+/// \param permutation Set to the combined permutation, equal to
+///     `SupercellSymOp(supercell, f, t).combined_permute()`
+void CombinedPermutationTable::copy_permutation(
+    Index f, Index t, sym_info::Permutation &permutation) const {
+  permutation.resize(m_n_sites);
+  Index k = (f * m_n_translation + t) * m_n_sites;
+  for (Index i = 0; i < m_n_sites; ++i, ++k) {
+    permutation[i] = m_is_16bit ? Index(m_data_16bit[k])
+                                : Index(m_data_32bit[k]);
+  }
+}
+
+/// \brief Constructor
+///
+/// \param _factor_group_permutations Supercell factor group permutations.
+///     These are shared, not copied, with the SupercellSymInfo that holds
+///     the cache.
+/// \param _transformation_matrix_to_super Supercell transformation matrix,
+///     used to construct index converters when the table is constructed
+/// \param _n_sublattice Number of prim sublattices
+/// \param _max_n_bytes Maximum size of the table, in bytes
+CombinedPermutationCache::CombinedPermutationCache(
+    std::shared_ptr<std::vector<sym_info::Permutation> const> const
+        &_factor_group_permutations,
+    Eigen::Matrix3l const &_transformation_matrix_to_super,
+    Index _n_sublattice, Index _max_n_bytes)
+    : m_factor_group_permutations(_factor_group_permutations),
+      m_transformation_matrix_to_super(_transformation_matrix_to_super),
+      m_n_sublattice(_n_sublattice),
+      m_table_ptr(nullptr) {
+  Index n_translation = std::abs(_transformation_matrix_to_super.determinant());
+  Index n_sites = n_translation * m_n_sublattice;
+  m_within_budget =
+      n_sites <= std::numeric_limits<std::uint32_t>::max() &&
+      CombinedPermutationTable::n_bytes(m_factor_group_permutations->size(),
+                                        n_translation,
+                                        n_sites) <= _max_n_bytes;
+}
+
+/// \brief Construct the table, once
+CombinedPermutationTable const *CombinedPermutationCache::_construct() const {
+  std::call_once(m_once, [&]() {
+    xtal::UnitCellIndexConverter unitcell_index_converter(
+        m_transformation_matrix_to_super);
+    xtal::UnitCellCoordIndexConverter unitcellcoord_index_converter(
+        m_transformation_matrix_to_super, m_n_sublattice);
+    m_table = std::make_unique<CombinedPermutationTable const>(
+        *m_factor_group_permutations, unitcell_index_converter,
+        unitcellcoord_index_converter);
+    m_table_ptr.store(m_table.get(), std::memory_order_release);
+  });
+  return m_table.get();
+}
+
+/// \brief Construct supercell factor group point matrices
+///
+/// \param head_group_index Prim factor group indices of the supercell factor
+///     group operations
+/// \param unitcellcoord_symgroup_rep Prim factor group representation for
+///     transforming UnitCellCoord
+///
+/// \returns point_matrices, where `point_matrices[f]` transforms lattice
+///     translations, in fractional coordinates with respect to the prim
+///     lattice, by supercell factor group operation f
+std::vector<Eigen::Matrix3l> make_factor_group_point_matrices(
+    std::vector<Index> const &head_group_index,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep) {
+  std::vector<Eigen::Matrix3l> point_matrices;
+  for (Index prim_fg_index : head_group_index) {
+    point_matrices.push_back(
+        unitcellcoord_symgroup_rep[prim_fg_index].point_matrix);
+  }
+  return point_matrices;
+}
+
+/// \brief Construct supercell factor group product translations
+///
+/// \param factor_group Supercell factor group
+/// \param unitcellcoord_symgroup_rep Prim factor group representation for
+///     transforming UnitCellCoord
+///
+/// \returns product_translations, where `product_translations[f1][f2]` is
+///     the lattice translation, L, such that applying f2 and then f1 to any
+///     UnitCellCoord is equal to applying
+///     `f3 = factor_group.multiplication_table[f1][f2]` and then translating
+///     by L.
+///
+/// Method: Applying operation f to `UnitCellCoord(b, n)` gives
+/// `UnitCellCoord(b_f, R_f * n + u_f(b))`, where `b_f` and `u_f(b)` are
+/// obtained from the UnitCellCoordRep. Evaluating both sides at
+/// `UnitCellCoord(0, 0)` gives:
+///
+/// \code
+/// L = R_f1 * u_f2(0) + u_f1(b_f2) - u_f3(0)
+/// \endcode
+///
+/// All values are integers, so no tolerance is required.
+std::vector<std::vector<Eigen::Vector3l>>
+make_factor_group_product_translations(
+    SymGroup const &factor_group,
+    sym_info::UnitCellCoordSymGroupRep const &unitcellcoord_symgroup_rep) {
+  Index n_factor_group = factor_group.element.size();
+  std::vector<std::vector<Eigen::Vector3l>> product_translations(
+      n_factor_group, std::vector<Eigen::Vector3l>(n_factor_group));
+  for (Index f1 = 0; f1 < n_factor_group; ++f1) {
+    UnitCellCoordRep const &rep1 =
+        unitcellcoord_symgroup_rep[factor_group.head_group_index[f1]];
+    for (Index f2 = 0; f2 < n_factor_group; ++f2) {
+      UnitCellCoordRep const &rep2 =
+          unitcellcoord_symgroup_rep[factor_group.head_group_index[f2]];
+      Index f3 = factor_group.multiplication_table[f1][f2];
+      UnitCellCoordRep const &rep3 =
+          unitcellcoord_symgroup_rep[factor_group.head_group_index[f3]];
+      Index b2 = rep2.sublattice_index[0];
+      product_translations[f1][f2] =
+          rep1.point_matrix * rep2.unitcell_indices[0] +
+          rep1.unitcell_indices[b2] - rep3.unitcell_indices[0];
+    }
+  }
+  return product_translations;
+}
+
 }  // namespace config
 }  // namespace CASM
@@ -18,7 +18,11 @@ namespace config {
 SupercellSymOp::SupercellSymOp()
     : m_supercell_factor_group_index(),
       m_translation_index(),
-      m_tmp_translation_index(-1) {}
+      m_tmp_translation_index(-1),
+      m_tmp_translation_frac_index(-1),
+      m_table(nullptr),
+      m_fg_permute(nullptr),
+      m_trans_permute(nullptr) {}
 
 /// Construct SupercellSymOp
 ///
@@ -34,7 +38,10 @@ SupercellSymOp::SupercellSymOp(
       m_supercell_factor_group_index(_supercell_factor_group_index),
       m_translation_index(_translation_index),
       m_N_translation(m_supercell->superlattice.size()),
-      m_tmp_translation_index(-1) {}
+      m_tmp_translation_index(-1),
+      m_tmp_translation_frac_index(-1) {
+  _update_permute_ptrs();
+}
 
 /// Construct SupercellSymOp
 ///
@@ -62,6 +69,23 @@ SupercellSymOp::SupercellSymOp(
           UnitCell::from_cartesian(_translation_cart,
                                    _supercell->superlattice.prim_lattice())) {}
 
+/// Construct SupercellSymOp from a handle
+///
+/// \param _supercell Supercell, must be the supercell referenced by
+///     `_handle`
+/// \param _handle Handle to a supercell operation
+SupercellSymOp::SupercellSymOp(
+    std::shared_ptr<Supercell const> const &_supercell,
+    SupercellSymOpHandle const &_handle)
+    : SupercellSymOp(_supercell, _handle.supercell_factor_group_index,
+                     _handle.translation_index) {
+  if (_handle.supercell != _supercell.get()) {
+    throw std::runtime_error(
+        "Error constructing SupercellSymOp from SupercellSymOpHandle: "
+        "supercell mismatch");
+  }
+}
+
 /// \brief Make supercell symop begin iterator
 SupercellSymOp SupercellSymOp::begin(
     std::shared_ptr<Supercell const> const &_supercell) {
@@ -118,17 +142,74 @@ xtal::UnitCell SupercellSymOp::translation_frac() const {
   return m_supercell->unitcell_index_converter(m_translation_index);
 }
 
+/// \brief Return a non-owning handle to this operation
+///
+/// The handle is only valid while the supercell exists.
+SupercellSymOpHandle SupercellSymOp::handle() const {
+  SupercellSymOpHandle _handle;
+  _handle.supercell = m_supercell.get();
+  _handle.supercell_factor_group_index = m_supercell_factor_group_index;
+  _handle.translation_index = m_translation_index;
+  return _handle;
+}
+
+/// \brief Set this to the operation referenced by a handle, without
+///     changing the supercell
+///
+/// This does not change the supercell reference count or allocate, and
+/// keeps the temporary translation permutation storage, so a single
+/// SupercellSymOp can be re-used to visit many operations in a hot loop.
+///
+/// \throws If `_handle` references a different supercell
+SupercellSymOp &SupercellSymOp::reset(SupercellSymOpHandle const &_handle) {
+  if (_handle.supercell != m_supercell.get()) {
+    throw std::runtime_error(
+        "Error in SupercellSymOp::reset: supercell mismatch");
+  }
+  m_supercell_factor_group_index = _handle.supercell_factor_group_index;
+  m_translation_index = _handle.translation_index;
+  _update_permute_ptrs();
+  return *this;
+}
+
 /// \brief Returns the index of the site containing the site DoF values that
 ///     will be permuted onto site i
 ///
 /// Permutation of configuration site dof values occurs according to:
 ///     after[i] = before[permute_index(i)]
+///
+/// Uses, in order of preference:
+/// - the combined permutation table, if it had been constructed when this
+///   operation was constructed or last changed
+/// - the translation permutation, if held by SupercellSymInfo or already
+///   constructed for the current translation
+/// - direct calculation with the unit cell index converter, which does not
+///   require constructing a translation permutation for large supercells
 Index SupercellSymOp::permute_index(Index i) const {
-  SupercellSymInfo const &sym_info = m_supercell->sym_info;
-  auto const &fg_perm =
-      sym_info.factor_group_permutations[m_supercell_factor_group_index];
-  auto const &trans_perm = this->translation_permute();
-  return fg_perm[trans_perm[i]];
+  if (m_table) {
+    return m_table->permute_index(m_supercell_factor_group_index,
+                                  m_translation_index, i);
+  }
+  if (m_trans_permute) {
+    return m_fg_permute[m_trans_permute[i]];
+  }
+  if (m_tmp_translation_index == m_translation_index) {
+    return m_fg_permute[m_tmp_translation_permute[i]];
+  }
+
+  // No permutation is available for this translation, so the translated site
+  // index is calculated directly: sites are ordered by sublattice and then by
+  // unit cell, so the translation only changes the unit cell index
+  auto const &unitcell_index_converter = m_supercell->unitcell_index_converter;
+  if (m_tmp_translation_frac_index != m_translation_index) {
+    m_tmp_translation_frac_index = m_translation_index;
+    m_tmp_translation_frac = unitcell_index_converter(m_translation_index);
+  }
+  Index n_vol = m_N_translation;
+  Index b = i / n_vol;
+  xtal::UnitCell unitcell_before =
+      unitcell_index_converter(i % n_vol) - m_tmp_translation_frac;
+  return m_fg_permute[b * n_vol + unitcell_index_converter(unitcell_before)];
 }
 
 /// Returns a reference to this -- allows SupercellSymOp to be treated as an
@@ -146,6 +227,7 @@ SupercellSymOp &SupercellSymOp::operator++() {
     m_translation_index = 0;
     m_supercell_factor_group_index++;
   }
+  _update_permute_ptrs();
   return *this;
 }
 
@@ -163,6 +245,7 @@ SupercellSymOp &SupercellSymOp::operator--() {
     m_translation_index = m_N_translation;
   }
   m_translation_index--;
+  _update_permute_ptrs();
   return *this;
 }
 
@@ -200,16 +283,28 @@ SymOp SupercellSymOp::to_symop() const {
 }
 
 /// Returns the translation permutation. Reference not valid after increment.
+///
+/// If the combined permutation table has been constructed, the translation
+/// permutation is copied from it, so that translation_permutations are not
+/// also constructed.
 sym_info::Permutation const &SupercellSymOp::translation_permute() const {
-  if (m_supercell->sym_info.translation_permutations.has_value()) {
-    return (
-        *m_supercell->sym_info.translation_permutations)[m_translation_index];
+  SupercellSymInfo const &sym_info = m_supercell->sym_info;
+  CombinedPermutationTable const *table =
+      sym_info.combined_permutations->get_if_constructed();
+  if (!table && sym_info.translation_permutations.has_value()) {
+    return (*sym_info.translation_permutations)[m_translation_index];
   }
   if (m_tmp_translation_index != m_translation_index) {
     m_tmp_translation_index = m_translation_index;
-    m_tmp_translation_permute = make_translation_permutation(
-        m_tmp_translation_index, this->m_supercell->unitcell_index_converter,
-        this->m_supercell->unitcellcoord_index_converter);
+    if (table) {
+      // the identity is the first supercell factor group operation
+      table->copy_permutation(0, m_tmp_translation_index,
+                              m_tmp_translation_permute);
+    } else {
+      m_tmp_translation_permute = make_translation_permutation(
+          m_tmp_translation_index, this->m_supercell->unitcell_index_converter,
+          this->m_supercell->unitcellcoord_index_converter);
+    }
   }
   return m_tmp_translation_permute;
 }
@@ -217,84 +312,79 @@ sym_info::Permutation const &SupercellSymOp::translation_permute() const {
 /// Returns the combination of factor group operation permutation and
 /// translation permutation
 sym_info::Permutation SupercellSymOp::combined_permute() const {
+  sym_info::Permutation permutation;
+  combined_permute(permutation);
+  return permutation;
+}
+
+/// Sets `permutation` to the combination of factor group operation
+/// permutation and translation permutation, re-using its storage
+void SupercellSymOp::combined_permute(
+    sym_info::Permutation &permutation) const {
   SupercellSymInfo const &sym_info = m_supercell->sym_info;
+  if (CombinedPermutationTable const *table =
+          sym_info.combined_permutations->get_if_constructed()) {
+    table->copy_permutation(m_supercell_factor_group_index,
+                            m_translation_index, permutation);
+    return;
+  }
   auto const &fg_permute =
       sym_info.factor_group_permutations[m_supercell_factor_group_index];
   auto const &trans_permute = translation_permute();
-  return CASM::sym_info::combined_permute(fg_permute,      // first
-                                          trans_permute);  // second
+  // equivalent to sym_info::combined_permute(fg_permute, trans_permute)
+  permutation.resize(trans_permute.size());
+  for (Index i = 0; i < trans_permute.size(); ++i) {
+    permutation[i] = fg_permute[trans_permute[i]];
+  }
 }
 
 /// \brief Returns the inverse supercell operation
+///
+/// Uses only integer arithmetic: the inverse, (f', t'), of (f, t) satisfies
+/// `(f', t') * (f, t) == (0, 0)`, so the inverse translation is
+/// `-(L[f'][f] + R_f' * n_t)`, where L is
+/// `sym_info.factor_group_product_translations`, R is
+/// `sym_info.factor_group_point_matrices`, and n_t is the translation of
+/// *this.
 SupercellSymOp SupercellSymOp::inverse() const {
-  // Copy *this, then update m_supercell_factor_group_index and
-  // m_translation_index
-  SupercellSymOp inverse_op(*this);
-
-  // Finding the inverse factor_group operation is straightforward
-  SymGroup const &supercell_factor_group =
-      *this->m_supercell->sym_info.factor_group;
-  Index inverse_fg_index =
-      supercell_factor_group
-          .inverse_index[this->m_supercell_factor_group_index];
-  inverse_op.m_supercell_factor_group_index = inverse_fg_index;
-
-  // New translation can be found comparing the translation for the inverse of
-  // the "total sym_op" of *this to the inverse of the untranslated sym_op
-
-  // Find the translation (cartesian coordinates)
-  SymOp const &inverse_sym_op = CASM::config::inverse(this->to_symop());
-  SymOp const &inverse_fg_op = supercell_factor_group.element[inverse_fg_index];
-  Eigen::Vector3d translation_cart =
-      (inverse_sym_op.translation - inverse_fg_op.translation);
-
-  // convert to fractional coordinates
-  Superlattice const &superlattice = this->m_supercell->superlattice;
-  UnitCell translation_uc =
-      UnitCell::from_cartesian(translation_cart, superlattice.prim_lattice());
+  SupercellSymInfo const &sym_info = m_supercell->sym_info;
+  Index f = m_supercell_factor_group_index;
+  Index inverse_fg_index = sym_info.factor_group->inverse_index[f];
 
-  // convert to linear index
-  inverse_op.m_translation_index =
-      m_supercell->unitcell_index_converter(translation_uc);
+  auto const &converter = m_supercell->unitcell_index_converter;
+  Eigen::Vector3l translation_frac =
+      -(sym_info.factor_group_product_translations[inverse_fg_index][f] +
+        sym_info.factor_group_point_matrices[inverse_fg_index] *
+            converter(m_translation_index));
 
-  return inverse_op;
+  return SupercellSymOp(m_supercell, inverse_fg_index,
+                        converter(UnitCell(translation_frac)));
 }
 
 /// \brief Returns the supercell operation equivalent to applying first RHS
 /// and then *this
+///
+/// Uses only integer arithmetic: the product of (f1, t1) and (f2, t2) is
+/// (f3, t3), where `f3 = factor_group->multiplication_table[f1][f2]` and the
+/// translation is `L[f1][f2] + R_f1 * n_t2 + n_t1`, where L is
+/// `sym_info.factor_group_product_translations` and R is
+/// `sym_info.factor_group_point_matrices`.
 SupercellSymOp SupercellSymOp::operator*(SupercellSymOp const &RHS) const {
-  // Copy *this, then update m_supercell_factor_group_index and
-  // m_translation_index
-  SupercellSymOp product_op(*this);
-
-  // Finding the factor_group product is straightforward
-  SymGroup const &supercell_factor_group =
-      *this->m_supercell->sym_info.factor_group;
-  product_op.m_supercell_factor_group_index =
-      supercell_factor_group
-          .multiplication_table[this->m_supercell_factor_group_index]
-                               [RHS.m_supercell_factor_group_index];
-
-  // New translation can be found comparing the translation for the product of
-  // the "total sym_op" to the just the product factor group op translation
-
-  // Find the translation (cartesian coordinates)
-  SymOp total_product_op = this->to_symop() * RHS.to_symop();
-  SymOp const &product_fg_op =
-      supercell_factor_group.element[product_op.m_supercell_factor_group_index];
-  Eigen::Vector3d translation_cart =
-      total_product_op.translation - product_fg_op.translation;
-
-  // convert to fractional coordinates
-  Superlattice const &superlattice = this->m_supercell->superlattice;
-  UnitCell translation_uc =
-      UnitCell::from_cartesian(translation_cart, superlattice.prim_lattice());
-
-  // convert to linear index
-  product_op.m_translation_index =
-      m_supercell->unitcell_index_converter(translation_uc);
-
-  return product_op;
+  SupercellSymInfo const &sym_info = m_supercell->sym_info;
+  Index f1 = m_supercell_factor_group_index;
+  Index f2 = RHS.m_supercell_factor_group_index;
+  Index product_fg_index =
+      sym_info.factor_group->multiplication_table[f1][f2];
+
+  auto const &converter = m_supercell->unitcell_index_converter;
+  Eigen::Vector3l translation_frac =
+      sym_info.factor_group_product_translations[f1][f2] +
+      sym_info.factor_group_point_matrices[f1] *
+          converter(RHS.m_translation_index) +
+      converter(m_translation_index);
+
+  return SupercellSymOp(m_supercell, product_fg_index,
+                        converter(UnitCell(translation_frac)));
 }
 
 /// \brief Less than comparison (used to implement operator<() and other
@@ -318,6 +408,29 @@ bool SupercellSymOp::eq_impl(SupercellSymOp const &RHS) const {
   return false;
 }
 
+/// \brief Update the cached permutation pointers for the current operation
+///
+/// If the combined permutation table has been constructed, only it is used.
+/// Otherwise, the factor group permutation and, if held by SupercellSymInfo,
+/// the translation permutation are used.
+void SupercellSymOp::_update_permute_ptrs() {
+  SupercellSymInfo const &sym_info = m_supercell->sym_info;
+  m_table = sym_info.combined_permutations->get_if_constructed();
+  m_fg_permute = nullptr;
+  m_trans_permute = nullptr;
+  if (m_table) {
+    return;
+  }
+  auto const &fg_permutations = sym_info.factor_group_permutations.get();
+  if (m_supercell_factor_group_index < fg_permutations.size()) {
+    m_fg_permute = fg_permutations[m_supercell_factor_group_index].data();
+  }
+  auto const &trans_permutations = sym_info.translation_permutations.get();
+  if (trans_permutations.has_value()) {
+    m_trans_permute = (*trans_permutations)[m_translation_index].data();
+  }
+}
+
 /// \brief Return inverse SymOp
 SymOp inverse(SymOp const &op) {
   // x' = R * x + T
@@ -0,0 +1,133 @@
+#include "casm/configuration/ThreadPool.hh"
+
+#include <algorithm>
+#include <exception>
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param _n_threads Number of worker threads. If <= 0, uses
+///     `std::thread::hardware_concurrency()` (or 1 if that is not available).
+ThreadPool::ThreadPool(Index _n_threads) : m_stop(false) {
+  if (_n_threads <= 0) {
+    _n_threads = std::thread::hardware_concurrency();
+  }
+  if (_n_threads <= 0) {
+    _n_threads = 1;
+  }
+  for (Index i = 0; i < _n_threads; ++i) {
+    m_threads.emplace_back([this]() { this->_work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+/// \brief Number of worker threads
+Index ThreadPool::size() const { return m_threads.size(); }
+
+/// \brief Partition [0, n) into contiguous blocks and call f(begin, end)
+///     for each block, in parallel
+///
+/// \param n Size of the range to partition
+/// \param f Function called as `f(begin, end)` for each block
+/// \param n_blocks Number of blocks. If < 0, uses `4 * size()` blocks, for
+///     load balancing. At most `n` blocks are used.
+///
+/// Blocks are contiguous and ordered, so results stored by block index can
+/// be reduced in order to obtain results independent of the number of
+/// threads.
+void ThreadPool::parallel_for(Index n, std::function<void(Index, Index)> f,
+                              Index n_blocks) {
+  if (n_blocks < 0) {
+    n_blocks = 4 * size();
+  }
+  std::vector<std::pair<Index, Index>> blocks = make_blocks(n, n_blocks);
+  if (blocks.empty()) {
+    return;
+  }
+
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+  Index n_remaining = blocks.size();
+  std::exception_ptr error;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto const &block : blocks) {
+      m_tasks.emplace_back([&, block]() {
+        try {
+          f(block.first, block.second);
+        } catch (...) {
+          std::lock_guard<std::mutex> done_lock(done_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+        std::lock_guard<std::mutex> done_lock(done_mutex);
+        if (--n_remaining == 0) {
+          done_cv.notify_all();
+        }
+      });
+    }
+  }
+  m_cv.notify_all();
+
+  std::unique_lock<std::mutex> done_lock(done_mutex);
+  done_cv.wait(done_lock, [&]() { return n_remaining == 0; });
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::_work() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+      if (m_stop && m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+  }
+}
+
+/// \brief Partition [0, n) into `n_blocks` contiguous blocks
+///
+/// \returns Blocks, as pairs of `[begin, end)`, in order. Block sizes differ
+///     by at most one. Empty blocks are not included.
+std::vector<std::pair<Index, Index>> make_blocks(Index n, Index n_blocks) {
+  std::vector<std::pair<Index, Index>> blocks;
+  if (n <= 0) {
+    return blocks;
+  }
+  if (n_blocks <= 0 || n_blocks > n) {
+    n_blocks = std::min(n, std::max(n_blocks, Index(1)));
+  }
+  Index base = n / n_blocks;
+  Index extra = n % n_blocks;
+  Index begin = 0;
+  for (Index i = 0; i < n_blocks; ++i) {
+    Index end = begin + base + (i < extra ? 1 : 0);
+    blocks.emplace_back(begin, end);
+    begin = end;
+  }
+  return blocks;
+}
+
+}  // namespace config
+}  // namespace CASM
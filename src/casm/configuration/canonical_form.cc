@@ -1,14 +1,218 @@
 #include "casm/configuration/canonical_form.hh"
 
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+#include "casm/configuration/ConfigCompare.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_search.hh"
+#include "casm/configuration/hermite_normal_form.hh"
+#include "casm/configuration/translation_search.hh"
 #include "casm/crystallography/CanonicalForm.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
 
 namespace CASM {
 namespace config {
 
+namespace {
+
+/// \brief Return the Hermite normal form of an integer transformation matrix
+Eigen::Matrix3l make_hnf(Eigen::Matrix3l const &T) {
+  return hermite_normal_form(T.cast<int>()).first.cast<long>();
+}
+
+struct HermiteNormalFormLess {
+  bool operator()(Eigen::Matrix3l const &A, Eigen::Matrix3l const &B) const {
+    return hermite_normal_form_less(A, B);
+  }
+};
+
+/// \brief Process-wide, thread-safe cache of per-prim data used by
+///     `canonical_supercell_search`
+///
+/// For each prim, holds the prim point group as integer fractional matrices
+/// and the canonical transformation matrix of each orbit of equivalent
+/// supercells that has been searched, keyed by the greatest HNF in the
+/// orbit. The canonical lattice is found with `xtal::canonical::equivalent`
+/// once per orbit; all other work is exact integer arithmetic.
+///
+/// Each thread keeps the most recently used PrimData, so the registry mutex
+/// is only locked the first time a thread uses a prim. Orbits are read under
+/// a shared lock, and only adding an orbit takes an exclusive lock.
+class CanonicalSupercellCache {
+ public:
+  struct PrimData {
+    std::weak_ptr<Prim const> prim;
+    std::vector<Eigen::Matrix3l> point_matrices;
+    std::shared_mutex mutex;
+    std::map<Eigen::Matrix3l, Eigen::Matrix3l, HermiteNormalFormLess>
+        canonical;
+  };
+
+  std::shared_ptr<PrimData> get(std::shared_ptr<Prim const> const &prim) {
+    thread_local std::shared_ptr<PrimData> last;
+    if (last != nullptr && last->prim.lock() == prim) {
+      return last;
+    }
+    last = _get(prim);
+    return last;
+  }
+
+ private:
+  std::shared_ptr<PrimData> _get(std::shared_ptr<Prim const> const &prim) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_data.find(prim.get());
+    if (it != m_data.end() && it->second->prim.lock() == prim) {
+      return it->second;
+    }
+
+    // erase data for prim that no longer exist
+    for (auto it = m_data.begin(); it != m_data.end();) {
+      if (it->second->prim.expired()) {
+        it = m_data.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    auto data = std::make_shared<PrimData>();
+    data->prim = prim;
+    data->point_matrices = make_fractional_point_matrices(
+        prim->basicstructure->lattice(), prim->sym_info.point_group->element);
+    m_data[prim.get()] = data;
+    return data;
+  }
+
+  std::mutex m_mutex;
+  std::map<Prim const *, std::shared_ptr<PrimData>> m_data;
+};
+
+CanonicalSupercellCache &canonical_supercell_cache() {
+  static CanonicalSupercellCache cache;
+  return cache;
+}
+
+/// \brief Return the canonical transformation matrix of an orbit of
+///     equivalent supercells, finding it if not yet cached
+///
+/// \param data Per-prim cache data
+/// \param prim The prim
+/// \param H_max The greatest HNF in the orbit, which is used both as the key
+///     and as the representative passed to `xtal::canonical::equivalent`, so
+///     that the result does not depend on which supercell in the orbit is
+///     searched first
+Eigen::Matrix3l find_canonical_transformation_matrix(
+    CanonicalSupercellCache::PrimData &data,
+    std::shared_ptr<Prim const> const &prim, Eigen::Matrix3l const &H_max) {
+  {
+    std::shared_lock<std::shared_mutex> lock(data.mutex);
+    auto it = data.canonical.find(H_max);
+    if (it != data.canonical.end()) {
+      return it->second;
+    }
+  }
+  Lattice const &prim_lattice = prim->basicstructure->lattice();
+  Lattice superlattice(prim_lattice.lat_column_mat() * H_max.cast<double>(),
+                       prim_lattice.tol());
+  Lattice canonical_lattice = xtal::canonical::equivalent(
+      superlattice, prim->sym_info.point_group->element, superlattice.tol());
+  Eigen::Matrix3l T_canonical =
+      xtal::Superlattice(prim_lattice, canonical_lattice)
+          .transformation_matrix_to_super();
+  std::unique_lock<std::shared_mutex> lock(data.mutex);
+  return data.canonical.emplace(H_max, T_canonical).first->second;
+}
+
+}  // namespace
+
+/// \brief Find the canonical supercell, the operations to and from it, and
+///     the invariant subgroup in a single search using integer arithmetic
+///
+/// The supercell transformation matrix, T, is transformed by each prim point
+/// group operation as integer fractional matrices, `R * T`, reduced to
+/// Hermite normal form (HNF) and compared exactly. Two transformation
+/// matrices generate the same superlattice if and only if they have the same
+/// HNF.
+///
+/// The canonical supercell is the same as found by
+/// `xtal::canonical::equivalent`. It is found once per prim and orbit of
+/// equivalent supercells and then re-used.
+///
+/// Notes:
+/// - `to_canonical_index` is the first point group operation for which
+///   `R * T` generates the canonical superlattice
+/// - `from_canonical_index` is the inverse of `to_canonical_index`, so
+///   `R * T_canonical` generates the supercell superlattice
+SupercellCanonicalSearchResult canonical_supercell_search(
+    Supercell const &supercell) {
+  return canonical_supercell_search(
+      supercell.prim, supercell.superlattice.transformation_matrix_to_super());
+}
+
+/// \brief Find the canonical supercell, the operations to and from it, and
+///     the invariant subgroup in a single search using integer arithmetic
+///
+/// Same as `canonical_supercell_search(Supercell const &)`, without
+/// requiring a Supercell to be constructed.
+///
+/// \param prim The prim
+/// \param T The supercell transformation matrix
+SupercellCanonicalSearchResult canonical_supercell_search(
+    std::shared_ptr<Prim const> const &prim, Eigen::Matrix3l const &T) {
+  std::shared_ptr<CanonicalSupercellCache::PrimData> data =
+      canonical_supercell_cache().get(prim);
+  std::vector<Eigen::Matrix3l> const &point_matrices = data->point_matrices;
+
+  SupercellCanonicalSearchResult result;
+
+  // HNF of equivalent superlattices
+  Eigen::Matrix3l H = make_hnf(T);
+  std::vector<Eigen::Matrix3l> equivalent_hnf;
+  equivalent_hnf.reserve(point_matrices.size());
+  Eigen::Matrix3l H_max = H;
+  for (Index i = 0; i < point_matrices.size(); ++i) {
+    equivalent_hnf.push_back(make_hnf(point_matrices[i] * T));
+    if (equivalent_hnf.back() == H) {
+      result.invariant_subgroup_indices.push_back(i);
+    }
+    if (hermite_normal_form_less(H_max, equivalent_hnf.back())) {
+      H_max = equivalent_hnf.back();
+    }
+  }
+
+  // canonical transformation matrix, found once per orbit
+  result.canonical_transformation_matrix =
+      find_canonical_transformation_matrix(*data, prim, H_max);
+  Eigen::Matrix3l const &T_canonical = result.canonical_transformation_matrix;
+  result.is_canonical = (T == T_canonical);
+
+  // operations to and from the canonical superlattice
+  Eigen::Matrix3l H_canonical = make_hnf(T_canonical);
+  result.to_canonical_index = -1;
+  for (Index i = 0; i < point_matrices.size(); ++i) {
+    if (equivalent_hnf[i] == H_canonical) {
+      result.to_canonical_index = i;
+      break;
+    }
+  }
+  if (result.to_canonical_index == -1) {
+    throw std::runtime_error(
+        "Error in canonical_supercell_search: canonical supercell is not "
+        "equivalent");
+  }
+  result.from_canonical_index =
+      prim->sym_info.point_group->inv(result.to_canonical_index);
+  return result;
+}
+
 /// \brief Return true if supercell lattice is in canonical form
+///
+/// Equivalent to `canonical_supercell_search(supercell).is_canonical`.
 bool is_canonical(Supercell const &supercell) {
-  return xtal::canonical::check(supercell.superlattice.superlattice(),
-                                supercell.prim->sym_info.point_group->element);
+  return canonical_supercell_search(supercell).is_canonical;
 }
 
 /// \brief Return a shared supercell that compares greater to all equivalents
@@ -18,50 +222,39 @@ bool is_canonical(Supercell const &supercell) {
 /// `supercell.prim->sym_info.point_group->element`:
 ///     canonical_supercell->superlattice.superlattice() >=
 ///         sym::copy_apply(op, supercell.superlattice.superlattice())
+///
+/// Uses `canonical_supercell_search`.
 std::shared_ptr<Supercell const> make_canonical_form(
     Supercell const &supercell) {
-  Lattice canonical_lattice =
-      xtal::canonical::equivalent(supercell.superlattice.superlattice(),
-                                  supercell.prim->sym_info.point_group->element,
-                                  supercell.superlattice.superlattice().tol());
-  return std::make_shared<Supercell const>(
-      supercell.prim, xtal::Superlattice(supercell.superlattice.prim_lattice(),
-                                         canonical_lattice));
+  return make_shared_supercell(
+      supercell.prim,
+      canonical_supercell_search(supercell).canonical_transformation_matrix);
 }
 
 /// \brief Return SymOp that makes a supercell lattice canonical
 ///
 /// The result, `op`, is the first in
-/// `supercell.prim->sym_info.point_group->element` that satisfies:
-///     canonical_supercell->superlattice.superlattice() ==
-///         copy_apply(op, supercell.superlattice.superlattice())
+/// `supercell.prim->sym_info.point_group->element` for which
+/// `copy_apply(op, supercell.superlattice.superlattice())` generates the
+/// same superlattice as the canonical supercell lattice.
+///
+/// Uses `canonical_supercell_search`.
 SymOp to_canonical(Supercell const &supercell) {
-  auto to_canonical_ix = xtal::canonical::operation_index(
-      supercell.superlattice.superlattice(),
-      supercell.prim->sym_info.point_group->element);
-  return supercell.prim->sym_info.point_group->element[to_canonical_ix];
+  return supercell.prim->sym_info.point_group
+      ->element[canonical_supercell_search(supercell).to_canonical_index];
 }
 
 /// \brief Return op that makes a supercell lattice from the canonical
 ///     supercell lattice
 ///
-/// The result, `op`, is the first in
-/// `supercell.prim->sym_info.point_group->element` that satisfies:
-///     supercell.superlattice.superlattice() ==
-///         copy_apply(op, canonical_supercell->superlattice.superlattice())
+/// The result, `op`, is the inverse of `to_canonical(supercell)`, so
+/// `copy_apply(op, canonical_supercell->superlattice.superlattice())`
+/// generates the same superlattice as `supercell.superlattice.superlattice()`.
+///
+/// Uses `canonical_supercell_search`.
 SymOp from_canonical(Supercell const &supercell) {
-  Lattice const &lhs = supercell.superlattice.superlattice();
-  Lattice canonical =
-      xtal::canonical::equivalent(supercell.superlattice.superlattice(),
-                                  supercell.prim->sym_info.point_group->element,
-                                  supercell.superlattice.superlattice().tol());
-  for (auto const &op : supercell.prim->sym_info.point_group->element) {
-    if (lhs == sym::copy_apply(op, canonical)) {
-      return op;
-    }
-  }
-  throw std::runtime_error(
-      "Error in CASM::config::from_canonical(Supercell const &): Not found");
+  return supercell.prim->sym_info.point_group
+      ->element[canonical_supercell_search(supercell).from_canonical_index];
 }
 
 /// \brief Return the supercell with distinct symmetrically equivalent lattices
@@ -97,12 +290,63 @@ std::vector<std::shared_ptr<Supercell const>> make_equivalents(
   // make as shared Supercell
   std::vector<std::shared_ptr<Supercell const>> result;
   for (Lattice const &superlat : superlats) {
-    result.push_back(std::make_shared<Supercell const>(prim, superlat));
+    result.push_back(make_shared_supercell(prim, superlat));
   }
 
   return result;
 }
 
+/// \brief Return true if configuration is in canonical form, using all
+///     operations consistent with its supercell
+///
+/// Equivalent to:
+/// \code
+/// is_canonical(configuration,
+///              SupercellSymOp::begin(configuration.supercell),
+///              SupercellSymOp::end(configuration.supercell));
+/// \endcode
+bool is_canonical(Configuration const &configuration) {
+  ConfigCompare compare_f(configuration);
+  return !compare_f(to_canonical(configuration));
+}
+
+/// \brief Return the configuration that compares greater to all equivalents in
+///     the same supercell, using all operations consistent with its supercell
+///
+/// Equivalent to:
+/// \code
+/// make_canonical_form(configuration,
+///                     SupercellSymOp::begin(configuration.supercell),
+///                     SupercellSymOp::end(configuration.supercell));
+/// \endcode
+Configuration make_canonical_form(Configuration const &configuration) {
+  return copy_apply(to_canonical(configuration), configuration);
+}
+
+/// \brief Return rep that makes a configuration canonical, using all
+///     operations consistent with its supercell
+///
+/// Equivalent to:
+/// \code
+/// to_canonical(configuration,
+///              SupercellSymOp::begin(configuration.supercell),
+///              SupercellSymOp::end(configuration.supercell));
+/// \endcode
+///
+/// Rather than comparing all factor group x translation operations, for each
+/// factor group operation the translations which give the greatest
+/// occupation are found directly with `find_max_translations`. Only those
+/// candidates are then compared with ConfigCompare, which also accounts for
+/// global and local continuous DoF. The result is the first (lowest index)
+/// operation that makes the configuration canonical, the same as the
+/// `std::max_element` based version.
+SupercellSymOp to_canonical(Configuration const &configuration) {
+  TranslationArithmetic arithmetic(
+      configuration.supercell->unitcell_index_converter);
+  return to_canonical(std::vector<Configuration const *>({&configuration}),
+                      arithmetic)[0];
+}
+
 /// \brief Return true if the operation does not mix given sites and other sites
 bool site_indices_are_invariant(SupercellSymOp const &op,
                                 std::set<Index> const &site_indices) {
@@ -0,0 +1,605 @@
+#include "casm/configuration/canonical_search.hh"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <set>
+
+#include "casm/clexulator/ConfigDoFValuesTools.hh"
+#include "casm/configuration/ConfigCompare.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/ThreadPool.hh"
+#include "casm/configuration/translation_search.hh"
+
+namespace CASM {
+namespace config {
+
+CanonicalFormSearchResult::CanonicalFormSearchResult(
+    Configuration const &_canonical_configuration,
+    SupercellSymOp const &_to_canonical,
+    std::vector<SupercellSymOp> const &_invariant_subgroup)
+    : canonical_configuration(_canonical_configuration),
+      to_canonical(_to_canonical),
+      invariant_subgroup(_invariant_subgroup) {}
+
+namespace {
+
+/// \brief Implements canonical_form_search
+///
+/// Two sets of candidate operations are maintained, as indices into `ops`:
+/// - `m_max`: operations that may still give the greatest configuration
+/// - `m_stab`: operations that may still leave the configuration invariant
+///
+/// DoF values are visited in the same order as ConfigIsEquivalent (global
+/// DoF, occupation, local DoF), and candidates are removed from each set as
+/// soon as they lose. Each stage is skipped once both sets are resolved.
+class CanonicalFormSearch {
+ public:
+  CanonicalFormSearch(Configuration const &_configuration,
+                      std::vector<SupercellSymOp> const &_ops)
+      : m_configuration(_configuration),
+        m_dof_values(_configuration.dof_values),
+        m_supercell(*_configuration.supercell),
+        m_ops(_ops),
+        m_arithmetic(m_supercell.unitcell_index_converter),
+        m_tol(m_supercell.prim->basicstructure->lattice().tol()),
+        m_n_vol(m_supercell.superlattice.size()),
+        m_n_sublat(m_supercell.prim->basicstructure->basis().size()),
+        m_n_fg(m_supercell.sym_info.factor_group_permutations.size()),
+        m_occupation(m_n_fg),
+        m_global(m_n_fg),
+        m_local(m_n_fg) {
+    if (m_ops.empty()) {
+      throw std::runtime_error(
+          "Error in canonical_form_search: no operations to search");
+    }
+    for (Index k = 0; k < m_ops.size(); ++k) {
+      m_max.push_back(k);
+      m_stab.push_back(k);
+    }
+  }
+
+  CanonicalFormSearchResult run() {
+    _search_global();
+    _search_occupation();
+    _search_local();
+
+    // resolve remaining ties (only possible within tolerance, or if the
+    // operations are not distinct) with the standard comparison
+    ConfigCompare compare_f(m_configuration);
+    Index best = m_max[0];
+    for (Index k : m_max) {
+      if (compare_f(m_ops[best], m_ops[k])) {
+        best = k;
+      }
+    }
+
+    std::vector<SupercellSymOp> invariant_subgroup;
+    for (Index k : m_stab) {
+      invariant_subgroup.push_back(m_ops[k]);
+    }
+    return CanonicalFormSearchResult(copy_apply(m_ops[best], m_configuration),
+                                     m_ops[best], invariant_subgroup);
+  }
+
+ private:
+  bool _max_resolved() const { return m_max.size() <= 1; }
+
+  bool _stab_resolved() const {
+    if (m_stab.empty()) {
+      return true;
+    }
+    if (m_stab.size() == 1) {
+      SupercellSymOp const &op = m_ops[m_stab[0]];
+      return op.supercell_factor_group_index() == 0 &&
+             op.translation_index() == 0;
+    }
+    return false;
+  }
+
+  bool _resolved() const { return _max_resolved() && _stab_resolved(); }
+
+  Index _fg(Index k) const { return m_ops[k].supercell_factor_group_index(); }
+
+  /// \brief Index into factor group transformed values which is permuted
+  ///     onto site `l` by the translation of candidate `k`
+  Index _translate(Index k, Index l) const {
+    Index t = m_ops[k].translation_index();
+    if (m_supercell.sym_info.translation_permutations.has_value()) {
+      return (*m_supercell.sym_info.translation_permutations)[t][l];
+    }
+    return m_arithmetic.permute_index(l, t);
+  }
+
+  /// \brief Occupation after the factor group operation only
+  Eigen::VectorXi const &_occupation(Index f) {
+    if (!m_occupation[f].has_value()) {
+      m_occupation[f] =
+          make_factor_group_occupation(m_dof_values.occupation, m_supercell, f);
+    }
+    return *m_occupation[f];
+  }
+
+  /// \brief Global DoF values after the factor group operation
+  std::map<DoFKey, Eigen::VectorXd> const &_global(Index f) {
+    if (!m_global[f].has_value()) {
+      PrimSymInfo const &prim_sym_info = m_supercell.prim->sym_info;
+      Index prim_fg_index =
+          m_supercell.sym_info.factor_group->head_group_index[f];
+      std::map<DoFKey, Eigen::VectorXd> values;
+      for (auto const &dof : m_dof_values.global_dof_values) {
+        Eigen::MatrixXd const &M =
+            prim_sym_info.global_dof_symgroup_rep.at(dof.first)[prim_fg_index];
+        values.emplace(dof.first, M * dof.second);
+      }
+      m_global[f] = std::move(values);
+    }
+    return *m_global[f];
+  }
+
+  /// \brief Local DoF values after the factor group operation only
+  ///
+  /// Values are transformed on the initial sites, then permuted by the
+  /// factor group permutation, as in `apply`.
+  std::map<DoFKey, Eigen::MatrixXd> const &_local(Index f) {
+    using clexulator::sublattice_block;
+    if (!m_local[f].has_value()) {
+      PrimSymInfo const &prim_sym_info = m_supercell.prim->sym_info;
+      Index prim_fg_index =
+          m_supercell.sym_info.factor_group->head_group_index[f];
+      sym_info::Permutation const &factor_group_permute =
+          m_supercell.sym_info.factor_group_permutations[f];
+      std::map<DoFKey, Eigen::MatrixXd> values;
+      for (auto const &dof : m_dof_values.local_dof_values) {
+        sym_info::LocalDoFSymOpRep const &local_dof_symop_rep =
+            prim_sym_info.local_dof_symgroup_rep.at(dof.first)[prim_fg_index];
+        Eigen::MatrixXd const &init_value = dof.second;
+        Eigen::MatrixXd tmp{init_value};
+        for (Index b = 0; b < m_n_sublat; ++b) {
+          Eigen::MatrixXd const &M = local_dof_symop_rep[b];
+          Index dim = M.cols();
+          if (dim == 0) continue;
+          sublattice_block(tmp, b, m_n_vol).topRows(dim) =
+              M * sublattice_block(init_value, b, m_n_vol).topRows(dim);
+        }
+        Eigen::MatrixXd &permuted = values[dof.first];
+        permuted.resize(tmp.rows(), tmp.cols());
+        for (Index l = 0; l < tmp.cols(); ++l) {
+          permuted.col(l) = tmp.col(factor_group_permute[l]);
+        }
+      }
+      m_local[f] = std::move(values);
+    }
+    return *m_local[f];
+  }
+
+  /// \brief Keep candidates in `m_max` with value within tolerance of the
+  ///     maximum
+  template <typename ValueF>
+  void _prune_max(ValueF value_f, double tol) {
+    if (_max_resolved()) {
+      return;
+    }
+    m_values.resize(m_max.size());
+    double max_value = value_f(m_max[0]);
+    for (Index i = 0; i < m_max.size(); ++i) {
+      m_values[i] = value_f(m_max[i]);
+      max_value = std::max(max_value, m_values[i]);
+    }
+    Index j = 0;
+    for (Index i = 0; i < m_max.size(); ++i) {
+      if (!(m_values[i] < max_value - tol)) {
+        m_max[j++] = m_max[i];
+      }
+    }
+    m_max.resize(j);
+  }
+
+  /// \brief Keep candidates in `m_stab` with value within tolerance of the
+  ///     initial value
+  template <typename ValueF>
+  void _prune_stab(ValueF value_f, double init_value, double tol) {
+    if (_stab_resolved()) {
+      return;
+    }
+    auto end = std::remove_if(m_stab.begin(), m_stab.end(), [&](Index k) {
+      double value = value_f(k);
+      return value < init_value - tol || value > init_value + tol;
+    });
+    m_stab.erase(end, m_stab.end());
+  }
+
+  void _search_global() {
+    for (auto const &dof : m_dof_values.global_dof_values) {
+      DoFKey const &key = dof.first;
+      for (Index i = 0; i < dof.second.size(); ++i) {
+        if (_resolved()) {
+          return;
+        }
+        auto value_f = [&](Index k) { return _global(_fg(k)).at(key)[i]; };
+        _prune_max(value_f, m_tol);
+        _prune_stab(value_f, dof.second[i], m_tol);
+      }
+    }
+  }
+
+  void _search_occupation() {
+    Eigen::VectorXi const &occupation = m_dof_values.occupation;
+    if (!m_supercell.prim->sym_info.has_occupation_dofs ||
+        !occupation.size()) {
+      return;
+    }
+    _search_occupation_max();
+    _search_occupation_stab();
+  }
+
+  /// \brief For each factor group operation, keep the translations that give
+  ///     the greatest occupation, then keep the factor group operations that
+  ///     give the greatest occupation
+  void _search_occupation_max() {
+    if (_max_resolved()) {
+      return;
+    }
+
+    // group candidates by factor group operation
+    std::map<Index, std::vector<Index>> by_fg;
+    for (Index k : m_max) {
+      by_fg[_fg(k)].push_back(k);
+    }
+
+    // best translations for each factor group operation
+    for (auto &pair : by_fg) {
+      std::vector<Index> &candidates = pair.second;
+      std::vector<Index> translations;
+      for (Index k : candidates) {
+        translations.push_back(m_ops[k].translation_index());
+      }
+      translations = find_max_translations(_occupation(pair.first),
+                                           m_arithmetic, translations);
+      std::set<Index> keep(translations.begin(), translations.end());
+      auto end =
+          std::remove_if(candidates.begin(), candidates.end(), [&](Index k) {
+            return !keep.count(m_ops[k].translation_index());
+          });
+      candidates.erase(end, candidates.end());
+    }
+
+    // best factor group operations, comparing one representative each
+    Index n_sites = m_dof_values.occupation.size();
+    auto compare = [&](Index k1, Index k2) {
+      Eigen::VectorXi const &w1 = _occupation(_fg(k1));
+      Eigen::VectorXi const &w2 = _occupation(_fg(k2));
+      for (Index l = 0; l < n_sites; ++l) {
+        int v1 = w1[_translate(k1, l)];
+        int v2 = w2[_translate(k2, l)];
+        if (v1 != v2) {
+          return v1 < v2 ? -1 : 1;
+        }
+      }
+      return 0;
+    };
+    std::vector<Index> best_fg;
+    for (auto const &pair : by_fg) {
+      int c = best_fg.empty()
+                  ? 1
+                  : compare(pair.second[0], by_fg[best_fg[0]][0]);
+      if (c > 0) {
+        best_fg.clear();
+        best_fg.push_back(pair.first);
+      } else if (c == 0) {
+        best_fg.push_back(pair.first);
+      }
+    }
+
+    m_max.clear();
+    for (Index f : best_fg) {
+      m_max.insert(m_max.end(), by_fg[f].begin(), by_fg[f].end());
+    }
+    std::sort(m_max.begin(), m_max.end());
+  }
+
+  /// \brief Keep operations that leave the occupation invariant, checking
+  ///     sites with the least common occupant first
+  void _search_occupation_stab() {
+    if (_stab_resolved()) {
+      return;
+    }
+    Eigen::VectorXi const &occupation = m_dof_values.occupation;
+    std::map<int, Index> count;
+    for (Index l = 0; l < occupation.size(); ++l) {
+      count[occupation[l]] += 1;
+    }
+    std::vector<std::pair<Index, Index>> order;
+    for (Index l = 0; l < occupation.size(); ++l) {
+      order.emplace_back(count[occupation[l]], l);
+    }
+    std::sort(order.begin(), order.end());
+
+    for (auto const &pair : order) {
+      if (_stab_resolved()) {
+        return;
+      }
+      Index l = pair.second;
+      auto end = std::remove_if(m_stab.begin(), m_stab.end(), [&](Index k) {
+        return _occupation(_fg(k))[_translate(k, l)] != occupation[l];
+      });
+      m_stab.erase(end, m_stab.end());
+    }
+  }
+
+  void _search_local() {
+    for (auto const &dof : m_dof_values.local_dof_values) {
+      DoFKey const &key = dof.first;
+      Eigen::MatrixXd const &init_value = dof.second;
+      for (Index j = 0; j < init_value.cols(); ++j) {
+        for (Index i = 0; i < init_value.rows(); ++i) {
+          if (_resolved()) {
+            return;
+          }
+          auto value_f = [&](Index k) {
+            return _local(_fg(k)).at(key)(i, _translate(k, j));
+          };
+          _prune_max(value_f, m_tol);
+          _prune_stab(value_f, init_value(i, j), m_tol);
+        }
+      }
+    }
+  }
+
+  Configuration const &m_configuration;
+  clexulator::ConfigDoFValues const &m_dof_values;
+  Supercell const &m_supercell;
+  std::vector<SupercellSymOp> const &m_ops;
+  TranslationArithmetic m_arithmetic;
+  double m_tol;
+  Index m_n_vol;
+  Index m_n_sublat;
+  Index m_n_fg;
+
+  // candidates, as indices into m_ops
+  std::vector<Index> m_max;
+  std::vector<Index> m_stab;
+
+  // scratch values
+  std::vector<double> m_values;
+
+  // values after factor group operation only, by supercell factor group index
+  std::vector<std::optional<Eigen::VectorXi>> m_occupation;
+  std::vector<std::optional<std::map<DoFKey, Eigen::VectorXd>>> m_global;
+  std::vector<std::optional<std::map<DoFKey, Eigen::MatrixXd>>> m_local;
+};
+
+}  // namespace
+
+/// \brief Find the canonical form, the operation that makes a configuration
+///     canonical, and the invariant subgroup in a single search
+///
+/// \param configuration The configuration
+/// \param ops The operations to search, which must be operations of
+///     `configuration.supercell`
+///
+/// \returns The canonical configuration, the first operation in `ops` that
+///     makes `configuration` canonical (as `to_canonical`), and the
+///     operations in `ops` that leave `configuration` invariant (as
+///     `make_invariant_subgroup`).
+///
+/// Method:
+/// - Sites are visited in the order used by ConfigCompare, keeping only the
+///   operations that are still tied for the greatest configuration, and,
+///   separately, the operations that still leave the configuration invariant.
+///   Operations are dropped as soon as they lose.
+/// - For occupation, the greatest translations for each factor group
+///   operation are found with `find_max_translations`, and operations that
+///   leave the configuration invariant are checked at sites with the least
+///   common occupant first.
+/// - The search stops as soon as a single candidate remains for the canonical
+///   form and the only remaining candidate invariant operation is the
+///   identity (the trivial stabilizer), which for low symmetry or dilute
+///   configurations happens within a few sites.
+/// - Continuous DoF values are compared with the tolerance of the prim
+///   lattice, as in ConfigCompare.
+CanonicalFormSearchResult canonical_form_search(
+    Configuration const &configuration,
+    std::vector<SupercellSymOp> const &ops) {
+  return CanonicalFormSearch(configuration, ops).run();
+}
+
+/// \brief Return reps that make configurations canonical, for configurations
+///     in the same supercell
+///
+/// \param configurations Configurations, which must all have the same
+///     supercell
+/// \param arithmetic Translation arithmetic for the supercell
+///
+/// \returns The result, `rep[i]`, is the first operation of all supercell
+///     operations that satisfies:
+///     canonical_configuration == copy_apply(rep[i], *configurations[i])
+///
+/// Method:
+/// - For each factor group operation, the translations which give the
+///   greatest occupation are found directly with `find_max_translations`.
+///   Only those candidates are then compared with ConfigCompare, which also
+///   accounts for global and local continuous DoF. The result is the same as
+///   the `std::max_element` based `to_canonical`.
+/// - Factor group operations are iterated in the outer loop, and
+///   configurations in the inner loop, so that each factor group permutation
+///   is loaded once per block of configurations.
+std::vector<SupercellSymOp> to_canonical(
+    std::vector<Configuration const *> const &configurations,
+    TranslationArithmetic const &arithmetic) {
+  if (configurations.empty()) {
+    return std::vector<SupercellSymOp>();
+  }
+  std::shared_ptr<Supercell const> const &supercell =
+      configurations[0]->supercell;
+  for (Configuration const *configuration : configurations) {
+    if (configuration->supercell != supercell) {
+      throw std::runtime_error(
+          "Error in to_canonical: configurations do not have the same "
+          "supercell");
+    }
+  }
+  bool has_occupation_dofs = supercell->prim->sym_info.has_occupation_dofs;
+  Index n_factor_group = supercell->sym_info.factor_group_permutations.size();
+
+  std::vector<Index> all_translations(supercell->superlattice.size());
+  std::iota(all_translations.begin(), all_translations.end(), 0);
+
+  std::vector<ConfigCompare> compare_f;
+  std::vector<SupercellSymOp> canonical_op;
+  for (Configuration const *configuration : configurations) {
+    compare_f.emplace_back(ConfigIsEquivalent(*configuration));
+    canonical_op.push_back(SupercellSymOp::begin(supercell));
+  }
+
+  for (Index f = 0; f < n_factor_group; ++f) {
+    for (Index i = 0; i < configurations.size(); ++i) {
+      Eigen::VectorXi const &occupation =
+          configurations[i]->dof_values.occupation;
+      std::vector<Index> candidates;
+      if (has_occupation_dofs && occupation.size()) {
+        candidates = find_max_translations(
+            make_factor_group_occupation(occupation, *supercell, f),
+            arithmetic, all_translations);
+      } else {
+        candidates = all_translations;
+      }
+      for (Index t : candidates) {
+        SupercellSymOp op(supercell, f, t);
+        if (compare_f[i](canonical_op[i], op)) {
+          canonical_op[i] = op;
+        }
+      }
+    }
+  }
+  return canonical_op;
+}
+
+namespace {
+
+/// \brief Implements make_canonical_forms
+///
+/// \param configurations Configurations to make canonical
+/// \param block_size Number of configurations per block
+/// \param max_table_size Maximum size of tabulated translation arithmetic
+///     (number of unit cells squared) for each supercell
+/// \param for_each_block Called as `for_each_block(n_blocks, f)`, must call
+///     `f(i_block)` for each block.
+template <typename ForEachBlock>
+CanonicalFormsResult _make_canonical_forms(
+    std::vector<Configuration> const &configurations, Index block_size,
+    Index max_table_size, ForEachBlock for_each_block) {
+  CanonicalFormsResult result;
+  result.canonical_configurations = configurations;
+  result.to_canonical.resize(configurations.size());
+
+  // group by supercell, preserving input order within each group
+  std::map<Supercell const *, std::vector<Index>> by_supercell;
+  for (Index i = 0; i < configurations.size(); ++i) {
+    by_supercell[configurations[i].supercell.get()].push_back(i);
+  }
+
+  if (block_size <= 0) {
+    block_size = 1;
+  }
+
+  // construct the shared tables of all supercells first, then process the
+  // blocks of all supercells together, so that parallel processing is not
+  // limited to the blocks of one supercell at a time
+  struct Block {
+    Index i_supercell;
+    Index begin;
+    Index end;
+  };
+  std::vector<std::vector<Index> const *> supercell_indices;
+  std::vector<TranslationArithmetic> arithmetic;
+  arithmetic.reserve(by_supercell.size());
+  std::vector<Block> blocks;
+  for (auto const &pair : by_supercell) {
+    Supercell const &supercell = *pair.first;
+    std::vector<Index> const &indices = pair.second;
+    Index i_supercell = supercell_indices.size();
+    supercell_indices.push_back(&indices);
+    arithmetic.emplace_back(supercell.unitcell_index_converter, max_table_size);
+    supercell.sym_info.combined_permutations->construct();
+
+    Index n_blocks = (indices.size() + block_size - 1) / block_size;
+    for (auto const &block : make_blocks(indices.size(), n_blocks)) {
+      blocks.push_back({i_supercell, block.first, block.second});
+    }
+  }
+
+  for_each_block(blocks.size(), [&](Index i_block) {
+    Block const &b = blocks[i_block];
+    std::vector<Index> const &indices = *supercell_indices[b.i_supercell];
+    std::vector<Configuration const *> block;
+    for (Index j = b.begin; j < b.end; ++j) {
+      block.push_back(&configurations[indices[j]]);
+    }
+    std::vector<SupercellSymOp> ops =
+        to_canonical(block, arithmetic[b.i_supercell]);
+    for (Index j = b.begin; j < b.end; ++j) {
+      SupercellSymOp const &op = ops[j - b.begin];
+      result.to_canonical[indices[j]] = op;
+      apply(op, result.canonical_configurations[indices[j]]);
+    }
+  });
+  return result;
+}
+
+}  // namespace
+
+/// \brief Make canonical forms of many configurations, sharing precomputed
+///     tables for configurations in the same supercell
+///
+/// \param configurations Configurations to make canonical. They may be in
+///     different supercells.
+/// \param block_size Number of configurations in the same supercell that
+///     are processed together, iterating over factor group operations in the
+///     outer loop.
+/// \param max_table_size For each supercell, if the number of unit cells
+///     squared is less than or equal to `max_table_size`, translation
+///     arithmetic is tabulated once and shared by all configurations in the
+///     supercell (using `2 * 4 * n_vol^2` bytes).
+///
+/// \returns The canonical configurations, and the operations that make them
+///     canonical, in the order of the input configurations. The results are
+///     the same as `make_canonical_form(configuration, begin, end)` and
+///     `to_canonical(configuration, begin, end)`, using all supercell
+///     operations.
+CanonicalFormsResult make_canonical_forms(
+    std::vector<Configuration> const &configurations, Index block_size,
+    Index max_table_size) {
+  return _make_canonical_forms(
+      configurations, block_size, max_table_size,
+      [](Index n_blocks, std::function<void(Index)> f) {
+        for (Index i = 0; i < n_blocks; ++i) {
+          f(i);
+        }
+      });
+}
+
+/// \brief Make canonical forms of many configurations, sharing precomputed
+///     tables for configurations in the same supercell and processing blocks
+///     in parallel
+///
+/// Results are the same as the serial version. See that for parameter
+/// details.
+CanonicalFormsResult make_canonical_forms(
+    std::vector<Configuration> const &configurations, ThreadPool &pool,
+    Index block_size, Index max_table_size) {
+  return _make_canonical_forms(
+      configurations, block_size, max_table_size,
+      [&](Index n_blocks, std::function<void(Index)> f) {
+        pool.parallel_for(n_blocks, [&](Index begin, Index end) {
+          for (Index i = begin; i < end; ++i) {
+            f(i);
+          }
+        });
+      });
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -119,7 +119,7 @@ std::map<DoFKey, ConfigSpaceAnalysisResults> config_space_analysis(
       lattices.begin(), lattices.end(), fg.begin(), fg.end());
   auto const &pg = prim->sym_info.point_group->element;
   super_lat = xtal::canonical::equivalent(super_lat, pg);
-  auto shared_supercell = std::make_shared<Supercell const>(prim, super_lat);
+  auto shared_supercell = make_shared_supercell(prim, super_lat);
 
   // --- Generate symmetry adapted config spaces ---
   for (auto const &dof_key : *dofs) {
@@ -145,8 +145,10 @@ std::map<DoFKey, ConfigSpaceAnalysisResults> config_space_analysis(
       Configuration prototype =
           copy_configuration(prim_config.first, shared_supercell);
       std::vector<Configuration> equivalents =
-          make_equivalents(prototype, SupercellSymOp::begin(shared_supercell),
-                           SupercellSymOp::end(shared_supercell));
+          make_equivalents_by_cosets(prototype,
+                                     SupercellSymOp::begin(shared_supercell),
+                                     SupercellSymOp::end(shared_supercell))
+              .equivalents;
 
       std::vector<Eigen::VectorXd> equiv_x;
       for (auto const &config : equivalents) {
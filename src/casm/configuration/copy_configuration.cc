@@ -4,6 +4,8 @@
 #include "casm/configuration/Configuration.hh"
 #include "casm/configuration/SupercellSymOp.hh"
 #include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/fused_apply.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
 
 namespace CASM {
 namespace config {
@@ -472,7 +474,7 @@ make_all_super_configurations_by_subsets(
     // Apply op to fill supercell and make all equivalents
     Configuration tmp =
         copy_configuration(prim_fg_op, trans, prim_motif, supercell, origin);
-    all.push_back(make_equivalents(tmp, begin, end));
+    all.push_back(make_equivalents_by_cosets(tmp, begin, end).equivalents);
   }
   return all;
 }
@@ -526,13 +528,25 @@ make_all_super_configurations_by_subsets(
   UnitCell origin(0, 0, 0);
   SupercellSymOp begin = SupercellSymOp::begin(supercell);
   SupercellSymOp end = SupercellSymOp::end(supercell);
+  FusedApplyWorkspace workspace;
 
   // Loop over unique generating ops
   for (Index prim_fg_op : unique_generating_prim_fg_op) {
     // Apply op to fill supercell and make all equivalents
     ConfigurationWithProperties tmp = copy_configuration_with_properties(
         prim_fg_op, trans, prim_motif_with_properties, supercell, origin);
-    all.push_back(make_equivalents(tmp, begin, end));
+    // properties are not compared, so only the configuration is used to find
+    // equivalents, then the first generating op is applied to both
+    EquivalentsResult equivalents =
+        make_equivalents_by_cosets(tmp.configuration, begin, end);
+    std::vector<SupercellSymOp> generating_ops;
+    for (auto const &ops : equivalents.equivalence_map) {
+      generating_ops.push_back(ops[0]);
+    }
+    std::vector<ConfigurationWithProperties> subset;
+    fused_apply(generating_ops.begin(), generating_ops.end(), tmp, subset,
+                workspace);
+    all.push_back(subset);
   }
   return all;
 }
@@ -619,8 +633,7 @@ Configuration make_primitive(Configuration const &configuration) {
             .reduced_cell();
 
     // create a sub configuration in the new supercell
-    tconfig =
-        copy_configuration(tconfig, std::make_shared<Supercell>(prim, new_lat));
+    tconfig = copy_configuration(tconfig, make_shared_supercell(prim, new_lat));
   }
 
   return tconfig;
@@ -638,26 +651,34 @@ ConfigurationWithProperties make_primitive(
 /// \brief Return a prim factor group index that transforms a supercell to an
 ///     a particular equivalent supercell
 ///
+/// The result is the first prim factor group index for which
+/// `R * T_current` and `T_new` have the same Hermite normal form, where R is
+/// the integer point matrix of the factor group operation and T_current,
+/// T_new are the supercell transformation matrices.
+///
 /// Notes:
 /// - Throws if supercells are not equivalent
 Index prim_factor_group_index_to_supercell(
     std::shared_ptr<Supercell const> current_supercell,
     std::shared_ptr<Supercell const> new_supercell) {
-  Lattice const &new_scel_lattice = new_supercell->superlattice.superlattice();
-  Lattice const &current_scel_lattice =
-      current_supercell->superlattice.superlattice();
-  auto const &prim_fg = *current_supercell->prim->sym_info.factor_group;
-  auto begin = prim_fg.element.begin();
-  auto end = prim_fg.element.end();
-  auto res =
-      xtal::is_equivalent_superlattice(new_scel_lattice, current_scel_lattice,
-                                       begin, end, new_scel_lattice.tol());
-  if (res.first == end) {
-    throw std::runtime_error(
-        "Error in prim_factor_group_index_to_supercell: not equivalent");
+  Eigen::Matrix3l const &T_current =
+      current_supercell->superlattice.transformation_matrix_to_super();
+  Eigen::Matrix3l H_new =
+      hermite_normal_form(
+          new_supercell->superlattice.transformation_matrix_to_super()
+              .cast<int>())
+          .first.cast<long>();
+  auto const &rep =
+      current_supercell->prim->sym_info.unitcellcoord_symgroup_rep;
+  for (Index i = 0; i < rep.size(); ++i) {
+    Eigen::Matrix3l point_matrix_T = rep[i].point_matrix * T_current;
+    if (hermite_normal_form(point_matrix_T.cast<int>()).first.cast<long>() ==
+        H_new) {
+      return i;
+    }
   }
-  Index prim_factor_group_index = std::distance(begin, res.first);
-  return prim_factor_group_index;
+  throw std::runtime_error(
+      "Error in prim_factor_group_index_to_supercell: not equivalent");
 }
 
 /// \brief Return the canonical configuration in the canonical supercell
@@ -666,14 +687,16 @@ Index prim_factor_group_index_to_supercell(
 /// - Applies symmetry operations if necessary to copy the configuration into
 ///   the canonical supercell
 Configuration make_in_canonical_supercell(Configuration const &configuration) {
-  if (is_canonical(*configuration.supercell)) {
+  SupercellCanonicalSearchResult result =
+      canonical_supercell_search(*configuration.supercell);
+  if (result.is_canonical) {
     return make_canonical_form(configuration,
                                SupercellSymOp::begin(configuration.supercell),
                                SupercellSymOp::end(configuration.supercell));
   }
 
-  std::shared_ptr<Supercell const> canonical_supercell =
-      make_canonical_form(*configuration.supercell);
+  std::shared_ptr<Supercell const> canonical_supercell = make_shared_supercell(
+      configuration.supercell->prim, result.canonical_transformation_matrix);
   Index prim_factor_group_index = prim_factor_group_index_to_supercell(
       configuration.supercell, canonical_supercell);
   Configuration config_in_canonical_supercell = copy_configuration(
@@ -699,7 +722,9 @@ ConfigurationWithProperties make_in_canonical_supercell(
     ConfigurationWithProperties const &configuration_with_properties) {
   Configuration const &configuration =
       configuration_with_properties.configuration;
-  if (is_canonical(*configuration.supercell)) {
+  SupercellCanonicalSearchResult result =
+      canonical_supercell_search(*configuration.supercell);
+  if (result.is_canonical) {
     return copy_apply(
         to_canonical(configuration,
                      SupercellSymOp::begin(configuration.supercell),
@@ -707,8 +732,8 @@ ConfigurationWithProperties make_in_canonical_supercell(
         configuration_with_properties);
   }
 
-  std::shared_ptr<Supercell const> canonical_supercell =
-      make_canonical_form(*configuration.supercell);
+  std::shared_ptr<Supercell const> canonical_supercell = make_shared_supercell(
+      configuration.supercell->prim, result.canonical_transformation_matrix);
   Index prim_factor_group_index = prim_factor_group_index_to_supercell(
       configuration.supercell, canonical_supercell);
   ConfigurationWithProperties config_in_canonical_supercell =
@@ -71,7 +71,7 @@ DoFSpaceAnalysisResults dof_space_analysis(
   if (dof_space_in.transformation_matrix_to_super.has_value()) {
     T = *dof_space_in.transformation_matrix_to_super;
   }
-  auto supercell = std::make_shared<Supercell const>(prim, T);
+  auto supercell = make_shared_supercell(prim, T);
 
   // --- Construct the standard DoF space ---
   clexulator::DoFSpace dof_space_pre1 =
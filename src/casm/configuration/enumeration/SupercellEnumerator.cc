@@ -0,0 +1,248 @@
+#include "casm/configuration/enumeration/SupercellEnumerator.hh"
+
+#include <algorithm>
+#include <set>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/ThreadPool.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/hermite_normal_form.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Parse "abc"-style enumeration directions
+std::array<bool, 3> make_dirs(std::string const &dirs) {
+  std::array<bool, 3> result = {false, false, false};
+  for (char ch : dirs) {
+    if (ch < 'a' || ch > 'c' || result[ch - 'a']) {
+      throw std::runtime_error(
+          "Error in SupercellEnumerator: invalid dirs \"" + dirs + "\"");
+    }
+    result[ch - 'a'] = true;
+  }
+  if (dirs.empty()) {
+    throw std::runtime_error("Error in SupercellEnumerator: empty dirs");
+  }
+  return result;
+}
+
+/// \brief Return the prim point group operations, in fractional coordinates
+///     of the unit cell, that map the set of allowed HNF to itself
+///
+/// Operations must map the unit cell lattice to itself, and must not mix
+/// the enumerated and fixed unit cell vectors.
+std::vector<Eigen::Matrix3l> make_unit_cell_point_matrices(
+    Prim const &prim, Eigen::Matrix3l const &unit_cell,
+    std::array<bool, 3> const &dirs) {
+  std::vector<Eigen::Matrix3l> prim_point_matrices =
+      make_fractional_point_matrices(prim.basicstructure->lattice(),
+                                     prim.sym_info.point_group->element);
+  Eigen::Matrix3d U_inv = unit_cell.cast<double>().inverse();
+  std::vector<Eigen::Matrix3l> result;
+  for (auto const &R : prim_point_matrices) {
+    Eigen::Matrix3d R_d = U_inv * (R * unit_cell).cast<double>();
+    Eigen::Matrix3l R_U = R_d.array().round().cast<long>().matrix();
+    if (unit_cell * R_U != R * unit_cell) {
+      continue;
+    }
+    bool mixes_dirs = false;
+    for (Index i = 0; i < 3; ++i) {
+      for (Index j = 0; j < 3; ++j) {
+        if (dirs[i] != dirs[j] && R_U(i, j) != 0) {
+          mixes_dirs = true;
+        }
+      }
+    }
+    if (!mixes_dirs) {
+      result.push_back(R_U);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param prim The prim
+/// \param min_volume,max_volume The range of supercell volumes to
+///     enumerate, inclusive, as a multiple of the unit cell volume
+/// \param dirs The unit cell vectors along which to enumerate, any
+///     combination of "a", "b", and "c". For example, "ab" enumerates 2d
+///     supercells with the "c" unit cell vector fixed.
+/// \param unit_cell The unit cell, as a transformation matrix of the prim
+///     lattice. Enumerated supercells are superlattices of the unit cell.
+///
+/// Notes:
+/// - If the unit cell or dirs break prim point group symmetry, only the
+///   point group operations that preserve them are used to reject
+///   non-canonical HNF, and duplicate results within a volume are removed.
+SupercellEnumerator::SupercellEnumerator(
+    std::shared_ptr<Prim const> const &prim, Index min_volume,
+    Index max_volume, std::string dirs, Eigen::Matrix3l const &unit_cell)
+    : SupercellEnumerator(prim, min_volume, max_volume, dirs, unit_cell,
+                          nullptr) {}
+
+/// \brief Constructor, enumerating volumes in parallel
+///
+/// Same as the serial constructor, except that `pool.size()` consecutive
+/// volumes are enumerated in parallel at a time.
+SupercellEnumerator::SupercellEnumerator(
+    std::shared_ptr<Prim const> const &prim, Index min_volume,
+    Index max_volume, std::string dirs, Eigen::Matrix3l const &unit_cell,
+    ThreadPool &pool)
+    : SupercellEnumerator(prim, min_volume, max_volume, dirs, unit_cell,
+                          &pool) {}
+
+SupercellEnumerator::SupercellEnumerator(
+    std::shared_ptr<Prim const> const &prim, Index min_volume,
+    Index max_volume, std::string dirs, Eigen::Matrix3l const &unit_cell,
+    ThreadPool *pool)
+    : m_prim(prim),
+      m_max_volume(max_volume),
+      m_unit_cell(unit_cell),
+      m_dirs(make_dirs(dirs)),
+      m_pool(pool),
+      m_next_volume(min_volume),
+      m_index(0) {
+  if (min_volume < 1) {
+    throw std::runtime_error(
+        "Error in SupercellEnumerator: min_volume must be >= 1");
+  }
+  if (m_unit_cell.cast<double>().determinant() == 0.0) {
+    throw std::runtime_error(
+        "Error in SupercellEnumerator: unit_cell is singular");
+  }
+  m_point_matrices =
+      make_unit_cell_point_matrices(*m_prim, m_unit_cell, m_dirs);
+  m_is_restricted = (m_point_matrices.size() !=
+                     m_prim->sym_info.point_group->element.size());
+  _load();
+}
+
+/// \brief Get the current Supercell
+std::shared_ptr<Supercell const> const &SupercellEnumerator::value() const {
+  return m_batch[m_index];
+}
+
+/// \brief Generate the next Supercell
+void SupercellEnumerator::advance() {
+  ++m_index;
+  if (m_index == m_batch.size()) {
+    _load();
+  }
+}
+
+/// \brief Return true if `value` is valid, false if no more valid values
+bool SupercellEnumerator::is_valid() const { return m_index < m_batch.size(); }
+
+/// \brief Enumerate the next volume(s) with results
+void SupercellEnumerator::_load() {
+  m_batch.clear();
+  m_index = 0;
+  while (m_batch.empty() && m_next_volume <= m_max_volume) {
+    if (m_pool == nullptr) {
+      m_batch = _enumerate_volume(m_next_volume);
+      ++m_next_volume;
+      continue;
+    }
+
+    Index n_volumes = std::min(std::max(m_pool->size(), Index(1)),
+                               m_max_volume - m_next_volume + 1);
+    std::vector<std::vector<std::shared_ptr<Supercell const>>> results(
+        n_volumes);
+    Index first_volume = m_next_volume;
+    m_pool->parallel_for(
+        n_volumes,
+        [&](Index begin, Index end) {
+          for (Index i = begin; i < end; ++i) {
+            results[i] = _enumerate_volume(first_volume + i);
+          }
+        },
+        n_volumes);
+    for (auto const &result : results) {
+      m_batch.insert(m_batch.end(), result.begin(), result.end());
+    }
+    m_next_volume += n_volumes;
+  }
+}
+
+/// \brief Return canonical supercells of a particular volume
+///
+/// HNF are generated with diagonal elements (a, b, c), a*b*c == volume,
+/// and upper triangular elements 0 <= H(i,j) < H(i,i). Fixed directions
+/// have H(i,i) == 1 and no off-diagonal elements in column i.
+std::vector<std::shared_ptr<Supercell const>>
+SupercellEnumerator::_enumerate_volume(Index volume) const {
+  std::vector<std::shared_ptr<Supercell const>> result;
+
+  // canonical transformation matrices found, if restricted
+  auto lexicographical_less = [](Eigen::Matrix3l const &A,
+                                 Eigen::Matrix3l const &B) {
+    return std::lexicographical_compare(A.data(), A.data() + 9, B.data(),
+                                        B.data() + 9);
+  };
+  std::set<Eigen::Matrix3l, decltype(lexicographical_less)> found(
+      lexicographical_less);
+
+  Eigen::Matrix3l H = Eigen::Matrix3l::Zero();
+  for (Index a = 1; a <= volume; ++a) {
+    if (volume % a != 0 || (!m_dirs[0] && a != 1)) {
+      continue;
+    }
+    for (Index b = 1; b <= volume / a; ++b) {
+      if ((volume / a) % b != 0 || (!m_dirs[1] && b != 1)) {
+        continue;
+      }
+      Index c = volume / a / b;
+      if (!m_dirs[2] && c != 1) {
+        continue;
+      }
+      Index max_01 = m_dirs[1] ? a : 1;
+      Index max_02 = m_dirs[2] ? a : 1;
+      Index max_12 = m_dirs[2] ? b : 1;
+      H(0, 0) = a;
+      H(1, 1) = b;
+      H(2, 2) = c;
+      for (Index h12 = 0; h12 < max_12; ++h12) {
+        H(1, 2) = h12;
+        for (Index h02 = 0; h02 < max_02; ++h02) {
+          H(0, 2) = h02;
+          for (Index h01 = 0; h01 < max_01; ++h01) {
+            H(0, 1) = h01;
+            if (!_is_canonical_hnf(H)) {
+              continue;
+            }
+            Eigen::Matrix3l T_canonical =
+                canonical_supercell_search(m_prim, m_unit_cell * H)
+                    .canonical_transformation_matrix;
+            if (!m_is_restricted || found.insert(T_canonical).second) {
+              result.push_back(make_shared_supercell(m_prim, T_canonical));
+            }
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/// \brief Return true if H is the greatest of its equivalent HNF
+bool SupercellEnumerator::_is_canonical_hnf(Eigen::Matrix3l const &H) const {
+  for (auto const &R : m_point_matrices) {
+    Eigen::Matrix3l RH = R * H;
+    if (hermite_normal_form_less(
+            H, hermite_normal_form(RH.cast<int>()).first.cast<long>())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace config
+}  // namespace CASM
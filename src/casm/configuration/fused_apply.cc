@@ -0,0 +1,240 @@
+#include "casm/configuration/fused_apply.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/crystallography/AnisoValTraits.hh"
+#include "casm/crystallography/SymType.hh"
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+/// \brief Resize output map to have the same keys as input, re-using
+///     existing values
+template <typename MapType>
+void match_keys(MapType const &input, MapType &output) {
+  if (output.size() == input.size()) {
+    auto it = output.begin();
+    for (auto const &pair : input) {
+      if (it->first != pair.first) {
+        break;
+      }
+      ++it;
+    }
+    if (it == output.end()) {
+      return;
+    }
+  }
+  for (auto it = output.begin(); it != output.end();) {
+    if (!input.count(it->first)) {
+      it = output.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto const &pair : input) {
+    output[pair.first];
+  }
+}
+
+}  // namespace
+
+/// \brief Return the matrix that transforms property values
+///
+/// Matrices are constructed with `AnisoValTraits::symop_to_matrix` for the
+/// prim factor group operation of `op` the first time they are requested,
+/// and then re-used.
+Eigen::MatrixXd const &FusedApplyWorkspace::property_matrix(
+    std::string const &key, SupercellSymOp const &op) {
+  Prim const &op_prim = *op.supercell()->prim;
+  if (this->prim != &op_prim) {
+    this->prim = &op_prim;
+    this->property_matrices.clear();
+  }
+  auto const &factor_group = op_prim.sym_info.factor_group->element;
+  std::vector<Eigen::MatrixXd> &matrices = this->property_matrices[key];
+  if (matrices.size() != factor_group.size()) {
+    matrices.assign(factor_group.size(), Eigen::MatrixXd());
+  }
+  Index prim_fg_index = op.prim_factor_group_index();
+  Eigen::MatrixXd &M = matrices[prim_fg_index];
+  if (M.size() == 0) {
+    SymOp const &symop = factor_group[prim_fg_index];
+    AnisoValTraits traits(key);
+    M = traits.symop_to_matrix(get_matrix(symop), get_translation(symop),
+                               get_time_reversal(symop));
+  }
+  return M;
+}
+
+/// \brief Cache transformed local DoF values of an input
+///
+/// While set, `fused_apply` with `input.dof_values` permutes columns of local
+/// DoF values transformed by each prim factor group operation, computed
+/// once, instead of transforming values for each operation. The cache is
+/// only valid while `input` is not modified.
+void FusedApplyWorkspace::cache_local_dof_values(Configuration const &input) {
+  Index n_sublat = input.supercell->prim->basicstructure->basis().size();
+  this->local_dof_caches.clear();
+  this->cached_input = &input.dof_values;
+  for (auto const &dof : input.dof_values.local_dof_values) {
+    this->local_dof_caches.emplace(
+        std::piecewise_construct, std::forward_as_tuple(dof.first),
+        std::forward_as_tuple(dof.second, dof.first, n_sublat));
+  }
+}
+
+/// \brief Erase cached transformed local DoF values
+void FusedApplyWorkspace::clear_local_dof_values() {
+  this->cached_input = nullptr;
+  this->local_dof_caches.clear();
+}
+
+/// \brief Apply a symmetry operation to ConfigDoFValues, writing the result
+///     to an output in a single pass over sites
+///
+/// Equivalent to `output = copy_apply(op, input)`, but the combined site
+/// permutation is walked once, transforming and permuting occupation and
+/// all local DoF values at each site. Storage in `output` and `workspace`
+/// is re-used, so that no allocation is done if `output` already has the
+/// required shape.
+///
+/// \param op The symmetry operation
+/// \param input The DoF values to transform
+/// \param output Set to the transformed DoF values. Must not be `input`.
+/// \param workspace Re-usable buffers
+void fused_apply(SupercellSymOp const &op, ConfigDoFValues const &input,
+                 ConfigDoFValues &output, FusedApplyWorkspace &workspace) {
+  if (&input == &output) {
+    throw std::runtime_error(
+        "Error in fused_apply: input and output must be distinct");
+  }
+  Supercell const &supercell = *op.supercell();
+  PrimSymInfo const &prim_sym_info = supercell.prim->sym_info;
+  Index n_vol = supercell.superlattice.size();
+  Index prim_fg_index = op.prim_factor_group_index();
+
+  op.combined_permute(workspace.permutation);
+  sym_info::Permutation const &perm = workspace.permutation;
+  Index n_sites = perm.size();
+
+  // global DoF
+  match_keys(input.global_dof_values, output.global_dof_values);
+  for (auto const &dof : input.global_dof_values) {
+    Eigen::MatrixXd const &M =
+        prim_sym_info.global_dof_symgroup_rep.at(dof.first)[prim_fg_index];
+    output.global_dof_values[dof.first].noalias() = M * dof.second;
+  }
+
+  // occupation
+  Eigen::VectorXi const &occ_in = input.occupation;
+  Eigen::VectorXi &occ_out = output.occupation;
+  occ_out.resize(occ_in.size());
+  if (occ_in.size()) {
+    if (prim_sym_info.has_aniso_occs) {
+      sym_info::OccSymOpRep const &occ_rep =
+          prim_sym_info.occ_symgroup_rep[prim_fg_index];
+      for (Index l = 0; l < n_sites; ++l) {
+        Index before = perm[l];
+        occ_out[l] = occ_rep[before / n_vol][occ_in[before]];
+      }
+    } else {
+      for (Index l = 0; l < n_sites; ++l) {
+        occ_out[l] = occ_in[perm[l]];
+      }
+    }
+  }
+
+  // local DoF
+  match_keys(input.local_dof_values, output.local_dof_values);
+  if (workspace.cached_input == &input) {
+    for (auto const &dof : input.local_dof_values) {
+      Eigen::MatrixXd const &transformed =
+          workspace.local_dof_caches.at(dof.first).transformed(op);
+      Eigen::MatrixXd &out = output.local_dof_values[dof.first];
+      out.resize(transformed.rows(), transformed.cols());
+      for (Index l = 0; l < n_sites; ++l) {
+        out.col(l) = transformed.col(perm[l]);
+      }
+    }
+    return;
+  }
+  for (auto const &dof : input.local_dof_values) {
+    sym_info::LocalDoFSymOpRep const &rep =
+        prim_sym_info.local_dof_symgroup_rep.at(dof.first)[prim_fg_index];
+    Eigen::MatrixXd const &in = dof.second;
+    Eigen::MatrixXd &out = output.local_dof_values[dof.first];
+    out.resize(in.rows(), in.cols());
+    Index n_rows = in.rows();
+    for (Index l = 0; l < n_sites; ++l) {
+      Index before = perm[l];
+      Eigen::MatrixXd const &M = rep[before / n_vol];
+      Index dim = M.cols();
+      if (dim == 0) {
+        out.col(l) = in.col(before);
+        continue;
+      }
+      out.col(l).head(dim).noalias() = M * in.col(before).head(dim);
+      if (dim < n_rows) {
+        out.col(l).tail(n_rows - dim) = in.col(before).tail(n_rows - dim);
+      }
+    }
+  }
+}
+
+/// \brief Apply a symmetry operation to a Configuration, writing the result
+///     to an output in a single pass over sites
+///
+/// Equivalent to `output = copy_apply(op, input)`. See
+/// `fused_apply(SupercellSymOp const &, ConfigDoFValues const &,
+/// ConfigDoFValues &, FusedApplyWorkspace &)`.
+void fused_apply(SupercellSymOp const &op, Configuration const &input,
+                 Configuration &output, FusedApplyWorkspace &workspace) {
+  output.supercell = input.supercell;
+  fused_apply(op, input.dof_values, output.dof_values, workspace);
+}
+
+/// \brief Apply a symmetry operation to a configuration with properties,
+///     writing the result to an output in a single pass over sites
+///
+/// Equivalent to `output = copy_apply(op, input)`, but local properties are
+/// transformed and permuted in the same pass over sites as the DoF values
+/// permutation, and property transformation matrices are cached in
+/// `workspace`.
+///
+/// Notes:
+/// - Property matrices are constructed from the prim factor group
+///   operation, which differs from `op.to_symop()` only by a lattice
+///   translation. This assumes property values are not changed by lattice
+///   translations, as for all property types described by AnisoValTraits.
+void fused_apply(SupercellSymOp const &op,
+                 ConfigurationWithProperties const &input,
+                 ConfigurationWithProperties &output,
+                 FusedApplyWorkspace &workspace) {
+  fused_apply(op, input.configuration, output.configuration, workspace);
+  sym_info::Permutation const &perm = workspace.permutation;
+  Index n_sites = perm.size();
+
+  // global properties
+  match_keys(input.global_properties, output.global_properties);
+  for (auto const &property : input.global_properties) {
+    Eigen::MatrixXd const &M = workspace.property_matrix(property.first, op);
+    output.global_properties[property.first].noalias() = M * property.second;
+  }
+
+  // local properties
+  match_keys(input.local_properties, output.local_properties);
+  for (auto const &property : input.local_properties) {
+    Eigen::MatrixXd const &M = workspace.property_matrix(property.first, op);
+    Eigen::MatrixXd const &in = property.second;
+    Eigen::MatrixXd &out = output.local_properties[property.first];
+    out.resize(in.rows(), in.cols());
+    for (Index l = 0; l < n_sites; ++l) {
+      out.col(l).noalias() = M * in.col(perm[l]);
+    }
+  }
+}
+
+}  // namespace config
+}  // namespace CASM
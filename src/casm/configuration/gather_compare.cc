@@ -0,0 +1,312 @@
+#include "casm/configuration/gather_compare.hh"
+
+#include <algorithm>
+
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymInfo.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+
+// AVX2 is used only if enabled with the CMake option
+// CASM_CONFIGURATION_ENABLE_AVX2, which compiles this file with `-mavx2`
+#if defined(CASM_CONFIGURATION_ENABLE_AVX2) && defined(__AVX2__)
+#define CASM_GATHER_COMPARE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace CASM {
+namespace config {
+
+namespace {
+
+// Each "reader" provides:
+// - `int operator()(Index i) const`: value i
+// - `void gather(Index i, Index n, int *out) const`: values [i, i+n)
+// - with AVX2, `__m256i load8(Index i) const`: values [i, i+8)
+
+struct IdentityReader {
+  int const *values;
+
+  int operator()(Index i) const { return values[i]; }
+
+  void gather(Index i, Index n, int *out) const {
+    for (Index j = 0; j < n; ++j) {
+      out[j] = values[i + j];
+    }
+  }
+
+#if defined(CASM_GATHER_COMPARE_AVX2)
+  __m256i load8(Index i) const {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+  }
+#endif
+};
+
+struct Perm16Reader {
+  int const *values;
+  std::uint16_t const *perm;
+
+  int operator()(Index i) const { return values[perm[i]]; }
+
+  void gather(Index i, Index n, int *out) const {
+    for (Index j = 0; j < n; ++j) {
+      out[j] = values[perm[i + j]];
+    }
+  }
+
+#if defined(CASM_GATHER_COMPARE_AVX2)
+  __m256i load8(Index i) const {
+    __m256i index = _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(perm + i)));
+    return _mm256_i32gather_epi32(values, index, 4);
+  }
+#endif
+};
+
+struct Perm32Reader {
+  int const *values;
+  std::uint32_t const *perm;
+
+  int operator()(Index i) const { return values[perm[i]]; }
+
+  void gather(Index i, Index n, int *out) const {
+    for (Index j = 0; j < n; ++j) {
+      out[j] = values[perm[i + j]];
+    }
+  }
+
+#if defined(CASM_GATHER_COMPARE_AVX2)
+  __m256i load8(Index i) const {
+    __m256i index =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(perm + i));
+    return _mm256_i32gather_epi32(values, index, 4);
+  }
+#endif
+};
+
+/// Reads values through SupercellSymOp::permute_index, for supercells
+/// without a combined permutation table
+struct SymOpReader {
+  int const *values;
+  SupercellSymOp const *op;
+
+  int operator()(Index i) const { return values[op->permute_index(i)]; }
+
+  void gather(Index i, Index n, int *out) const {
+    for (Index j = 0; j < n; ++j) {
+      out[j] = values[op->permute_index(i + j)];
+    }
+  }
+
+#if defined(CASM_GATHER_COMPARE_AVX2)
+  __m256i load8(Index i) const {
+    alignas(32) int block[8];
+    gather(i, 8, block);
+    return _mm256_load_si256(reinterpret_cast<__m256i const *>(block));
+  }
+#endif
+};
+
+/// \brief Scalar search for the first difference in [i, n)
+template <typename L, typename R>
+Index _find_first_difference_scalar(L const &lhs, R const &rhs, Index i,
+                                    Index n) {
+  for (; i < n; ++i) {
+    if (lhs(i) != rhs(i)) {
+      return i;
+    }
+  }
+  return n;
+}
+
+/// \brief Find the first difference, in blocks
+///
+/// With AVX2, blocks of 8 values are gathered into vector registers and
+/// compared. Otherwise, the first values are compared one at a time, because
+/// unequal configurations usually differ early, and then blocks of values
+/// are gathered into scratch buffers, compared without branching, and only
+/// searched one value at a time if a difference is found.
+template <typename L, typename R>
+Index _find_first_difference(L const &lhs, R const &rhs, Index n) {
+  Index i = 0;
+#if defined(CASM_GATHER_COMPARE_AVX2)
+  for (; i + 8 <= n; i += 8) {
+    __m256i eq = _mm256_cmpeq_epi32(lhs.load8(i), rhs.load8(i));
+    if (_mm256_movemask_epi8(eq) != -1) {
+      return _find_first_difference_scalar(lhs, rhs, i, i + 8);
+    }
+  }
+#else
+  constexpr Index prefix_size = 8;
+  Index prefix_end = std::min(n, prefix_size);
+  i = _find_first_difference_scalar(lhs, rhs, i, prefix_end);
+  if (i < prefix_end) {
+    return i;
+  }
+
+  constexpr Index block_size = 64;
+  int lhs_block[block_size];
+  int rhs_block[block_size];
+  for (; i + block_size <= n; i += block_size) {
+    lhs.gather(i, block_size, lhs_block);
+    rhs.gather(i, block_size, rhs_block);
+    int differs = 0;
+    for (Index j = 0; j < block_size; ++j) {
+      differs |= (lhs_block[j] != rhs_block[j]);
+    }
+    if (differs) {
+      for (Index j = 0; j < block_size; ++j) {
+        if (lhs_block[j] != rhs_block[j]) {
+          return i + j;
+        }
+      }
+    }
+  }
+#endif
+  return _find_first_difference_scalar(lhs, rhs, i, n);
+}
+
+template <typename L>
+Index _find_first_difference(L const &lhs, PermutedOccupation const &rhs,
+                             Index n) {
+  if (rhs.perm_16bit) {
+    return _find_first_difference(lhs, Perm16Reader{rhs.values, rhs.perm_16bit},
+                                  n);
+  }
+  if (rhs.perm_32bit) {
+    return _find_first_difference(lhs, Perm32Reader{rhs.values, rhs.perm_32bit},
+                                  n);
+  }
+  if (rhs.op) {
+    return _find_first_difference(lhs, SymOpReader{rhs.values, rhs.op}, n);
+  }
+  return _find_first_difference(lhs, IdentityReader{rhs.values}, n);
+}
+
+}  // namespace
+
+/// \brief Return value i
+int PermutedOccupation::operator[](Index i) const {
+  if (perm_16bit) {
+    return values[perm_16bit[i]];
+  }
+  if (perm_32bit) {
+    return values[perm_32bit[i]];
+  }
+  if (op) {
+    return values[op->permute_index(i)];
+  }
+  return values[i];
+}
+
+/// \brief Occupation values, not permuted
+PermutedOccupation make_permuted_occupation(int const *values) {
+  PermutedOccupation result;
+  result.values = values;
+  return result;
+}
+
+/// \brief Occupation values, permuted by the supercell operation (f, t)
+///
+/// \param values Occupation values, before permutation
+/// \param table Combined permutation table for the supercell
+/// \param supercell_factor_group_index Supercell factor group index, f
+/// \param translation_index Translation index, t
+///
+/// \returns Occupation values, such that value `i` is equal to
+///     `values[SupercellSymOp(supercell, f, t).permute_index(i)]`.
+PermutedOccupation make_permuted_occupation(
+    int const *values, CombinedPermutationTable const &table,
+    Index supercell_factor_group_index, Index translation_index) {
+  PermutedOccupation result;
+  result.values = values;
+  result.perm_16bit =
+      table.data_16bit(supercell_factor_group_index, translation_index);
+  result.perm_32bit =
+      table.data_32bit(supercell_factor_group_index, translation_index);
+  return result;
+}
+
+/// \brief Occupation values, permuted by a supercell operation
+///
+/// \param values Occupation values, before permutation
+/// \param table Combined permutation table for the supercell of `op`
+/// \param op Supercell operation
+///
+/// \returns Occupation values, such that value `i` is equal to
+///     `values[op.permute_index(i)]`.
+PermutedOccupation make_permuted_occupation(
+    int const *values, CombinedPermutationTable const &table,
+    SupercellSymOp const &op) {
+  return make_permuted_occupation(values, table,
+                                  op.supercell_factor_group_index(),
+                                  op.translation_index());
+}
+
+/// \brief Occupation values, permuted by a supercell operation, using the
+///     combined permutation table if it is within the byte budget
+///
+/// \param values Occupation values, before permutation
+/// \param op Supercell operation, must outlive the result
+///
+/// \returns Occupation values, such that value `i` is equal to
+///     `values[op.permute_index(i)]`. If the combined permutation table for
+///     the supercell of `op` is not within the byte budget, values are read
+///     through `op.permute_index`.
+PermutedOccupation make_permuted_occupation(int const *values,
+                                            SupercellSymOp const &op) {
+  if (CombinedPermutationTable const *table = combined_permutation_table(op)) {
+    return make_permuted_occupation(values, *table, op);
+  }
+  PermutedOccupation result;
+  result.values = values;
+  result.op = &op;
+  return result;
+}
+
+/// \brief Return the combined permutation table for the supercell of an
+///     operation, constructing it if necessary, or nullptr if it is not
+///     within the byte budget
+///
+/// The table is constructed once per supercell, on first use, and shared by
+/// copies of the supercell's SupercellSymInfo. If nullptr is returned,
+/// callers fall back to `SupercellSymOp::permute_index`.
+CombinedPermutationTable const *combined_permutation_table(
+    SupercellSymOp const &op) {
+  return op.supercell()->sym_info.combined_permutations->construct();
+}
+
+/// \brief Return the first index, in [0, n), where lhs and rhs differ, or n
+///     if they are equal
+///
+/// This is equivalent to:
+/// \code
+/// Index i = 0;
+/// while (i < n && lhs[i] == rhs[i]) ++i;
+/// return i;
+/// \endcode
+///
+/// Notes:
+/// - If built with the CMake option `CASM_CONFIGURATION_ENABLE_AVX2=ON`,
+///   values permuted by a table are read with vector gather instructions, 8
+///   at a time. The resulting library requires a CPU that supports AVX2.
+///   Otherwise a portable blocked gather and compare is used.
+/// - Values permuted by a SupercellSymOp without a table are gathered
+///   through `SupercellSymOp::permute_index` into the same blocks.
+Index find_first_difference(PermutedOccupation const &lhs,
+                            PermutedOccupation const &rhs, Index n) {
+  if (lhs.perm_16bit) {
+    return _find_first_difference(Perm16Reader{lhs.values, lhs.perm_16bit},
+                                  rhs, n);
+  }
+  if (lhs.perm_32bit) {
+    return _find_first_difference(Perm32Reader{lhs.values, lhs.perm_32bit},
+                                  rhs, n);
+  }
+  if (lhs.op) {
+    return _find_first_difference(SymOpReader{lhs.values, lhs.op}, rhs, n);
+  }
+  return _find_first_difference(IdentityReader{lhs.values}, rhs, n);
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,65 @@
+#include "casm/configuration/hermite_normal_form.hh"
+
+#include <cmath>
+
+#include "casm/crystallography/Lattice.hh"
+#include "casm/crystallography/SymType.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Return true if Hermite normal form A is less than B
+///
+/// A and B are Hermite normal forms as returned by `hermite_normal_form`
+/// (casm/misc/CASM_Eigen_math.hh), the same as used for supercell names.
+/// Elements are compared lexicographically in the order used for supercell
+/// names: H(0,0), H(1,1), H(2,2), H(1,2), H(0,2), H(0,1).
+bool hermite_normal_form_less(Eigen::Matrix3l const &A,
+                              Eigen::Matrix3l const &B) {
+  static int const order[6][2] = {{0, 0}, {1, 1}, {2, 2},
+                                  {1, 2}, {0, 2}, {0, 1}};
+  for (auto const &ij : order) {
+    long a = A(ij[0], ij[1]);
+    long b = B(ij[0], ij[1]);
+    if (a != b) {
+      return a < b;
+    }
+  }
+  return false;
+}
+
+/// \brief Return integer point operation matrices, in fractional
+///     coordinates of a lattice
+///
+/// For each op, the result is `R_frac = L^-1 * op.matrix * L`, where L is
+/// the lattice vectors as columns of a matrix. Then, for the superlattice
+/// with transformation matrix T, `R_frac * T` is the transformation matrix
+/// of the superlattice transformed by op.
+///
+/// \throws std::runtime_error If any op does not map the lattice to itself
+std::vector<Eigen::Matrix3l> make_fractional_point_matrices(
+    Lattice const &lattice, std::vector<SymOp> const &ops) {
+  Eigen::Matrix3d const &L = lattice.lat_column_mat();
+  Eigen::Matrix3d const &L_inv = lattice.inv_lat_column_mat();
+  std::vector<Eigen::Matrix3l> result;
+  result.reserve(ops.size());
+  for (auto const &op : ops) {
+    Eigen::Matrix3d R_frac = L_inv * op.matrix * L;
+    Eigen::Matrix3l R = Eigen::Matrix3l::Zero();
+    for (Index i = 0; i < 3; ++i) {
+      for (Index j = 0; j < 3; ++j) {
+        R(i, j) = std::lround(R_frac(i, j));
+        if (std::abs(R_frac(i, j) - R(i, j)) > 1e-3) {
+          throw std::runtime_error(
+              "Error in make_fractional_point_matrices: op does not map "
+              "the lattice to itself");
+        }
+      }
+    }
+    result.push_back(R);
+  }
+  return result;
+}
+
+}  // namespace config
+}  // namespace CASM
@@ -0,0 +1,596 @@
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/io/binary/binary_io_impl.hh"
+
+namespace CASM {
+
+namespace binary_io_impl {
+
+char const binary_magic[8] = {'C', 'A', 'S', 'M', 'C', 'F', 'G', 'B'};
+std::uint64_t const binary_byte_order = 0x0102030405060708ULL;
+std::uint64_t const binary_version = 1;
+
+struct BinaryHeader {
+  char magic[8];
+  std::uint64_t byte_order;
+  std::uint64_t version;
+  std::uint64_t n_supercells;
+  std::uint64_t n_records;
+  std::uint64_t n_sites;
+  std::uint64_t n_global_dof;
+  std::uint64_t n_local_dof;
+  std::uint64_t n_next_config_id;
+  std::uint64_t string_table_size;
+};
+
+struct BinaryString {
+  std::uint64_t offset;
+  std::uint64_t size;
+};
+
+struct BinaryDoF {
+  BinaryString name;
+  std::uint64_t dim;
+};
+
+struct BinaryRecord {
+  std::uint64_t supercell_index;
+  std::uint64_t site_offset;
+  BinaryString supercell_name;
+  BinaryString configuration_id;
+};
+
+struct BinaryNextConfigId {
+  BinaryString supercell_name;
+  std::int64_t next_id;
+};
+
+std::uint64_t align8(std::uint64_t offset) { return (offset + 7) & ~7ULL; }
+
+/// \brief Return `a + b`, or throw if the sum overflows
+std::uint64_t checked_add(std::uint64_t a, std::uint64_t b) {
+  if (a > std::numeric_limits<std::uint64_t>::max() - b) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: file section size overflow");
+  }
+  return a + b;
+}
+
+/// \brief Return `a * b`, or throw if the product overflows
+std::uint64_t checked_mul(std::uint64_t a, std::uint64_t b) {
+  if (b != 0 && a > std::numeric_limits<std::uint64_t>::max() / b) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: file section size overflow");
+  }
+  return a * b;
+}
+
+/// \brief Number of sites in a supercell, from its transformation matrix
+Index supercell_n_sites(Eigen::Matrix3l const &T, Index basis_size) {
+  return std::abs(T.determinant()) * basis_size;
+}
+
+}  // namespace binary_io_impl
+
+using namespace binary_io_impl;
+
+namespace config {
+
+/// \brief Byte offsets of the sections of a binary configuration file
+struct MappedConfigurationSet::Layout {
+  BinaryHeader header;
+  DoFTable dof_info;
+
+  std::uint64_t dof_table;
+  std::uint64_t supercell_table;
+  std::uint64_t record_table;
+  std::uint64_t next_config_id_table;
+  std::vector<std::uint64_t> global_dof_column;
+  std::vector<std::uint64_t> local_dof_column;
+  std::uint64_t occupation_column;
+  std::uint64_t string_table;
+  std::uint64_t total_size;
+
+  /// Set offsets from header and DoF dimensions
+  ///
+  /// Throws if any offset overflows, so that sizes read from a file can be
+  /// checked against the file size.
+  void make_offsets() {
+    std::uint64_t offset = align8(sizeof(BinaryHeader));
+    dof_table = offset;
+    offset = checked_add(
+        offset,
+        checked_mul(checked_add(header.n_global_dof, header.n_local_dof),
+                    sizeof(BinaryDoF)));
+    supercell_table = offset;
+    offset = checked_add(
+        offset, checked_mul(header.n_supercells, 9 * sizeof(std::int64_t)));
+    record_table = offset;
+    offset = checked_add(offset,
+                         checked_mul(header.n_records, sizeof(BinaryRecord)));
+    next_config_id_table = offset;
+    offset = checked_add(offset, checked_mul(header.n_next_config_id,
+                                             sizeof(BinaryNextConfigId)));
+    global_dof_column.clear();
+    for (std::uint64_t dim : dof_info.global_dof_dim) {
+      global_dof_column.push_back(offset);
+      offset = checked_add(
+          offset,
+          checked_mul(checked_mul(header.n_records, dim), sizeof(double)));
+    }
+    local_dof_column.clear();
+    for (std::uint64_t dim : dof_info.local_dof_dim) {
+      local_dof_column.push_back(offset);
+      offset = checked_add(
+          offset,
+          checked_mul(checked_mul(header.n_sites, dim), sizeof(double)));
+    }
+    occupation_column = offset;
+    offset = checked_add(offset,
+                         checked_mul(header.n_sites, sizeof(std::int32_t)));
+    offset = checked_add(offset, 7) & ~7ULL;
+    string_table = offset;
+    offset = checked_add(offset, header.string_table_size);
+    total_size = offset;
+  }
+};
+
+/// \brief Open and memory-map a binary configuration file
+///
+/// \param path Path to a file written by `to_binary`
+/// \param prim The prim. Must have the same DoF types and dimensions as the
+///     prim of the configurations that were written.
+///
+/// Throws if the file cannot be opened or mapped, or if the header or DoF
+/// table are not consistent with the file size or `prim`.
+MappedConfigurationSet::MappedConfigurationSet(
+    std::string const &path, std::shared_ptr<Prim const> const &prim)
+    : m_prim(prim),
+      m_data(nullptr),
+      m_size(0),
+      m_layout(std::make_unique<Layout>()) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: could not open " + path);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < Index(sizeof(BinaryHeader))) {
+    ::close(fd);
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: invalid file " + path);
+  }
+  m_size = st.st_size;
+  m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (m_data == MAP_FAILED) {
+    m_data = nullptr;
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: could not map " + path);
+  }
+
+  try {
+    _read_layout(path);
+  } catch (...) {
+    ::munmap(m_data, m_size);
+    m_data = nullptr;
+    throw;
+  }
+  m_supercells = std::make_unique<SupercellTableReader>(
+      m_prim, m_layout->header.n_supercells, [this](Index supercell_index) {
+        std::int64_t values[9];
+        std::memcpy(values,
+                    static_cast<char const *>(m_data) +
+                        m_layout->supercell_table +
+                        supercell_index * sizeof(values),
+                    sizeof(values));
+        Eigen::Matrix3l T;
+        T << values[0], values[1], values[2], values[3], values[4], values[5],
+            values[6], values[7], values[8];
+        return T;
+      });
+}
+
+/// Read and check the header and DoF table, and set the section offsets
+void MappedConfigurationSet::_read_layout(std::string const &path) {
+  char const *data = static_cast<char const *>(m_data);
+  Layout &layout = *m_layout;
+  std::memcpy(&layout.header, data, sizeof(BinaryHeader));
+  BinaryHeader const &header = layout.header;
+  if (std::memcmp(header.magic, binary_magic, 8) != 0 ||
+      header.byte_order != binary_byte_order ||
+      header.version != binary_version) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: not a compatible binary "
+        "configuration file: " +
+        path);
+  }
+
+  // read DoF table (names are checked after the string table is located)
+  std::uint64_t n_dof = checked_add(header.n_global_dof, header.n_local_dof);
+  std::uint64_t dof_table = align8(sizeof(BinaryHeader));
+  if (checked_mul(n_dof, sizeof(BinaryDoF)) > m_size - dof_table) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: truncated file " + path);
+  }
+  std::vector<BinaryDoF> dofs(n_dof);
+  std::memcpy(dofs.data(), data + dof_table, n_dof * sizeof(BinaryDoF));
+  for (std::uint64_t i = 0; i < n_dof; ++i) {
+    if (i < header.n_global_dof) {
+      layout.dof_info.global_dof_dim.push_back(dofs[i].dim);
+    } else {
+      layout.dof_info.local_dof_dim.push_back(dofs[i].dim);
+    }
+  }
+  layout.make_offsets();
+  if (layout.total_size > m_size) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: truncated file " + path);
+  }
+  for (std::uint64_t i = 0; i < n_dof; ++i) {
+    DoFKey name = _string(dofs[i].name.offset, dofs[i].name.size);
+    if (i < header.n_global_dof) {
+      layout.dof_info.global_dof_name.push_back(name);
+    } else {
+      layout.dof_info.local_dof_name.push_back(name);
+    }
+  }
+  throw_if_inconsistent(layout.dof_info, *m_prim, "MappedConfigurationSet",
+                        path);
+}
+
+MappedConfigurationSet::~MappedConfigurationSet() {
+  if (m_data != nullptr) {
+    ::munmap(m_data, m_size);
+  }
+}
+
+/// \brief The prim
+std::shared_ptr<Prim const> const &MappedConfigurationSet::prim() const {
+  return m_prim;
+}
+
+/// \brief Number of supercells in the supercell table
+Index MappedConfigurationSet::n_supercells() const {
+  return m_supercells->size();
+}
+
+/// \brief Return a supercell from the supercell table
+///
+/// Supercells are constructed with `make_shared_supercell` the first time
+/// they are requested.
+std::shared_ptr<Supercell const> MappedConfigurationSet::supercell(
+    Index supercell_index) const {
+  return m_supercells->supercell(supercell_index, "MappedConfigurationSet");
+}
+
+/// \brief Number of configuration records
+Index MappedConfigurationSet::size() const {
+  return m_layout->header.n_records;
+}
+
+namespace {
+
+BinaryRecord read_record(char const *data, std::uint64_t record_table,
+                         Index record_index, Index size) {
+  if (record_index < 0 || record_index >= size) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: invalid record index");
+  }
+  BinaryRecord record;
+  std::memcpy(&record,
+              data + record_table + record_index * sizeof(BinaryRecord),
+              sizeof(BinaryRecord));
+  return record;
+}
+
+}  // namespace
+
+/// \brief Return the supercell table index of a record
+Index MappedConfigurationSet::supercell_index(Index record_index) const {
+  return read_record(static_cast<char const *>(m_data),
+                     m_layout->record_table, record_index, size())
+      .supercell_index;
+}
+
+/// \brief Return the supercell_name of a record
+std::string MappedConfigurationSet::supercell_name(Index record_index) const {
+  BinaryRecord record = read_record(static_cast<char const *>(m_data),
+                                    m_layout->record_table, record_index,
+                                    size());
+  return _string(record.supercell_name.offset, record.supercell_name.size);
+}
+
+/// \brief Return the configuration_id of a record
+std::string MappedConfigurationSet::configuration_id(
+    Index record_index) const {
+  BinaryRecord record = read_record(static_cast<char const *>(m_data),
+                                    m_layout->record_table, record_index,
+                                    size());
+  return _string(record.configuration_id.offset,
+                 record.configuration_id.size);
+}
+
+/// \brief Return the configuration of a record
+///
+/// DoF values are copied from the mapped columns.
+Configuration MappedConfigurationSet::configuration(Index record_index) const {
+  char const *data = static_cast<char const *>(m_data);
+  Layout const &layout = *m_layout;
+  BinaryRecord record =
+      read_record(data, layout.record_table, record_index, size());
+  auto _supercell = supercell(record.supercell_index);
+  Index basis_size = m_prim->basicstructure->basis().size();
+  Index n_sites = supercell_n_sites(
+      _supercell->superlattice.transformation_matrix_to_super(), basis_size);
+  if (record.site_offset > layout.header.n_sites ||
+      n_sites > layout.header.n_sites - record.site_offset) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: invalid record site offset");
+  }
+
+  Configuration configuration(_supercell);
+  clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
+
+  typedef Eigen::Matrix<std::int32_t, Eigen::Dynamic, 1> OccupationColumn;
+  std::int32_t const *occ_begin =
+      reinterpret_cast<std::int32_t const *>(data + layout.occupation_column) +
+      record.site_offset;
+  dof_values.occupation =
+      Eigen::Map<OccupationColumn const>(occ_begin, n_sites).cast<int>();
+
+  DoFTable const &dof_info = layout.dof_info;
+  for (Index i = 0; i < dof_info.global_dof_name.size(); ++i) {
+    Index dim = dof_info.global_dof_dim[i];
+    double const *begin = reinterpret_cast<double const *>(
+                              data + layout.global_dof_column[i]) +
+                          record_index * dim;
+    dof_values.global_dof_values[dof_info.global_dof_name[i]] =
+        Eigen::Map<Eigen::VectorXd const>(begin, dim);
+  }
+
+  for (Index i = 0; i < dof_info.local_dof_name.size(); ++i) {
+    Index dim = dof_info.local_dof_dim[i];
+    double const *begin = reinterpret_cast<double const *>(
+                              data + layout.local_dof_column[i]) +
+                          record.site_offset * dim;
+    dof_values.local_dof_values[dof_info.local_dof_name[i]] =
+        Eigen::Map<Eigen::MatrixXd const>(begin, dim, n_sites);
+  }
+  return configuration;
+}
+
+/// \brief Return a record
+ConfigurationRecord MappedConfigurationSet::record(Index record_index) const {
+  return ConfigurationRecord(configuration(record_index),
+                             supercell_name(record_index),
+                             configuration_id(record_index));
+}
+
+/// \brief IDs, by supercell_name, used to automatically ID new
+///     configurations
+std::map<std::string, Index> MappedConfigurationSet::next_config_id() const {
+  char const *data = static_cast<char const *>(m_data);
+  Layout const &layout = *m_layout;
+  std::map<std::string, Index> result;
+  for (std::uint64_t i = 0; i < layout.header.n_next_config_id; ++i) {
+    BinaryNextConfigId value;
+    std::memcpy(&value,
+                data + layout.next_config_id_table +
+                    i * sizeof(BinaryNextConfigId),
+                sizeof(BinaryNextConfigId));
+    result.emplace(
+        _string(value.supercell_name.offset, value.supercell_name.size),
+        value.next_id);
+  }
+  return result;
+}
+
+std::string MappedConfigurationSet::_string(std::uint64_t offset,
+                                            std::uint64_t size) const {
+  std::uint64_t string_table_size = m_layout->header.string_table_size;
+  if (offset > string_table_size || size > string_table_size - offset) {
+    throw std::runtime_error(
+        "Error in MappedConfigurationSet: invalid string table offset");
+  }
+  return std::string(
+      static_cast<char const *>(m_data) + m_layout->string_table + offset,
+      size);
+}
+
+}  // namespace config
+
+namespace {
+
+/// Collects strings for the string table
+struct StringTableWriter {
+  std::string data;
+
+  BinaryString add(std::string const &value) {
+    BinaryString result{data.size(), value.size()};
+    data += value;
+    return result;
+  }
+};
+
+template <typename T>
+void write_values(std::ofstream &out, T const *values, std::uint64_t n) {
+  out.write(reinterpret_cast<char const *>(values), n * sizeof(T));
+}
+
+void write_padding(std::ofstream &out) {
+  std::uint64_t offset = out.tellp();
+  static char const zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  out.write(zeros, align8(offset) - offset);
+}
+
+}  // namespace
+
+/// \brief Write supercells and configurations to a binary configuration file
+///
+/// The supercell table includes all supercells in `supercells`, in order,
+/// followed by any other supercells of configurations in `configurations`.
+/// See MappedConfigurationSet for the file format.
+///
+/// \param supercells Supercells to write
+/// \param configurations Configurations to write. All must have the same
+///     prim as `supercells`.
+/// \param path Output file path
+void to_binary(config::SupercellSet const &supercells,
+               config::ConfigurationSet const &configurations,
+               std::string const &path) {
+  auto const &prim = *supercells.prim();
+  Index basis_size = prim.basicstructure->basis().size();
+  using config::MappedConfigurationSet;
+  MappedConfigurationSet::Layout layout;
+  StringTableWriter strings;
+
+  // DoF table
+  DoFTable &dof_info = layout.dof_info;
+  dof_info = make_dof_table(prim);
+  std::vector<BinaryDoF> dofs;
+  for (Index i = 0; i < dof_info.global_dof_name.size(); ++i) {
+    dofs.push_back({strings.add(dof_info.global_dof_name[i]),
+                    std::uint64_t(dof_info.global_dof_dim[i])});
+  }
+  for (Index i = 0; i < dof_info.local_dof_name.size(); ++i) {
+    dofs.push_back({strings.add(dof_info.local_dof_name[i]),
+                    std::uint64_t(dof_info.local_dof_dim[i])});
+  }
+
+  // supercell table
+  SupercellTableWriter supercell_table;
+  for (auto const &record : supercells) {
+    supercell_table.add(*record.supercell);
+  }
+
+  // record table
+  std::vector<BinaryRecord> records;
+  std::uint64_t n_sites = 0;
+  for (auto const &record : configurations) {
+    config::Configuration const &configuration = record.configuration;
+    if (configuration.supercell->prim->basicstructure->basis().size() !=
+        basis_size) {
+      throw std::runtime_error(
+          "Error in to_binary: configurations and supercells have "
+          "inconsistent prim");
+    }
+    records.push_back({supercell_table.add(*configuration.supercell), n_sites,
+                       strings.add(record.supercell_name),
+                       strings.add(record.configuration_id)});
+    n_sites += configuration.dof_values.occupation.size();
+  }
+
+  // next config id table
+  std::vector<BinaryNextConfigId> next_config_id;
+  for (auto const &value : configurations.next_config_id()) {
+    next_config_id.push_back({strings.add(value.first), value.second});
+  }
+
+  BinaryHeader &header = layout.header;
+  std::memset(&header, 0, sizeof(BinaryHeader));
+  std::memcpy(header.magic, binary_magic, 8);
+  header.byte_order = binary_byte_order;
+  header.version = binary_version;
+  header.n_supercells = supercell_table.size();
+  header.n_records = records.size();
+  header.n_sites = n_sites;
+  header.n_global_dof = dof_info.global_dof_name.size();
+  header.n_local_dof = dof_info.local_dof_name.size();
+  header.n_next_config_id = next_config_id.size();
+  header.string_table_size = strings.data.size();
+  layout.make_offsets();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Error in to_binary: could not open " + path);
+  }
+  write_values(out, &header, 1);
+  write_padding(out);
+  write_values(out, dofs.data(), dofs.size());
+  for (Eigen::Matrix3l const &T : supercell_table.transformation_matrices()) {
+    Eigen::Matrix<std::int64_t, 3, 3, Eigen::RowMajor> values =
+        T.cast<std::int64_t>();
+    write_values(out, values.data(), 9);
+  }
+  write_values(out, records.data(), records.size());
+  write_values(out, next_config_id.data(), next_config_id.size());
+
+  for (Index i = 0; i < dof_info.global_dof_name.size(); ++i) {
+    DoFKey const &key = dof_info.global_dof_name[i];
+    Index dim = dof_info.global_dof_dim[i];
+    for (auto const &record : configurations) {
+      Eigen::VectorXd const &values =
+          record.configuration.dof_values.global_dof_values.at(key);
+      if (values.size() != dim) {
+        throw std::runtime_error(
+            "Error in to_binary: global DoF values have inconsistent size");
+      }
+      write_values(out, values.data(), dim);
+    }
+  }
+
+  for (Index i = 0; i < dof_info.local_dof_name.size(); ++i) {
+    DoFKey const &key = dof_info.local_dof_name[i];
+    Index dim = dof_info.local_dof_dim[i];
+    for (auto const &record : configurations) {
+      clexulator::ConfigDoFValues const &dof_values =
+          record.configuration.dof_values;
+      Eigen::MatrixXd const &values = dof_values.local_dof_values.at(key);
+      if (values.rows() != dim ||
+          values.cols() != dof_values.occupation.size()) {
+        throw std::runtime_error(
+            "Error in to_binary: local DoF values have inconsistent size");
+      }
+      write_values(out, values.data(), values.size());
+    }
+  }
+
+  for (auto const &record : configurations) {
+    Eigen::Matrix<std::int32_t, Eigen::Dynamic, 1> occupation =
+        record.configuration.dof_values.occupation.cast<std::int32_t>();
+    write_values(out, occupation.data(), occupation.size());
+  }
+  write_padding(out);
+  out.write(strings.data.data(), strings.data.size());
+
+  if (!out || std::uint64_t(out.tellp()) != layout.total_size) {
+    throw std::runtime_error("Error in to_binary: could not write " + path);
+  }
+}
+
+/// \brief Read all supercells and configurations from a binary configuration
+///     file
+///
+/// Equivalent to `from_json` for the JSON format, except that DoF values
+/// are not validated record by record. The DoF types and dimensions are
+/// checked against `prim` once, when the file is opened.
+///
+/// \param supercells All supercells in the supercell table are inserted
+/// \param configurations Cleared, then all records are inserted, and
+///     `next_config_id` is set
+/// \param path Path to a file written by `to_binary`
+/// \param prim The prim
+void from_binary(config::SupercellSet &supercells,
+                 config::ConfigurationSet &configurations,
+                 std::string const &path,
+                 std::shared_ptr<config::Prim const> const &prim) {
+  config::MappedConfigurationSet mapped(path, prim);
+  read_all(supercells, configurations, mapped);
+}
+
+}  // namespace CASM
@@ -0,0 +1,735 @@
+#include "casm/configuration/io/binary/ConfigurationSet_compressed_io.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/io/binary/binary_io_impl.hh"
+
+namespace CASM {
+
+namespace compressed_io_impl {
+
+char const compressed_magic[8] = {'C', 'A', 'S', 'M', 'C', 'F', 'G', 'Z'};
+std::uint64_t const compressed_byte_order = 0x0102030405060708ULL;
+std::uint64_t const compressed_version = 1;
+
+/// Maximum compression ratio of zlib's deflate, used to check sizes read from
+/// a file before allocating buffers for decompression
+std::uint64_t const max_zlib_ratio = 1032;
+
+struct CompressedHeader {
+  char magic[8];
+  std::uint64_t byte_order;
+  std::uint64_t version;
+  std::uint64_t block_size;
+  std::uint64_t n_records;
+  std::uint64_t n_blocks;
+  std::uint64_t metadata_size;
+  std::uint64_t metadata_compressed_size;
+  std::uint64_t block_index_offset;
+};
+
+struct CompressedBlockInfo {
+  std::uint64_t offset;
+  std::uint64_t compressed_size;
+  std::uint64_t uncompressed_size;
+};
+
+/// \brief Append values to a byte buffer
+struct ByteWriter {
+  std::string data;
+
+  /// Write unsigned LEB128 variable-length integer
+  void write_varint(std::uint64_t value) {
+    while (value >= 0x80) {
+      data.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    data.push_back(static_cast<char>(value));
+  }
+
+  /// Write zigzag-encoded signed variable-length integer
+  void write_signed(std::int64_t value) {
+    write_varint((static_cast<std::uint64_t>(value) << 1) ^
+                 static_cast<std::uint64_t>(value >> 63));
+  }
+
+  void write_string(std::string const &value) {
+    write_varint(value.size());
+    data += value;
+  }
+
+  void write_doubles(double const *values, Index n) {
+    data.append(reinterpret_cast<char const *>(values), n * sizeof(double));
+  }
+};
+
+/// \brief Read values from a byte buffer, throwing if it is too short
+struct ByteReader {
+  ByteReader(std::string const &_data) : data(_data), pos(0) {}
+
+  std::string const &data;
+  std::size_t pos;
+
+  std::uint64_t read_varint() {
+    std::uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      unsigned char c = _next();
+      result |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+      if (!(c & 0x80)) {
+        return result;
+      }
+    }
+    throw _corrupt();
+  }
+
+  std::int64_t read_signed() {
+    std::uint64_t value = read_varint();
+    return static_cast<std::int64_t>(value >> 1) ^
+           -static_cast<std::int64_t>(value & 1);
+  }
+
+  std::string read_string() {
+    std::uint64_t size = read_varint();
+    _check(size);
+    std::string result = data.substr(pos, size);
+    pos += size;
+    return result;
+  }
+
+  void read_doubles(double *values, Index n) {
+    _check(n * sizeof(double));
+    std::memcpy(values, data.data() + pos, n * sizeof(double));
+    pos += n * sizeof(double);
+  }
+
+ private:
+  unsigned char _next() {
+    _check(1);
+    return static_cast<unsigned char>(data[pos++]);
+  }
+
+  void _check(std::uint64_t size) const {
+    if (size > data.size() - pos) {
+      throw _corrupt();
+    }
+  }
+
+  static std::runtime_error _corrupt() {
+    return std::runtime_error(
+        "Error in CompressedConfigurationSet: corrupt block");
+  }
+};
+
+std::string zlib_compress(std::string const &data, int level) {
+  uLongf size = compressBound(data.size());
+  std::string result(size, '\0');
+  int status = compress2(reinterpret_cast<Bytef *>(&result[0]), &size,
+                         reinterpret_cast<Bytef const *>(data.data()),
+                         data.size(), level);
+  if (status != Z_OK) {
+    throw std::runtime_error(
+        "Error in to_compressed_binary: zlib compression failed");
+  }
+  result.resize(size);
+  return result;
+}
+
+std::string zlib_uncompress(std::string const &data,
+                            std::uint64_t uncompressed_size) {
+  std::string result(uncompressed_size, '\0');
+  uLongf size = uncompressed_size;
+  int status = uncompress(reinterpret_cast<Bytef *>(&result[0]), &size,
+                          reinterpret_cast<Bytef const *>(data.data()),
+                          data.size());
+  if (status != Z_OK || size != uncompressed_size) {
+    throw std::runtime_error(
+        "Error in CompressedConfigurationSet: zlib decompression failed");
+  }
+  return result;
+}
+
+/// \brief Delta and run-length encode occupation
+///
+/// \param previous Occupation of the previous record in the block, if it is
+///     in the same supercell, else nullptr
+void write_occupation(ByteWriter &out, Eigen::VectorXi const &occupation,
+                      Eigen::VectorXi const *previous) {
+  bool delta = (previous != nullptr);
+  auto value_at = [&](Index l) {
+    return delta ? occupation[l] - (*previous)[l] : occupation[l];
+  };
+  out.write_varint(delta ? 1 : 0);
+  Index n_sites = occupation.size();
+  Index l = 0;
+  while (l < n_sites) {
+    int value = value_at(l);
+    Index run = 1;
+    while (l + run < n_sites && value_at(l + run) == value) {
+      ++run;
+    }
+    out.write_signed(value);
+    out.write_varint(run);
+    l += run;
+  }
+}
+
+/// \brief Decode occupation written by `write_occupation`
+Eigen::VectorXi read_occupation(ByteReader &in, Index n_sites,
+                                Eigen::VectorXi const *previous) {
+  bool delta = (in.read_varint() != 0);
+  if (delta && (previous == nullptr || previous->size() != n_sites)) {
+    throw std::runtime_error(
+        "Error in CompressedConfigurationSet: corrupt occupation");
+  }
+  Eigen::VectorXi occupation(n_sites);
+  Index l = 0;
+  while (l < n_sites) {
+    int value = in.read_signed();
+    std::uint64_t run = in.read_varint();
+    if (run == 0 || run > std::uint64_t(n_sites - l)) {
+      throw std::runtime_error(
+          "Error in CompressedConfigurationSet: corrupt occupation");
+    }
+    for (Index end = l + run; l < end; ++l) {
+      occupation[l] = delta ? (*previous)[l] + value : value;
+    }
+  }
+  return occupation;
+}
+
+}  // namespace compressed_io_impl
+
+using namespace binary_io_impl;
+using namespace compressed_io_impl;
+
+namespace config {
+
+/// \brief Header, metadata, and block index of a block-compressed
+///     configuration file
+struct CompressedConfigurationSet::Layout {
+  CompressedHeader header;
+  DoFTable dof_info;
+  std::vector<Eigen::Matrix3l> transformation_matrix;
+  std::map<std::string, Index> next_config_id;
+  std::vector<CompressedBlockInfo> block_index;
+
+  /// Encode metadata
+  std::string write_metadata() const {
+    ByteWriter out;
+    out.write_varint(dof_info.global_dof_name.size());
+    for (Index i = 0; i < dof_info.global_dof_name.size(); ++i) {
+      out.write_string(dof_info.global_dof_name[i]);
+      out.write_varint(dof_info.global_dof_dim[i]);
+    }
+    out.write_varint(dof_info.local_dof_name.size());
+    for (Index i = 0; i < dof_info.local_dof_name.size(); ++i) {
+      out.write_string(dof_info.local_dof_name[i]);
+      out.write_varint(dof_info.local_dof_dim[i]);
+    }
+    out.write_varint(transformation_matrix.size());
+    for (auto const &T : transformation_matrix) {
+      for (Index i = 0; i < 3; ++i) {
+        for (Index j = 0; j < 3; ++j) {
+          out.write_signed(T(i, j));
+        }
+      }
+    }
+    out.write_varint(next_config_id.size());
+    for (auto const &value : next_config_id) {
+      out.write_string(value.first);
+      out.write_signed(value.second);
+    }
+    return out.data;
+  }
+
+  /// Decode metadata
+  void read_metadata(std::string const &data) {
+    ByteReader in(data);
+    std::uint64_t n_global_dof = in.read_varint();
+    for (std::uint64_t i = 0; i < n_global_dof; ++i) {
+      dof_info.global_dof_name.push_back(in.read_string());
+      dof_info.global_dof_dim.push_back(in.read_varint());
+    }
+    std::uint64_t n_local_dof = in.read_varint();
+    for (std::uint64_t i = 0; i < n_local_dof; ++i) {
+      dof_info.local_dof_name.push_back(in.read_string());
+      dof_info.local_dof_dim.push_back(in.read_varint());
+    }
+    std::uint64_t n_supercells = in.read_varint();
+    for (std::uint64_t k = 0; k < n_supercells; ++k) {
+      Eigen::Matrix3l T;
+      for (Index i = 0; i < 3; ++i) {
+        for (Index j = 0; j < 3; ++j) {
+          T(i, j) = in.read_signed();
+        }
+      }
+      transformation_matrix.push_back(T);
+    }
+    std::uint64_t n_next_config_id = in.read_varint();
+    for (std::uint64_t i = 0; i < n_next_config_id; ++i) {
+      std::string supercell_name = in.read_string();
+      next_config_id.emplace(supercell_name, in.read_signed());
+    }
+  }
+};
+
+/// \brief Open a block-compressed configuration file
+///
+/// \param path Path to a file written by `to_compressed_binary`
+/// \param prim The prim. Must have the same DoF types and dimensions as the
+///     prim of the configurations that were written.
+///
+/// Throws if the file cannot be read, or if the header, metadata, or block
+/// index are not consistent with each other, the file size, or `prim`. Sizes
+/// read from the file are checked before buffers are allocated for them.
+CompressedConfigurationSet::CompressedConfigurationSet(
+    std::string const &path, std::shared_ptr<Prim const> const &prim)
+    : m_path(path),
+      m_prim(prim),
+      m_layout(std::make_unique<Layout>()),
+      m_block_index(-1) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error(
+        "Error in CompressedConfigurationSet: could not open " + path);
+  }
+  std::uint64_t file_size = in.tellg();
+  in.seekg(0);
+  Layout &layout = *m_layout;
+  CompressedHeader &header = layout.header;
+  in.read(reinterpret_cast<char *>(&header), sizeof(CompressedHeader));
+  if (!in || std::memcmp(header.magic, compressed_magic, 8) != 0 ||
+      header.byte_order != compressed_byte_order ||
+      header.version != compressed_version || header.block_size == 0 ||
+      header.n_blocks != header.n_records / header.block_size +
+                             (header.n_records % header.block_size != 0)) {
+    throw std::runtime_error(
+        "Error in CompressedConfigurationSet: not a compatible "
+        "block-compressed configuration file: " +
+        path);
+  }
+
+  // metadata is followed by blocks, then by the block index, which ends
+  // the file
+  auto truncated_error = [&]() {
+    return std::runtime_error(
+        "Error in CompressedConfigurationSet: truncated or corrupt file " +
+        path);
+  };
+  std::uint64_t metadata_end = sizeof(CompressedHeader);
+  if (header.metadata_compressed_size > file_size - metadata_end ||
+      header.metadata_size / max_zlib_ratio >
+          header.metadata_compressed_size) {
+    throw truncated_error();
+  }
+  metadata_end += header.metadata_compressed_size;
+  if (header.block_index_offset < metadata_end ||
+      header.block_index_offset > file_size ||
+      header.n_blocks != (file_size - header.block_index_offset) /
+                             sizeof(CompressedBlockInfo) ||
+      (file_size - header.block_index_offset) % sizeof(CompressedBlockInfo)) {
+    throw truncated_error();
+  }
+
+  std::string metadata(header.metadata_compressed_size, '\0');
+  in.read(&metadata[0], metadata.size());
+  layout.block_index.resize(header.n_blocks);
+  in.seekg(header.block_index_offset);
+  in.read(reinterpret_cast<char *>(layout.block_index.data()),
+          layout.block_index.size() * sizeof(CompressedBlockInfo));
+  if (!in) {
+    throw truncated_error();
+  }
+
+  // blocks must lie between the metadata and the block index, and each
+  // decompressed block has at least one byte per record
+  for (std::uint64_t b = 0; b < header.n_blocks; ++b) {
+    CompressedBlockInfo const &info = layout.block_index[b];
+    std::uint64_t n_block_records =
+        std::min(header.block_size, header.n_records - b * header.block_size);
+    if (info.offset < metadata_end ||
+        info.offset > header.block_index_offset ||
+        info.compressed_size > header.block_index_offset - info.offset ||
+        info.uncompressed_size / max_zlib_ratio > info.compressed_size ||
+        info.uncompressed_size < n_block_records) {
+      throw truncated_error();
+    }
+  }
+
+  layout.read_metadata(zlib_uncompress(metadata, header.metadata_size));
+  throw_if_inconsistent(layout.dof_info, *m_prim, "CompressedConfigurationSet",
+                        path);
+  m_supercells = std::make_unique<SupercellTableReader>(
+      m_prim, layout.transformation_matrix.size(),
+      [this](Index supercell_index) {
+        return m_layout->transformation_matrix[supercell_index];
+      });
+}
+
+CompressedConfigurationSet::~CompressedConfigurationSet() {}
+
+/// \brief The prim
+std::shared_ptr<Prim const> const &CompressedConfigurationSet::prim() const {
+  return m_prim;
+}
+
+/// \brief Number of supercells in the supercell table
+Index CompressedConfigurationSet::n_supercells() const {
+  return m_supercells->size();
+}
+
+/// \brief Return a supercell from the supercell table
+///
+/// Supercells are constructed with `make_shared_supercell` the first time
+/// they are requested.
+std::shared_ptr<Supercell const> CompressedConfigurationSet::supercell(
+    Index supercell_index) const {
+  return m_supercells->supercell(supercell_index,
+                                 "CompressedConfigurationSet");
+}
+
+/// \brief Number of configuration records
+Index CompressedConfigurationSet::size() const {
+  return m_layout->header.n_records;
+}
+
+/// \brief Maximum number of records per block
+Index CompressedConfigurationSet::block_size() const {
+  return m_layout->header.block_size;
+}
+
+/// \brief Number of blocks
+Index CompressedConfigurationSet::n_blocks() const {
+  return m_layout->header.n_blocks;
+}
+
+/// \brief Return all records in a block
+///
+/// Records `block_index * block_size()` up to, but not including,
+/// `min((block_index + 1) * block_size(), size())`.
+std::vector<ConfigurationRecord> CompressedConfigurationSet::block(
+    Index block_index) const {
+  return *_block(block_index);
+}
+
+/// \brief Return a record
+///
+/// Only the block containing the record is read and decompressed.
+ConfigurationRecord CompressedConfigurationSet::record(
+    Index record_index) const {
+  if (record_index < 0 || record_index >= size()) {
+    throw std::runtime_error(
+        "Error in CompressedConfigurationSet::record: invalid index");
+  }
+  Index block_index = record_index / block_size();
+  return _block(block_index)->at(record_index - block_index * block_size());
+}
+
+/// \brief IDs, by supercell_name, used to automatically ID new
+///     configurations
+std::map<std::string, Index> const &
+CompressedConfigurationSet::next_config_id() const {
+  return m_layout->next_config_id;
+}
+
+/// \brief Return a block, re-using the most recently read block if possible
+std::shared_ptr<std::vector<ConfigurationRecord> const>
+CompressedConfigurationSet::_block(Index block_index) const {
+  if (block_index < 0 || block_index >= n_blocks()) {
+    throw std::runtime_error(
+        "Error in CompressedConfigurationSet::block: invalid index");
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_block_mutex);
+    if (m_block_index == block_index) {
+      return m_block;
+    }
+  }
+  auto result = std::make_shared<std::vector<ConfigurationRecord> const>(
+      _read_block(block_index));
+  std::lock_guard<std::mutex> lock(m_block_mutex);
+  m_block_index = block_index;
+  m_block = result;
+  return result;
+}
+
+/// \brief Read, decompress, and decode a block
+std::vector<ConfigurationRecord> CompressedConfigurationSet::_read_block(
+    Index block_index) const {
+  Layout const &layout = *m_layout;
+  CompressedBlockInfo const &info = layout.block_index[block_index];
+  std::string compressed(info.compressed_size, '\0');
+  {
+    std::ifstream in(m_path, std::ios::binary);
+    in.seekg(info.offset);
+    in.read(&compressed[0], compressed.size());
+    if (!in) {
+      throw std::runtime_error(
+          "Error in CompressedConfigurationSet: could not read block from " +
+          m_path);
+    }
+  }
+  std::string data = zlib_uncompress(compressed, info.uncompressed_size);
+  ByteReader in(data);
+
+  Index begin = block_index * block_size();
+  Index n = std::min(block_size(), size() - begin);
+  Index basis_size = m_prim->basicstructure->basis().size();
+
+  // supercells and names
+  std::vector<std::shared_ptr<Supercell const>> supercells;
+  std::vector<std::string> supercell_names;
+  std::vector<std::string> configuration_ids;
+  for (Index i = 0; i < n; ++i) {
+    std::uint64_t supercell_index = in.read_varint();
+    if (supercell_index >= std::uint64_t(n_supercells())) {
+      throw std::runtime_error(
+          "Error in CompressedConfigurationSet: invalid supercell index");
+    }
+    supercells.push_back(supercell(supercell_index));
+    supercell_names.push_back(in.read_string());
+    configuration_ids.push_back(in.read_string());
+  }
+
+  // occupation
+  std::vector<Configuration> configurations;
+  configurations.reserve(n);
+  for (Index i = 0; i < n; ++i) {
+    configurations.emplace_back(supercells[i]);
+    Index n_sites =
+        supercells[i]->unitcell_index_converter.total_sites() * basis_size;
+    Eigen::VectorXi const *previous = nullptr;
+    if (i > 0 && supercells[i] == supercells[i - 1]) {
+      previous = &configurations[i - 1].dof_values.occupation;
+    }
+    configurations[i].dof_values.occupation =
+        read_occupation(in, n_sites, previous);
+  }
+
+  // global DoF
+  DoFTable const &dof_info = layout.dof_info;
+  for (Index k = 0; k < dof_info.global_dof_name.size(); ++k) {
+    for (Index i = 0; i < n; ++i) {
+      clexulator::ConfigDoFValues &dof_values = configurations[i].dof_values;
+      Eigen::VectorXd values(dof_info.global_dof_dim[k]);
+      in.read_doubles(values.data(), values.size());
+      dof_values.global_dof_values[dof_info.global_dof_name[k]] = values;
+    }
+  }
+
+  // local DoF
+  for (Index k = 0; k < dof_info.local_dof_name.size(); ++k) {
+    for (Index i = 0; i < n; ++i) {
+      clexulator::ConfigDoFValues &dof_values = configurations[i].dof_values;
+      Eigen::MatrixXd values(dof_info.local_dof_dim[k],
+                             dof_values.occupation.size());
+      in.read_doubles(values.data(), values.size());
+      dof_values.local_dof_values[dof_info.local_dof_name[k]] = values;
+    }
+  }
+
+  std::vector<ConfigurationRecord> result;
+  result.reserve(n);
+  for (Index i = 0; i < n; ++i) {
+    result.emplace_back(configurations[i], supercell_names[i],
+                        configuration_ids[i]);
+  }
+  return result;
+}
+
+}  // namespace config
+
+namespace {
+
+/// \brief Encode a block of records
+std::string write_block(
+    std::vector<config::ConfigurationRecord const *> const &records,
+    std::vector<std::uint64_t> const &supercell_index,
+    config::CompressedConfigurationSet::Layout const &layout) {
+  ByteWriter out;
+  for (Index i = 0; i < records.size(); ++i) {
+    out.write_varint(supercell_index[i]);
+    out.write_string(records[i]->supercell_name);
+    out.write_string(records[i]->configuration_id);
+  }
+
+  for (Index i = 0; i < records.size(); ++i) {
+    Eigen::VectorXi const *previous = nullptr;
+    if (i > 0 && supercell_index[i] == supercell_index[i - 1]) {
+      previous = &records[i - 1]->configuration.dof_values.occupation;
+    }
+    write_occupation(out, records[i]->configuration.dof_values.occupation,
+                     previous);
+  }
+
+  DoFTable const &dof_info = layout.dof_info;
+  for (Index k = 0; k < dof_info.global_dof_name.size(); ++k) {
+    for (auto const *record : records) {
+      Eigen::VectorXd const &values =
+          record->configuration.dof_values.global_dof_values.at(
+              dof_info.global_dof_name[k]);
+      if (values.size() != dof_info.global_dof_dim[k]) {
+        throw std::runtime_error(
+            "Error in to_compressed_binary: global DoF values have "
+            "inconsistent size");
+      }
+      out.write_doubles(values.data(), values.size());
+    }
+  }
+
+  for (Index k = 0; k < dof_info.local_dof_name.size(); ++k) {
+    for (auto const *record : records) {
+      clexulator::ConfigDoFValues const &dof_values =
+          record->configuration.dof_values;
+      Eigen::MatrixXd const &values =
+          dof_values.local_dof_values.at(dof_info.local_dof_name[k]);
+      if (values.rows() != dof_info.local_dof_dim[k] ||
+          values.cols() != dof_values.occupation.size()) {
+        throw std::runtime_error(
+            "Error in to_compressed_binary: local DoF values have "
+            "inconsistent size");
+      }
+      out.write_doubles(values.data(), values.size());
+    }
+  }
+  return out.data;
+}
+
+}  // namespace
+
+/// \brief Write supercells and configurations to a block-compressed
+///     configuration file
+///
+/// The supercell table includes all supercells in `supercells`, in order,
+/// followed by any other supercells of configurations in `configurations`.
+/// See CompressedConfigurationSet for the file format.
+///
+/// \param supercells Supercells to write
+/// \param configurations Configurations to write. All must have the same
+///     prim as `supercells`.
+/// \param path Output file path
+/// \param block_size Number of records per block. Larger blocks compress
+///     better, smaller blocks are faster to access randomly.
+/// \param compression_level zlib compression level, 0-9, or -1 for the zlib
+///     default
+void to_compressed_binary(config::SupercellSet const &supercells,
+                          config::ConfigurationSet const &configurations,
+                          std::string const &path, Index block_size,
+                          int compression_level) {
+  if (block_size < 1) {
+    throw std::runtime_error(
+        "Error in to_compressed_binary: block_size must be >= 1");
+  }
+  auto const &prim = *supercells.prim();
+  Index basis_size = prim.basicstructure->basis().size();
+  config::CompressedConfigurationSet::Layout layout;
+  layout.dof_info = make_dof_table(prim);
+
+  // supercell table
+  SupercellTableWriter supercell_table;
+  for (auto const &record : supercells) {
+    supercell_table.add(*record.supercell);
+  }
+  std::vector<std::uint64_t> record_supercell_index;
+  for (auto const &record : configurations) {
+    config::Configuration const &configuration = record.configuration;
+    if (configuration.supercell->prim->basicstructure->basis().size() !=
+        basis_size) {
+      throw std::runtime_error(
+          "Error in to_compressed_binary: configurations and supercells "
+          "have inconsistent prim");
+    }
+    record_supercell_index.push_back(
+        supercell_table.add(*configuration.supercell));
+  }
+  layout.transformation_matrix = supercell_table.transformation_matrices();
+  layout.next_config_id = configurations.next_config_id();
+
+  std::string metadata = layout.write_metadata();
+  std::string compressed_metadata =
+      zlib_compress(metadata, compression_level);
+
+  CompressedHeader &header = layout.header;
+  std::memset(&header, 0, sizeof(CompressedHeader));
+  std::memcpy(header.magic, compressed_magic, 8);
+  header.byte_order = compressed_byte_order;
+  header.version = compressed_version;
+  header.block_size = block_size;
+  header.n_records = configurations.size();
+  header.n_blocks = (header.n_records + block_size - 1) / block_size;
+  header.metadata_size = metadata.size();
+  header.metadata_compressed_size = compressed_metadata.size();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Error in to_compressed_binary: could not open " +
+                             path);
+  }
+  out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  out.write(compressed_metadata.data(), compressed_metadata.size());
+
+  // blocks
+  std::vector<config::ConfigurationRecord const *> block;
+  std::vector<std::uint64_t> block_supercell_index;
+  auto write_current_block = [&]() {
+    std::string data = write_block(block, block_supercell_index, layout);
+    std::string compressed = zlib_compress(data, compression_level);
+    layout.block_index.push_back({std::uint64_t(out.tellp()),
+                                  compressed.size(), data.size()});
+    out.write(compressed.data(), compressed.size());
+    block.clear();
+    block_supercell_index.clear();
+  };
+  Index i = 0;
+  for (auto const &record : configurations) {
+    block.push_back(&record);
+    block_supercell_index.push_back(record_supercell_index[i++]);
+    if (block.size() == block_size) {
+      write_current_block();
+    }
+  }
+  if (!block.empty()) {
+    write_current_block();
+  }
+
+  // block index, then complete header
+  header.block_index_offset = out.tellp();
+  out.write(reinterpret_cast<char const *>(layout.block_index.data()),
+            layout.block_index.size() * sizeof(CompressedBlockInfo));
+  out.seekp(0);
+  out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  if (!out) {
+    throw std::runtime_error("Error in to_compressed_binary: could not write " +
+                             path);
+  }
+}
+
+/// \brief Read all supercells and configurations from a block-compressed
+///     configuration file
+///
+/// As for `from_binary`, DoF types and dimensions are checked against `prim`
+/// once, when the file is opened, rather than record by record.
+///
+/// \param supercells All supercells in the supercell table are inserted
+/// \param configurations Cleared, then all records are inserted, and
+///     `next_config_id` is set
+/// \param path Path to a file written by `to_compressed_binary`
+/// \param prim The prim
+void from_compressed_binary(config::SupercellSet &supercells,
+                            config::ConfigurationSet &configurations,
+                            std::string const &path,
+                            std::shared_ptr<config::Prim const> const &prim) {
+  config::CompressedConfigurationSet compressed(path, prim);
+  read_all(supercells, configurations, compressed);
+}
+
+}  // namespace CASM
@@ -0,0 +1,118 @@
+#include "casm/configuration/io/binary/binary_io_impl.hh"
+
+#include <stdexcept>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+
+namespace CASM {
+namespace binary_io_impl {
+
+/// \brief Make the DoF table of a prim
+DoFTable make_dof_table(config::Prim const &prim) {
+  DoFTable dof_table;
+  for (auto const &dof : prim.global_dof_info) {
+    dof_table.global_dof_name.push_back(dof.first);
+    dof_table.global_dof_dim.push_back(dof.second.basis().rows());
+  }
+  for (auto const &dof : prim.local_dof_info) {
+    dof_table.local_dof_name.push_back(dof.first);
+    dof_table.local_dof_dim.push_back(dof.second.front().basis().rows());
+  }
+  return dof_table;
+}
+
+/// \brief Throw if a DoF table read from a file is inconsistent with a prim
+///
+/// \param dof_table DoF table read from a file
+/// \param prim The prim
+/// \param reader_name Class name, for the error message
+/// \param path File path, for the error message
+void throw_if_inconsistent(DoFTable const &dof_table, config::Prim const &prim,
+                           std::string const &reader_name,
+                           std::string const &path) {
+  auto dof_error = [&]() {
+    return std::runtime_error("Error in " + reader_name + ": DoF in " + path +
+                              " are inconsistent with the prim");
+  };
+  if (dof_table.global_dof_name.size() != prim.global_dof_info.size() ||
+      dof_table.local_dof_name.size() != prim.local_dof_info.size() ||
+      dof_table.global_dof_dim.size() != dof_table.global_dof_name.size() ||
+      dof_table.local_dof_dim.size() != dof_table.local_dof_name.size()) {
+    throw dof_error();
+  }
+  for (Index i = 0; i < dof_table.global_dof_name.size(); ++i) {
+    auto it = prim.global_dof_info.find(dof_table.global_dof_name[i]);
+    if (it == prim.global_dof_info.end() ||
+        it->second.basis().rows() != dof_table.global_dof_dim[i]) {
+      throw dof_error();
+    }
+  }
+  for (Index i = 0; i < dof_table.local_dof_name.size(); ++i) {
+    auto it = prim.local_dof_info.find(dof_table.local_dof_name[i]);
+    if (it == prim.local_dof_info.end() ||
+        it->second.front().basis().rows() != dof_table.local_dof_dim[i]) {
+      throw dof_error();
+    }
+  }
+}
+
+/// \brief Return the index of a supercell, adding it if new
+std::uint64_t SupercellTableWriter::add(config::Supercell const &supercell) {
+  Eigen::Matrix3l const &T =
+      supercell.superlattice.transformation_matrix_to_super();
+  auto result = m_index.emplace(T, m_index.size());
+  if (result.second) {
+    m_transformation_matrices.push_back(T);
+  }
+  return result.first->second;
+}
+
+/// \brief Number of supercells added
+Index SupercellTableWriter::size() const {
+  return m_transformation_matrices.size();
+}
+
+/// \brief Transformation matrices, by supercell index
+std::vector<Eigen::Matrix3l> const &
+SupercellTableWriter::transformation_matrices() const {
+  return m_transformation_matrices;
+}
+
+/// \brief Constructor
+///
+/// \param _prim The prim
+/// \param _n_supercells Number of supercells in the supercell table
+/// \param _transformation_matrix Reads the transformation matrix of a
+///     supercell, by supercell index
+SupercellTableReader::SupercellTableReader(
+    std::shared_ptr<config::Prim const> const &_prim, Index _n_supercells,
+    std::function<Eigen::Matrix3l(Index)> _transformation_matrix)
+    : m_prim(_prim),
+      m_transformation_matrix(_transformation_matrix),
+      m_supercells(_n_supercells) {}
+
+/// \brief Number of supercells in the supercell table
+Index SupercellTableReader::size() const { return m_supercells.size(); }
+
+/// \brief Return a supercell, or throw if `supercell_index` is invalid
+///
+/// \param supercell_index Supercell table index
+/// \param reader_name Class name, for the error message
+std::shared_ptr<config::Supercell const> SupercellTableReader::supercell(
+    Index supercell_index, std::string const &reader_name) const {
+  if (supercell_index < 0 || supercell_index >= size()) {
+    throw std::runtime_error("Error in " + reader_name +
+                             "::supercell: invalid index");
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto &supercell = m_supercells[supercell_index];
+  if (supercell == nullptr) {
+    supercell = make_shared_supercell(m_prim,
+                                      m_transformation_matrix(supercell_index));
+  }
+  return supercell;
+}
+
+}  // namespace binary_io_impl
+}  // namespace CASM
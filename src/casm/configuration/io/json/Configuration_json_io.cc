@@ -1,11 +1,15 @@
 #include "casm/configuration/io/json/Configuration_json_io.hh"
 
+#include <istream>
+#include <ostream>
+
 #include "casm/casm_io/Log.hh"
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexulator/io/json/ConfigDoFValues_json_io.hh"
 #include "casm/configuration/ConfigurationSet.hh"
 #include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/ThreadPool.hh"
 #include "casm/configuration/io/json/Supercell_json_io.hh"
 #include "casm/configuration/supercell_name.hh"
 #include "casm/misc/Validator.hh"
@@ -128,6 +132,131 @@ void report_and_throw_if_invalid(Validator const &validator, Log &log,
   }
 }
 
+/// \brief Configuration JSON read from a stream, not yet converted
+struct PendingConfigurationJson {
+  std::shared_ptr<config::Supercell const> supercell;
+  std::string supercell_name;
+  std::string configuration_id;
+  jsonParser json;
+};
+
+/// \brief Convert and validate a configuration read from a stream
+///
+/// Notes:
+/// - Does not write to the log, so that it may be used from worker threads.
+///   Error messages are included in the exception.
+config::ConfigurationRecord make_configuration_record(
+    PendingConfigurationJson const &pending, config::Prim const &prim) {
+  clexulator::ConfigDoFValues dof_values;
+  from_json(dof_values, pending.json["dof"]);
+
+  Validator validator;
+  validate_dof_values(
+      validator, dof_values,
+      pending.supercell->unitcell_index_converter.total_sites(),
+      prim.basicstructure->basis().size(), prim.global_dof_info,
+      prim.local_dof_info);
+  if (!validator.valid()) {
+    std::stringstream msg;
+    msg << "Error reading configuration: " << pending.supercell_name << "/"
+        << pending.configuration_id << ":";
+    for (auto const &e : validator.error) {
+      msg << " " << e;
+    }
+    throw std::runtime_error(msg.str());
+  }
+
+  return config::ConfigurationRecord(
+      config::Configuration(pending.supercell, dof_values),
+      pending.supercell_name, pending.configuration_id);
+}
+
+/// \brief Parse a configurations JSON stream, passing each configuration to
+///     `f` as soon as it is parsed and then discarding it
+///
+/// \returns The next configuration ids
+///
+/// Notes:
+/// - Only one configuration and the "config_id" object are held in memory
+///   at a time
+/// - Supercells are found or added to `supercells` by name as they are
+///   encountered
+/// - The version is checked when it is encountered, which may be after the
+///   configurations have been read
+std::map<std::string, Index> parse_configurations_json(
+    config::SupercellSet &supercells, std::istream &in,
+    std::function<void(PendingConfigurationJson &&)> f) {
+  typedef nlohmann::json::parse_event_t event_t;
+
+  // top-level key currently being parsed
+  std::string section;
+
+  // current supercell and configuration
+  std::shared_ptr<config::Supercell const> supercell;
+  std::string supercell_name;
+  std::string configuration_id;
+
+  nlohmann::json::parser_callback_t callback =
+      [&](int depth, event_t event, nlohmann::json &parsed) -> bool {
+    if (event == event_t::key) {
+      if (depth == 1) {
+        section = parsed.get<std::string>();
+      } else if (depth == 2 && section == "supercells") {
+        supercell_name = parsed.get<std::string>();
+        try {
+          supercell = supercells.insert_canonical(supercell_name)
+                          .first->supercell;
+        } catch (std::exception &e) {
+          std::stringstream msg;
+          msg << "Error: could not find or construct supercell '"
+              << supercell_name << "' by name: " << e.what();
+          throw std::runtime_error(msg.str());
+        }
+      } else if (depth == 3 && section == "supercells") {
+        configuration_id = parsed.get<std::string>();
+      }
+    } else if (event == event_t::value && depth == 1 &&
+               section == "version") {
+      if (!parsed.is_string() || parsed.get<std::string>() != "1.0") {
+        throw std::runtime_error(
+            std::string("Error jsonDB version mismatch: found: ") +
+            parsed.dump() + " expected: 1.0");
+      }
+    } else if (event == event_t::object_end && section == "supercells") {
+      if (depth == 3) {
+        // configuration complete: process and discard
+        f(PendingConfigurationJson{supercell, supercell_name,
+                                   configuration_id, jsonParser{parsed}});
+        return false;
+      } else if (depth == 2) {
+        // discard (now empty) supercell object
+        return false;
+      }
+    }
+    return true;
+  };
+
+  jsonParser json{nlohmann::json::parse(in, callback)};
+
+  if (!json.is_obj() || !json.contains("supercells")) {
+    throw std::runtime_error("Error reading configurations: invalid format");
+  }
+  if (!json.contains("version")) {
+    throw std::runtime_error(
+        "Error jsonDB version mismatch: found: none expected: 1.0");
+  }
+
+  // read next config id for each supercell
+  std::map<std::string, Index> next_config_id;
+  from_json(next_config_id, json["config_id"]);
+  return next_config_id;
+}
+
+/// \brief Write a JSON string, with escapes
+void write_json_string(std::ostream &out, std::string const &value) {
+  out << nlohmann::json(value).dump();
+}
+
 }  // namespace
 
 void from_json(config::SupercellSet &supercells,
@@ -156,10 +285,6 @@ void from_json(config::SupercellSet &supercells,
     report_and_throw_if_invalid(validator, log, error_if_invalid);
   }
 
-  std::map<std::string, config::SupercellRecord const *>
-      index_by_supercell_name =
-          make_index_by_canonical_supercell_name(supercells.data());
-
   // read config list contents
   auto scel_it = json["supercells"].begin();
   auto scel_end = json["supercells"].end();
@@ -173,8 +298,7 @@ void from_json(config::SupercellSet &supercells,
     // try to find or add supercell by name
     config::SupercellRecord const *s = nullptr;
     try {
-      s = find_or_add_canonical_supercell_by_name(
-          scel_it.name(), supercells.data(), index_by_supercell_name, prim);
+      s = &*supercells.insert_canonical(scel_it.name()).first;
     } catch (std::exception &e) {
       std::stringstream msg;
       msg << "Error: could not find or construct supercell '" << scel_it.name()
@@ -244,6 +368,156 @@ jsonParser &to_json(config::ConfigurationSet const &configurations,
   return json;
 }
 
+/// \brief Read configuration records one at a time from a configurations
+///     JSON stream
+///
+/// \param supercells Supercells are found or added by name as they are
+///     encountered
+/// \param in Input stream, with the same format as read by
+///     `from_json(SupercellSet &, ConfigurationSet &, jsonParser const &,
+///     std::shared_ptr<Prim const> const &)`
+/// \param f Function called with each ConfigurationRecord, in file order
+///
+/// \returns The next configuration ids, by supercell name, which may be
+///     passed to `ConfigurationSet::set_next_config_id`
+///
+/// Unlike `from_json`, this does not parse the entire document before
+/// reading configurations. Only one configuration is held in memory at a
+/// time, so this may be used to filter or convert configuration databases
+/// too large to hold in memory.
+std::map<std::string, Index> stream_from_json(
+    config::SupercellSet &supercells, std::istream &in,
+    std::function<void(config::ConfigurationRecord const &)> f) {
+  config::Prim const &prim = *supercells.prim();
+  return parse_configurations_json(
+      supercells, in, [&](PendingConfigurationJson &&pending) {
+        f(make_configuration_record(pending, prim));
+      });
+}
+
+/// \brief Read configuration records from a configurations JSON stream,
+///     processing batches of records in parallel
+///
+/// \param supercells Supercells are found or added by name as they are
+///     encountered
+/// \param in Input stream, with the same format as read by
+///     `from_json(SupercellSet &, ConfigurationSet &, jsonParser const &,
+///     std::shared_ptr<Prim const> const &)`
+/// \param f Function called with each ConfigurationRecord. It is called
+///     from the pool's worker threads, so it must be thread-safe, and
+///     records are not necessarily processed in file order.
+/// \param pool Thread pool used to convert, validate, and process records
+/// \param batch_size Number of records read before processing them in
+///     parallel. At most `batch_size` records are held in memory at a time.
+///
+/// \returns The next configuration ids, by supercell name, which may be
+///     passed to `ConfigurationSet::set_next_config_id`
+std::map<std::string, Index> stream_from_json(
+    config::SupercellSet &supercells, std::istream &in,
+    std::function<void(config::ConfigurationRecord const &)> f,
+    config::ThreadPool &pool, Index batch_size) {
+  if (batch_size < 1) {
+    throw std::runtime_error(
+        "Error in stream_from_json: batch_size must be >= 1");
+  }
+  config::Prim const &prim = *supercells.prim();
+  std::vector<PendingConfigurationJson> batch;
+  batch.reserve(batch_size);
+
+  auto process_batch = [&]() {
+    pool.parallel_for(batch.size(), [&](Index begin, Index end) {
+      for (Index i = begin; i < end; ++i) {
+        f(make_configuration_record(batch[i], prim));
+      }
+    });
+    batch.clear();
+  };
+
+  std::map<std::string, Index> next_config_id = parse_configurations_json(
+      supercells, in, [&](PendingConfigurationJson &&pending) {
+        batch.push_back(std::move(pending));
+        if (batch.size() == batch_size) {
+          process_batch();
+        }
+      });
+  process_batch();
+  return next_config_id;
+}
+
+/// \brief Constructor, writes the beginning of the document
+ConfigurationJsonStreamWriter::ConfigurationJsonStreamWriter(
+    std::ostream &out)
+    : m_out(out), m_supercell_open(false), m_finished(false) {
+  m_out << "{\"version\":\"1.0\",\"supercells\":{";
+}
+
+/// \brief Write a configuration record
+///
+/// Throws if `finish` has already been called, or if a record from a
+/// supercell that was already completed is written.
+void ConfigurationJsonStreamWriter::write(
+    config::ConfigurationRecord const &record) {
+  if (m_finished) {
+    throw std::runtime_error(
+        "Error in ConfigurationJsonStreamWriter::write: already finished");
+  }
+  if (!m_supercell_open || record.supercell_name != m_supercell_name) {
+    if (!m_supercell_names.insert(record.supercell_name).second) {
+      throw std::runtime_error(
+          "Error in ConfigurationJsonStreamWriter::write: records are not "
+          "grouped by supercell_name");
+    }
+    if (m_supercell_open) {
+      m_out << "},";
+    }
+    m_out << "\n";
+    write_json_string(m_out, record.supercell_name);
+    m_out << ":{";
+    m_supercell_name = record.supercell_name;
+    m_supercell_open = true;
+  } else {
+    m_out << ",";
+  }
+
+  jsonParser json;
+  json.put_obj();
+  to_json(record.configuration.dof_values, json["dof"]);
+  m_out << "\n";
+  write_json_string(m_out, record.configuration_id);
+  m_out << ":" << static_cast<nlohmann::json const &>(json).dump();
+}
+
+/// \brief Write next configuration ids and complete the document
+void ConfigurationJsonStreamWriter::finish(
+    std::map<std::string, Index> const &next_config_id) {
+  if (m_finished) {
+    throw std::runtime_error(
+        "Error in ConfigurationJsonStreamWriter::finish: already finished");
+  }
+  if (m_supercell_open) {
+    m_out << "}";
+  }
+  jsonParser json;
+  json = next_config_id;
+  m_out << "\n},\"config_id\":"
+        << static_cast<nlohmann::json const &>(json).dump() << "}\n";
+  m_finished = true;
+}
+
+/// \brief Write a ConfigurationSet to a configurations JSON stream, one
+///     record at a time
+///
+/// The output may be read with `stream_from_json` or `from_json`. Unlike
+/// `to_json`, this does not construct the entire document in memory.
+void stream_to_json(config::ConfigurationSet const &configurations,
+                    std::ostream &out) {
+  ConfigurationJsonStreamWriter writer(out);
+  for (auto const &record : configurations) {
+    writer.write(record);
+  }
+  writer.finish(configurations.next_config_id());
+}
+
 config::Configuration jsonConstructor<config::Configuration>::from_json(
     jsonParser const &json, std::shared_ptr<config::Prim const> const &prim) {
   return std::move(
@@ -261,7 +535,7 @@ jsonMake<config::Configuration>::make_from_json(
   Eigen::Matrix3l T;
   parser.require(T, "transformation_matrix_to_supercell");
   report_and_throw_if_invalid(parser, log, error_if_invalid);
-  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto supercell = config::make_shared_supercell(prim, T);
 
   clexulator::ConfigDoFValues dof_values;
   parser.require(dof_values, "dof");
@@ -305,7 +579,7 @@ void parse(InputParser<config::Configuration> &parser,
            std::shared_ptr<config::Prim const> const &prim) {
   Eigen::Matrix3l T;
   parser.require(T, "transformation_matrix_to_supercell");
-  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  auto supercell = config::make_shared_supercell(prim, T);
 
   clexulator::ConfigDoFValues dof_values;
   parser.require(dof_values, "dof");
@@ -19,7 +19,7 @@ void from_json(std::shared_ptr<config::Supercell const> &supercell,
   Eigen::Matrix3l T;
   parser.require(T, "transformation_matrix_to_supercell");
   report_and_throw_if_invalid(parser, log, error_if_invalid);
-  supercell = std::make_shared<config::Supercell const>(prim, T);
+  supercell = config::make_shared_supercell(prim, T);
 }
 
 void from_json(std::shared_ptr<config::Supercell const> &supercell,
@@ -75,7 +75,7 @@ void from_json(config::SupercellSet &supercells, jsonParser const &json,
     for (; it != end; ++it) {
       Eigen::Matrix3l mat;
       from_json(mat, *it);
-      supercells.insert(std::make_shared<config::Supercell const>(prim, mat));
+      supercells.insert(config::make_shared_supercell(prim, mat));
     }
   }
   if (json.contains("non_canonical_supercells")) {
@@ -89,7 +89,7 @@ void from_json(config::SupercellSet &supercells, jsonParser const &json,
       }
       Eigen::Matrix3l mat;
       from_json(mat, (*it)["transformation_matrix_to_supercell"]);
-      supercells.insert(std::make_shared<config::Supercell const>(prim, mat));
+      supercells.insert(config::make_shared_supercell(prim, mat));
     }
   }
 }
@@ -0,0 +1,283 @@
+#include "casm/configuration/translation_search.hh"
+
+#include <algorithm>
+#include <numeric>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace config {
+
+/// \brief Constructor
+///
+/// \param _unitcell_index_converter The supercell's UnitCellIndexConverter
+/// \param max_table_size If `size() * size() <= max_table_size`, the results
+///     of `add` and `subtract` are tabulated for all unit cells and
+///     translations. This is useful when many configurations in the same
+///     supercell are processed.
+TranslationArithmetic::TranslationArithmetic(
+    xtal::UnitCellIndexConverter const &_unitcell_index_converter,
+    Index max_table_size)
+    : m_unitcell_index_converter(_unitcell_index_converter) {
+  Index n_vol = m_unitcell_index_converter.total_sites();
+  m_unitcell.reserve(n_vol);
+  for (Index n = 0; n < n_vol; ++n) {
+    m_unitcell.push_back(m_unitcell_index_converter(n));
+  }
+  if (n_vol * n_vol <= max_table_size) {
+    m_add_table.resize(n_vol * n_vol);
+    m_subtract_table.resize(n_vol * n_vol);
+    for (Index t = 0; t < n_vol; ++t) {
+      for (Index n = 0; n < n_vol; ++n) {
+        m_add_table[t * n_vol + n] = _add(n, t);
+        m_subtract_table[t * n_vol + n] = _subtract(n, t);
+      }
+    }
+  }
+}
+
+Index TranslationArithmetic::_add(Index n, Index t) const {
+  return m_unitcell_index_converter(
+      xtal::UnitCell(m_unitcell[n] + m_unitcell[t]));
+}
+
+Index TranslationArithmetic::_subtract(Index n, Index t) const {
+  return m_unitcell_index_converter(
+      xtal::UnitCell(m_unitcell[n] - m_unitcell[t]));
+}
+
+namespace {
+
+/// \brief Keep candidates that give the greatest sublattice block, comparing
+///     one unit cell at a time
+///
+/// After translation `t`, the value in unit cell `n` is `block[n - t]`.
+/// Candidates are eliminated as soon as they are less than the current best
+/// at a unit cell. This is efficient when there are many distinct values.
+std::vector<Index> _dense_search(Eigen::VectorXi const &block,
+                                 TranslationArithmetic const &arithmetic,
+                                 std::vector<Index> candidates) {
+  std::vector<Index> next;
+  next.reserve(candidates.size());
+  Index n_vol = block.size();
+  for (Index n = 0; n < n_vol && candidates.size() > 1; ++n) {
+    next.clear();
+    int best_value = 0;
+    for (Index t : candidates) {
+      int value = block[arithmetic.subtract(n, t)];
+      if (next.empty() || value > best_value) {
+        best_value = value;
+        next.clear();
+        next.push_back(t);
+      } else if (value == best_value) {
+        next.push_back(t);
+      }
+    }
+    std::swap(candidates, next);
+  }
+  return candidates;
+}
+
+/// \brief Keep candidates that give the greatest sublattice block, comparing
+///     only the unit cells that do not have the maximum value
+///
+/// After translation `t`, the value originally in unit cell `d` is moved to
+/// unit cell `d + t`. If only a few unit cells, `deviations`, have a value
+/// less than `max_value`, then the translated block is fully described by
+/// the sorted list of `(d + t, block[d])`. The block with the later first
+/// deviation is greater and, for the same unit cell, the larger value is
+/// greater. This avoids the long ties of a dense search for nearly uniform
+/// blocks, such as dilute configurations.
+std::vector<Index> _sparse_search(Eigen::VectorXi const &block,
+                                  std::vector<Index> const &deviations,
+                                  TranslationArithmetic const &arithmetic,
+                                  std::vector<Index> const &candidates) {
+  typedef std::vector<std::pair<Index, int>> key_type;
+
+  // return 1 if lhs > rhs, -1 if lhs < rhs, 0 if equal
+  auto compare = [](key_type const &lhs, key_type const &rhs) {
+    for (Index i = 0; i < lhs.size(); ++i) {
+      if (lhs[i].first != rhs[i].first) {
+        return lhs[i].first > rhs[i].first ? 1 : -1;
+      }
+      if (lhs[i].second != rhs[i].second) {
+        return lhs[i].second > rhs[i].second ? 1 : -1;
+      }
+    }
+    return 0;
+  };
+
+  std::vector<Index> result;
+  key_type best_key;
+  key_type key(deviations.size());
+  for (Index t : candidates) {
+    for (Index i = 0; i < deviations.size(); ++i) {
+      Index d = deviations[i];
+      key[i] = std::make_pair(arithmetic.add(d, t), block[d]);
+    }
+    std::sort(key.begin(), key.end());
+    int c = result.empty() ? 1 : compare(key, best_key);
+    if (c > 0) {
+      std::swap(best_key, key);
+      key.resize(deviations.size());
+      result.clear();
+      result.push_back(t);
+    } else if (c == 0) {
+      result.push_back(t);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+/// \brief Return occupation values after applying only the factor group
+///     part of a supercell operation
+///
+/// \param occupation Occupation values in the supercell
+/// \param supercell The supercell
+/// \param supercell_factor_group_index Index into
+///     `supercell.sym_info.factor_group->element`
+///
+/// \returns The result, `w`, satisfies
+///     `copy_apply(SupercellSymOp(supercell, f, t), dof_values).occupation[l]
+///     == w[translation_permute[l]]`, for every translation `t`, including
+///     the permutation of occupant indices on sites with anisotropic
+///     occupants.
+Eigen::VectorXi make_factor_group_occupation(
+    Eigen::VectorXi const &occupation, Supercell const &supercell,
+    Index supercell_factor_group_index) {
+  PrimSymInfo const &prim_sym_info = supercell.prim->sym_info;
+  sym_info::Permutation const &factor_group_permute =
+      supercell.sym_info.factor_group_permutations.at(
+          supercell_factor_group_index);
+  Index n_vol = supercell.superlattice.size();
+  Index n_sites = occupation.size();
+
+  Eigen::VectorXi result(n_sites);
+  if (prim_sym_info.has_aniso_occs) {
+    Index prim_fg_index = supercell.sym_info.factor_group
+                              ->head_group_index[supercell_factor_group_index];
+    auto const &occ_op_rep = prim_sym_info.occ_symgroup_rep[prim_fg_index];
+    for (Index l = 0; l < n_sites; ++l) {
+      Index l_before = factor_group_permute[l];
+      result[l] = occ_op_rep[l_before / n_vol][occupation[l_before]];
+    }
+  } else {
+    for (Index l = 0; l < n_sites; ++l) {
+      result[l] = occupation[factor_group_permute[l]];
+    }
+  }
+  return result;
+}
+
+/// \brief Return the translations that make occupation values
+///     lexicographically greatest
+///
+/// \param values Occupation values in the supercell, with site index
+///     `l = b * n_vol + n`, for sublattice `b` and unit cell `n`.
+/// \param supercell The supercell
+///
+/// \returns The translation indices `t` (sorted in ascending order) for which
+///     `copy_apply(translation_permute(t), values)` is lexicographically
+///     greatest.
+///
+/// Notes:
+/// - This is equivalent to comparing the translated values for every
+///   translation, but exploits the group structure of the lattice
+///   translations: sublattices with a uniform value are skipped, and
+///   sublattices with only a few non-maximal values are compared by the
+///   translated positions of those values only. For most configurations the
+///   cost is close to linear in the number of sites.
+std::vector<Index> find_max_translations(Eigen::VectorXi const &values,
+                                         Supercell const &supercell) {
+  std::vector<Index> candidate_translation_indices(
+      supercell.superlattice.size());
+  std::iota(candidate_translation_indices.begin(),
+            candidate_translation_indices.end(), 0);
+  return find_max_translations(values, supercell,
+                               std::move(candidate_translation_indices));
+}
+
+/// \brief Return the translations, out of a set of candidates, that make
+///     occupation values lexicographically greatest
+///
+/// \param values Occupation values in the supercell, with site index
+///     `l = b * n_vol + n`, for sublattice `b` and unit cell `n`.
+/// \param supercell The supercell
+/// \param candidate_translation_indices Translation indices to consider.
+///
+/// \returns The candidate translation indices `t` (in the order given) for
+///     which `copy_apply(translation_permute(t), values)` is
+///     lexicographically greatest.
+std::vector<Index> find_max_translations(
+    Eigen::VectorXi const &values, Supercell const &supercell,
+    std::vector<Index> candidate_translation_indices) {
+  if (candidate_translation_indices.size() <= 1) {
+    return candidate_translation_indices;
+  }
+  TranslationArithmetic arithmetic(supercell.unitcell_index_converter);
+  return find_max_translations(values, arithmetic,
+                               std::move(candidate_translation_indices));
+}
+
+/// \brief Return the translations, out of a set of candidates, that make
+///     occupation values lexicographically greatest
+///
+/// \param values Occupation values in the supercell, with site index
+///     `l = b * n_vol + n`, for sublattice `b` and unit cell `n`.
+/// \param arithmetic Translation arithmetic for the supercell. Sharing it,
+///     with tabulated results, speeds up processing many configurations in
+///     the same supercell.
+/// \param candidate_translation_indices Translation indices to consider.
+///
+/// \returns The candidate translation indices `t` (in the order given) for
+///     which `copy_apply(translation_permute(t), values)` is
+///     lexicographically greatest.
+std::vector<Index> find_max_translations(
+    Eigen::VectorXi const &values, TranslationArithmetic const &arithmetic,
+    std::vector<Index> candidate_translation_indices) {
+  std::vector<Index> &candidates = candidate_translation_indices;
+  Index n_vol = arithmetic.size();
+  if (values.size() % n_vol != 0) {
+    throw std::runtime_error(
+        "Error in find_max_translations: values size is not consistent with "
+        "supercell volume");
+  }
+  Index n_sublat = values.size() / n_vol;
+  if (candidates.size() <= 1 || n_sublat == 0) {
+    return candidates;
+  }
+
+  std::vector<Index> deviations;
+  for (Index b = 0; b < n_sublat && candidates.size() > 1; ++b) {
+    Eigen::VectorXi block = values.segment(b * n_vol, n_vol);
+    int max_value = block.maxCoeff();
+    deviations.clear();
+    for (Index n = 0; n < n_vol; ++n) {
+      if (block[n] != max_value) {
+        deviations.push_back(n);
+      }
+    }
+
+    // all translations are equivalent for a uniform sublattice
+    if (deviations.empty()) {
+      continue;
+    }
+
+    // choose the cheaper search: the dense search costs ~n_vol / fraction of
+    // deviations, the sparse search costs ~n_deviations per candidate
+    Index n_dev = deviations.size();
+    if (n_dev * n_dev < n_vol) {
+      candidates = _sparse_search(block, deviations, arithmetic, candidates);
+    } else {
+      candidates = _dense_search(block, arithmetic, std::move(candidates));
+    }
+  }
+  return candidates;
+}
+
+}  // namespace config
+}  // namespace CASM
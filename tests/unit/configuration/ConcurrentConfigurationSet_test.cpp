@@ -0,0 +1,107 @@
+#include "casm/configuration/ConcurrentConfigurationSet.hh"
+
+#include <algorithm>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/ThreadPool.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// All binary occupations in two supercells, each included twice
+std::vector<config::Configuration> make_configurations() {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T1 = Eigen::Matrix3l::Identity();
+  Eigen::Matrix3l T2;
+  T2 << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+
+  std::vector<config::Configuration> configurations;
+  for (auto const &T : {T1, T2}) {
+    auto supercell = std::make_shared<config::Supercell const>(prim, T);
+    config::Configuration configuration(supercell);
+    Index n_sites = configuration.dof_values.occupation.size();
+    for (Index i = 0; i < (1 << n_sites); ++i) {
+      for (Index l = 0; l < n_sites; ++l) {
+        configuration.dof_values.occupation(l) = (i >> l) & 1;
+      }
+      configurations.push_back(configuration);
+      configurations.push_back(configuration);
+    }
+  }
+  return configurations;
+}
+
+}  // namespace
+
+TEST(ConcurrentConfigurationSetTest, DeterministicMerge) {
+  std::vector<config::Configuration> configurations = make_configurations();
+  Index n_distinct = configurations.size() / 2;
+
+  // parallel, bulk insertion
+  config::ConcurrentConfigurationSet parallel_set(7);
+  config::ThreadPool pool(4);
+  pool.parallel_for(configurations.size(), [&](Index begin, Index end) {
+    std::vector<config::Configuration> block(configurations.begin() + begin,
+                                             configurations.begin() + end);
+    parallel_set.insert_range(block);
+  });
+  EXPECT_EQ(parallel_set.size(), n_distinct);
+
+  // serial, single insertion, in reverse order
+  config::ConcurrentConfigurationSet serial_set(1);
+  Index n_inserted = 0;
+  for (auto it = configurations.rbegin(); it != configurations.rend(); ++it) {
+    n_inserted += serial_set.insert(*it);
+  }
+  EXPECT_EQ(n_inserted, n_distinct);
+  EXPECT_EQ(serial_set.size(), n_distinct);
+
+  // merge gives the same configuration ids
+  config::ConfigurationSet A;
+  config::ConfigurationSet B;
+  EXPECT_EQ(parallel_set.merge_into(A), n_distinct);
+  EXPECT_EQ(serial_set.merge_into(B), n_distinct);
+  ASSERT_EQ(A.size(), n_distinct);
+  ASSERT_EQ(B.size(), n_distinct);
+  for (auto const &record : A) {
+    auto it = B.find(record.configuration);
+    ASSERT_TRUE(it != B.end());
+    EXPECT_EQ(it->configuration_name, record.configuration_name);
+  }
+
+  // merging again inserts nothing
+  EXPECT_EQ(parallel_set.merge_into(A), 0);
+  EXPECT_EQ(A.size(), n_distinct);
+
+  parallel_set.clear();
+  EXPECT_TRUE(parallel_set.empty());
+}
+
+TEST(ConcurrentConfigurationSetTest, NonCanonicalSupercell) {
+  // equivalent supercells, of which at least one is not canonical
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  std::vector<std::shared_ptr<config::Supercell const>> supercells;
+  for (Index i = 0; i < 3; ++i) {
+    Eigen::Matrix3l T = Eigen::Matrix3l::Identity();
+    T(i, i) = 2;
+    supercells.push_back(std::make_shared<config::Supercell const>(prim, T));
+  }
+  auto it = std::find_if(supercells.begin(), supercells.end(),
+                         [](auto const &s) { return !is_canonical(*s); });
+  ASSERT_TRUE(it != supercells.end());
+
+  config::ConcurrentConfigurationSet set;
+  config::Configuration configuration(*it);
+  EXPECT_THROW(set.insert(configuration), std::runtime_error);
+  EXPECT_THROW(set.insert_range({configuration}), std::runtime_error);
+  EXPECT_EQ(set.size(), 0);
+
+  config::Configuration canonical_configuration(make_canonical_form(**it));
+  EXPECT_TRUE(set.insert(canonical_configuration));
+  EXPECT_EQ(set.size(), 1);
+}
@@ -0,0 +1,127 @@
+#include "casm/configuration/ConfigFingerprint.hh"
+
+#include <set>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void check_fingerprint_invariance(
+    config::ConfigFingerprintCalculator const &calculator,
+    config::Configuration const &configuration) {
+  config::ConfigFingerprint fingerprint = calculator(configuration);
+  config::ConfigFingerprintHash hash_f;
+  auto begin = config::SupercellSymOp::begin(configuration.supercell);
+  auto end = config::SupercellSymOp::end(configuration.supercell);
+  for (auto it = begin; it != end; ++it) {
+    config::ConfigFingerprint equivalent_fingerprint =
+        calculator(copy_apply(*it, configuration));
+    EXPECT_TRUE(equivalent_fingerprint == fingerprint);
+    EXPECT_EQ(hash_f(equivalent_fingerprint), hash_f(fingerprint));
+  }
+}
+
+}  // namespace
+
+class ConfigFingerprintFCCTest : public testing::Test {
+ protected:
+  ConfigFingerprintFCCTest() {
+    std::shared_ptr<config::Prim const> prim =
+        config::make_shared_prim(test::FCC_binary_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(ConfigFingerprintFCCTest, Test1) {
+  // fingerprints are invariant, for nearest neighbor and longer pairs
+  config::ConfigFingerprintCalculator calculator(supercell);
+  EXPECT_EQ(calculator.n_occupant_classes(), 2);
+  EXPECT_EQ(calculator.shell_distances().size(), 1);
+
+  double a = calculator.shell_distances()[0];
+  config::ConfigFingerprintCalculator calculator_3nn(supercell, 1.8 * a);
+  EXPECT_EQ(calculator_3nn.shell_distances().size(), 3);
+
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  for (Index k = 0; k < 6; ++k) {
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index l = 0; l < n_sites; ++l) {
+      occ(l) = ((l * l + k * l + 1) % (k + 2) == 0);
+    }
+    check_fingerprint_invariance(calculator, configuration);
+    check_fingerprint_invariance(calculator_3nn, configuration);
+  }
+}
+
+TEST_F(ConfigFingerprintFCCTest, Test2) {
+  // ConfigFingerprintSet finds the same distinct configurations as
+  // comparing canonical forms
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  std::set<config::Configuration> expected;
+  config::ConfigFingerprintSet distinct(supercell);
+  Index n_inserted = 0;
+  for (Index i = 0; i < (Index(1) << n_sites); ++i) {
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index l = 0; l < n_sites; ++l) {
+      occ(l) = (i >> l) & 1;
+    }
+    bool is_new =
+        expected.insert(config::make_canonical_form(configuration)).second;
+    EXPECT_EQ(distinct.insert(configuration), is_new);
+    n_inserted += 1;
+  }
+  EXPECT_EQ(distinct.size(), expected.size());
+  EXPECT_LT(distinct.n_canonical_forms(), 2 * n_inserted);
+
+  std::set<config::Configuration> found;
+  for (auto const &configuration : distinct.values()) {
+    found.insert(config::make_canonical_form(configuration));
+  }
+  EXPECT_TRUE(found == expected);
+}
+
+class ConfigFingerprintZrOTest : public testing::Test {
+ protected:
+  ConfigFingerprintZrOTest() {
+    std::shared_ptr<config::Prim const> prim =
+        config::make_shared_prim(test::ZrO_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 1, 0, 0, 0, 2;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(ConfigFingerprintZrOTest, Test1) {
+  // multiple sublattices, with more than one shell
+  config::ConfigFingerprintCalculator calculator(supercell, 4.0);
+  EXPECT_GT(calculator.shell_distances().size(), 1);
+
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  for (Index k = 0; k < 4; ++k) {
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index l = 0; l < n_sites; ++l) {
+      Index b = supercell->unitcellcoord_index_converter(l).sublattice();
+      if (b >= 2) {
+        occ(l) = ((l * l + k * l + 1) % (k + 2) == 0);
+      }
+    }
+    check_fingerprint_invariance(calculator, configuration);
+  }
+}
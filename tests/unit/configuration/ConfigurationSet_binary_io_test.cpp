@@ -0,0 +1,92 @@
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
+
+#include <cstdint>
+#include <fstream>
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "gtest/gtest.h"
+#include "testconfigurations.hh"
+#include "testdir.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConfigurationSetBinaryIOTest, RoundTrip) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      test::make_io_test_configurations(supercells);
+  supercells.insert((2 * Eigen::Matrix3l::Identity()).eval());
+
+  test::TmpDir tmpdir;
+  std::string path = (tmpdir.path() / "configurations.bin").string();
+  to_binary(supercells, configurations, path);
+
+  // lazy access
+  config::MappedConfigurationSet mapped(path, prim);
+  EXPECT_EQ(mapped.n_supercells(), 3);
+  ASSERT_EQ(mapped.size(), configurations.size());
+  Index i = 0;
+  for (auto const &record : configurations) {
+    EXPECT_EQ(mapped.supercell_name(i), record.supercell_name);
+    EXPECT_EQ(mapped.configuration_id(i), record.configuration_id);
+    config::Configuration configuration = mapped.configuration(i);
+    EXPECT_EQ(configuration.supercell, record.configuration.supercell);
+    EXPECT_EQ(configuration.dof_values.occupation,
+              record.configuration.dof_values.occupation);
+    EXPECT_EQ(configuration.dof_values.global_dof_values,
+              record.configuration.dof_values.global_dof_values);
+    EXPECT_EQ(configuration.dof_values.local_dof_values,
+              record.configuration.dof_values.local_dof_values);
+    ++i;
+  }
+  EXPECT_EQ(mapped.next_config_id(), configurations.next_config_id());
+
+  // read all
+  config::SupercellSet supercells_in(prim);
+  config::ConfigurationSet configurations_in;
+  from_binary(supercells_in, configurations_in, path, prim);
+  EXPECT_EQ(supercells_in.size(), 3);
+  ASSERT_EQ(configurations_in.size(), configurations.size());
+  EXPECT_EQ(configurations_in.find_by_name("SCEL4_2_2_1_1_1_0/0")
+                ->configuration.dof_values.local_dof_values,
+            configurations.find_by_name("SCEL4_2_2_1_1_1_0/0")
+                ->configuration.dof_values.local_dof_values);
+  EXPECT_EQ(configurations_in.next_config_id(),
+            configurations.next_config_id());
+
+  // prim with different DoF
+  auto other_prim = config::make_shared_prim(test::FCC_binary_prim());
+  EXPECT_THROW(config::MappedConfigurationSet(path, other_prim),
+               std::runtime_error);
+}
+
+TEST(ConfigurationSetBinaryIOTest, InvalidSizes) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      test::make_io_test_configurations(supercells);
+
+  test::TmpDir tmpdir;
+  std::string path = (tmpdir.path() / "configurations.bin").string();
+  to_binary(supercells, configurations, path);
+
+  // header n_records, at byte 32, such that the record table size would
+  // overflow to 0 without checked arithmetic
+  std::uint64_t n_records = std::uint64_t(1) << 60;
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(32);
+    file.write(reinterpret_cast<char const *>(&n_records), sizeof(n_records));
+  }
+  EXPECT_THROW(config::MappedConfigurationSet(path, prim),
+               std::runtime_error);
+
+  // truncated file
+  to_binary(supercells, configurations, path);
+  fs::resize_file(path, fs::file_size(path) - 1);
+  EXPECT_THROW(config::MappedConfigurationSet(path, prim),
+               std::runtime_error);
+}
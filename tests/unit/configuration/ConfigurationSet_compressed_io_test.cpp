@@ -0,0 +1,108 @@
+#include "casm/configuration/io/binary/ConfigurationSet_compressed_io.hh"
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/io/binary/ConfigurationSet_binary_io.hh"
+#include "gtest/gtest.h"
+#include "testconfigurations.hh"
+#include "testdir.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConfigurationSetCompressedIOTest, RoundTrip) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      test::make_io_test_configurations(supercells);
+
+  test::TmpDir tmpdir;
+  std::string path = (tmpdir.path() / "configurations.binz").string();
+  to_compressed_binary(supercells, configurations, path, 2);
+
+  // random access
+  config::CompressedConfigurationSet compressed(path, prim);
+  EXPECT_EQ(compressed.n_supercells(), 2);
+  EXPECT_EQ(compressed.block_size(), 2);
+  EXPECT_EQ(compressed.n_blocks(), 3);
+  ASSERT_EQ(compressed.size(), configurations.size());
+  EXPECT_EQ(compressed.block(2).size(), 1);
+  for (Index i = compressed.size() - 1; i >= 0; --i) {
+    auto expected = std::next(configurations.begin(), i);
+    config::ConfigurationRecord record = compressed.record(i);
+    EXPECT_EQ(record.configuration_name, expected->configuration_name);
+    EXPECT_EQ(record.configuration.supercell,
+              expected->configuration.supercell);
+    EXPECT_EQ(record.configuration.dof_values.occupation,
+              expected->configuration.dof_values.occupation);
+    EXPECT_EQ(record.configuration.dof_values.global_dof_values,
+              expected->configuration.dof_values.global_dof_values);
+    EXPECT_EQ(record.configuration.dof_values.local_dof_values,
+              expected->configuration.dof_values.local_dof_values);
+  }
+  EXPECT_EQ(compressed.next_config_id(), configurations.next_config_id());
+
+  // read all
+  config::SupercellSet supercells_in(prim);
+  config::ConfigurationSet configurations_in;
+  from_compressed_binary(supercells_in, configurations_in, path, prim);
+  EXPECT_EQ(supercells_in.size(), 2);
+  EXPECT_EQ(configurations_in.size(), configurations.size());
+  EXPECT_EQ(configurations_in.next_config_id(),
+            configurations.next_config_id());
+
+  // prim with different DoF
+  auto other_prim = config::make_shared_prim(test::FCC_binary_prim());
+  EXPECT_THROW(config::CompressedConfigurationSet(path, other_prim),
+               std::runtime_error);
+}
+
+TEST(ConfigurationSetCompressedIOTest, DiluteOccupation) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  config::SupercellSet supercells(prim);
+  auto supercell =
+      supercells.insert(4 * Eigen::Matrix3l::Identity()).first->supercell;
+
+  // single solute at each site
+  config::ConfigurationSet configurations;
+  config::Configuration configuration(supercell);
+  Index n_sites = configuration.dof_values.occupation.size();
+  for (Index l = 0; l < n_sites; ++l) {
+    configuration.dof_values.occupation.setZero();
+    configuration.dof_values.occupation(l) = 1;
+    configurations.insert(configuration);
+  }
+
+  test::TmpDir tmpdir;
+  std::string binary_path = (tmpdir.path() / "configurations.bin").string();
+  std::string compressed_path =
+      (tmpdir.path() / "configurations.binz").string();
+  to_binary(supercells, configurations, binary_path);
+  to_compressed_binary(supercells, configurations, compressed_path, 16);
+  EXPECT_LT(10 * fs::file_size(compressed_path), fs::file_size(binary_path));
+
+  config::CompressedConfigurationSet compressed(compressed_path, prim);
+  ASSERT_EQ(compressed.size(), n_sites);
+  Index i = 0;
+  for (auto const &record : configurations) {
+    EXPECT_EQ(compressed.record(i).configuration, record.configuration);
+    ++i;
+  }
+}
+
+TEST(ConfigurationSetCompressedIOTest, TruncatedFile) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      test::make_io_test_configurations(supercells);
+
+  test::TmpDir tmpdir;
+  std::string path = (tmpdir.path() / "configurations.binz").string();
+  to_compressed_binary(supercells, configurations, path, 2);
+
+  // sizes in the header and block index are checked against the file size
+  fs::resize_file(path, fs::file_size(path) - 1);
+  EXPECT_THROW(config::CompressedConfigurationSet(path, prim),
+               std::runtime_error);
+}
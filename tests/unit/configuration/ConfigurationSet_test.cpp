@@ -0,0 +1,110 @@
+#include "casm/configuration/ConfigurationSet.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/ThreadPool.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void check_indexes(bool index_by_fingerprint) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::ConfigurationSet configurations({}, index_by_fingerprint);
+  EXPECT_EQ(configurations.index_by_fingerprint(), index_by_fingerprint);
+
+  config::Configuration A(supercell);
+  config::Configuration B(supercell);
+  B.dof_values.occupation(0) = 1;
+  config::Configuration C(supercell);
+  C.dof_values.occupation(1) = 1;
+
+  // insert, find, and count by value and by name
+  EXPECT_TRUE(configurations.insert("SCEL", A).second);
+  EXPECT_FALSE(configurations.insert("SCEL", A).second);
+  EXPECT_TRUE(configurations.insert("SCEL", B).second);
+  EXPECT_EQ(configurations.size(), 2);
+  EXPECT_EQ(configurations.find_by_name("SCEL/0")->configuration, A);
+  EXPECT_EQ(configurations.find_by_name("SCEL/1")->configuration, B);
+  EXPECT_EQ(configurations.count_by_name("SCEL/2"), 0);
+  EXPECT_EQ(configurations.find(B)->configuration_name, "SCEL/1");
+  EXPECT_EQ(configurations.count(C), 0);
+
+  // erase keeps indexes consistent
+  EXPECT_EQ(configurations.erase_by_name("SCEL/0"), 1);
+  EXPECT_EQ(configurations.count(A), 0);
+  EXPECT_EQ(configurations.count_by_name("SCEL/0"), 0);
+  EXPECT_EQ(configurations.erase(B), 1);
+  EXPECT_EQ(configurations.count_by_name("SCEL/1"), 0);
+  EXPECT_TRUE(configurations.empty());
+
+  // direct modification through data() is found by const lookups, and
+  // re-indexed by the next non-const member function call
+  configurations.data().emplace(C, "SCEL", "7");
+  EXPECT_EQ(configurations.find(C)->configuration_name, "SCEL/7");
+  EXPECT_EQ(configurations.count_by_name("SCEL/7"), 1);
+  EXPECT_FALSE(configurations.insert("SCEL", C).second);
+  EXPECT_EQ(configurations.find(C)->configuration_name, "SCEL/7");
+  EXPECT_EQ(configurations.count_by_name("SCEL/7"), 1);
+
+  // const lookups may be made concurrently
+  std::vector<Index> counts(16, 0);
+  config::ThreadPool pool(4);
+  pool.parallel_for(counts.size(), [&](Index begin, Index end) {
+    for (Index i = begin; i < end; ++i) {
+      counts[i] = configurations.count(C) +
+                  configurations.count_by_name("SCEL/7");
+    }
+  });
+  EXPECT_EQ(counts, std::vector<Index>(16, 2));
+
+  // copies have their own indexes
+  config::ConfigurationSet copy(configurations);
+  configurations.clear();
+  EXPECT_EQ(configurations.count_by_name("SCEL/7"), 0);
+  EXPECT_EQ(copy.count(C), 1);
+  EXPECT_EQ(copy.find_by_name("SCEL/7")->configuration, C);
+}
+
+}  // namespace
+
+TEST(ConfigurationSetTest, NameIndex) { check_indexes(false); }
+
+TEST(ConfigurationSetTest, FingerprintIndex) { check_indexes(true); }
+
+TEST(ConfigurationSetTest, DuplicateNames) {
+  // records with the same name are found, first in set order, and remain
+  // found by name after erasing one of them
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+
+  config::Configuration A(supercell);
+  config::Configuration B(supercell);
+  B.dof_values.occupation(0) = 1;
+
+  config::ConfigurationSet configurations;
+  EXPECT_TRUE(
+      configurations.insert(config::ConfigurationRecord(B, "SCEL", "0"))
+          .second);
+  EXPECT_TRUE(
+      configurations.insert(config::ConfigurationRecord(A, "SCEL", "0"))
+          .second);
+  EXPECT_EQ(configurations.size(), 2);
+  EXPECT_EQ(configurations.count_by_name("SCEL/0"), 1);
+  EXPECT_TRUE(configurations.find_by_name("SCEL/0") == configurations.begin());
+
+  config::Configuration first = configurations.begin()->configuration;
+  EXPECT_EQ(configurations.erase_by_name("SCEL/0"), 1);
+  ASSERT_TRUE(configurations.find_by_name("SCEL/0") != configurations.end());
+  EXPECT_FALSE(configurations.find_by_name("SCEL/0")->configuration == first);
+  EXPECT_EQ(configurations.erase_by_name("SCEL/0"), 1);
+  EXPECT_EQ(configurations.count_by_name("SCEL/0"), 0);
+  EXPECT_TRUE(configurations.empty());
+}
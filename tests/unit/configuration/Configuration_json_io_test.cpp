@@ -0,0 +1,95 @@
+#include "casm/configuration/io/json/Configuration_json_io.hh"
+
+#include <mutex>
+#include <sstream>
+
+#include "casm/casm_io/json/jsonParser.hh"
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSet.hh"
+#include "casm/configuration/ThreadPool.hh"
+#include "gtest/gtest.h"
+#include "testconfigurations.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(ConfigurationJsonIOTest, StreamRoundTrip) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      test::make_io_test_configurations(supercells);
+
+  std::stringstream ss;
+  stream_to_json(configurations, ss);
+
+  // sequential
+  config::SupercellSet supercells_in(prim);
+  config::ConfigurationSet configurations_in;
+  std::map<std::string, Index> next_config_id = stream_from_json(
+      supercells_in, ss, [&](config::ConfigurationRecord const &record) {
+        configurations_in.insert(record);
+      });
+  configurations_in.set_next_config_id(next_config_id);
+  EXPECT_EQ(supercells_in.size(), 2);
+  ASSERT_EQ(configurations_in.size(), configurations.size());
+  for (auto const &record : configurations) {
+    auto it = configurations_in.find_by_name(record.configuration_name);
+    ASSERT_TRUE(it != configurations_in.end());
+    EXPECT_EQ(it->configuration, record.configuration);
+  }
+  EXPECT_EQ(configurations_in.next_config_id(),
+            configurations.next_config_id());
+
+  // parallel batches
+  config::ThreadPool pool(2);
+  std::stringstream ss2;
+  stream_to_json(configurations, ss2);
+  config::SupercellSet supercells_in2(prim);
+  std::mutex mutex;
+  config::ConfigurationSet configurations_in2;
+  stream_from_json(
+      supercells_in2, ss2,
+      [&](config::ConfigurationRecord const &record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        configurations_in2.insert(record);
+      },
+      pool, 2);
+  EXPECT_EQ(configurations_in2.size(), configurations.size());
+}
+
+TEST(ConfigurationJsonIOTest, StreamReadsToJson) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      test::make_io_test_configurations(supercells);
+
+  jsonParser json;
+  to_json(configurations, json);
+  std::stringstream ss;
+  ss << static_cast<nlohmann::json const &>(json).dump();
+
+  config::SupercellSet supercells_in(prim);
+  Index count = 0;
+  std::map<std::string, Index> next_config_id = stream_from_json(
+      supercells_in, ss,
+      [&](config::ConfigurationRecord const &record) { ++count; });
+  EXPECT_EQ(count, configurations.size());
+  EXPECT_EQ(next_config_id, configurations.next_config_id());
+}
+
+TEST(ConfigurationJsonIOTest, StreamWriterRequiresGrouping) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  config::SupercellSet supercells(prim);
+  config::ConfigurationSet configurations =
+      test::make_io_test_configurations(supercells);
+
+  std::stringstream ss;
+  ConfigurationJsonStreamWriter writer(ss);
+  auto it = configurations.begin();
+  auto last = std::prev(configurations.end());
+  ASSERT_NE(it->supercell_name, last->supercell_name);
+  writer.write(*it);
+  writer.write(*last);
+  EXPECT_THROW(writer.write(*it), std::runtime_error);
+}
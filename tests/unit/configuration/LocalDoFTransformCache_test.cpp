@@ -0,0 +1,119 @@
+#include "casm/configuration/LocalDoFTransformCache.hh"
+
+#include "casm/configuration/ConfigDoFIsEquivalent.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void check_cache(config::LocalDoFTransformCache const &cache,
+                 config::Configuration const &configuration) {
+  auto const &supercell = configuration.supercell;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto it = begin; it != end; ++it) {
+    Eigen::MatrixXd const &transformed = cache.transformed(*it);
+    sym_info::Permutation perm = it->combined_permute();
+    Eigen::MatrixXd permuted(transformed.rows(), transformed.cols());
+    for (Index l = 0; l < perm.size(); ++l) {
+      permuted.col(l) = transformed.col(perm[l]);
+    }
+    Eigen::MatrixXd const &expected =
+        copy_apply(*it, configuration).dof_values.local_dof_values.at("disp");
+    EXPECT_TRUE(almost_equal(permuted, expected));
+  }
+}
+
+}  // namespace
+
+TEST(LocalDoFTransformCacheTest, FCCDisp) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  Index n_fg = prim->sym_info.factor_group->element.size();
+
+  config::Configuration configuration(supercell);
+  Eigen::MatrixXd &disp = configuration.dof_values.local_dof_values.at("disp");
+  for (Index l = 0; l < n_sites; ++l) {
+    disp.col(l) << 0.01 * (l + 1), 0.02, -0.03 * l;
+  }
+
+  // default limit, large enough for all: all constructed at once
+  config::LocalDoFTransformCache cache(disp, "disp", 1);
+  EXPECT_EQ(cache.size(), 0);
+  check_cache(cache, configuration);
+  EXPECT_EQ(cache.size(), n_fg);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+
+  // unbounded
+  config::LocalDoFTransformCache unbounded_cache(disp, "disp", 1,
+                                                 std::nullopt);
+  check_cache(unbounded_cache, configuration);
+  EXPECT_EQ(unbounded_cache.size(), n_fg);
+
+  // bounded: least recently used are discarded
+  config::LocalDoFTransformCache bounded_cache(
+      disp, "disp", 1, 3 * disp.size() * sizeof(double));
+  check_cache(bounded_cache, configuration);
+  EXPECT_EQ(bounded_cache.size(), 3);
+}
+
+TEST(LocalDoFTransformCacheTest, LocalDoFIsEquivalent) {
+  // comparisons are the same with and without the cache, and with and
+  // without re-using transformed values from previous comparisons
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  Eigen::MatrixXd disp(3, n_sites);
+  Eigen::MatrixXd other(3, n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    disp.col(l) << 0.01 * (l + 1), 0.02, -0.03 * l;
+    other.col(l) << 0.02, 0.01 * l, -0.03 * (l + 1);
+  }
+
+  config::ConfigDoFIsEquivalent::Local cached(disp, "disp", 1, 1e-5);
+  config::ConfigDoFIsEquivalent::Local bounded(disp, "disp", 1, 1e-5, true,
+                                               Index(0));
+  config::ConfigDoFIsEquivalent::Local uncached(disp, "disp", 1, 1e-5, false);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto A = begin; A != end; ++A) {
+    for (auto B = begin; B != end; ++B) {
+      config::ConfigDoFIsEquivalent::Local fresh(disp, "disp", 1, 1e-5,
+                                                 false);
+      bool expected = fresh(*A, *B);
+      bool expected_less = fresh.is_less();
+      EXPECT_EQ(uncached(*A, *B), expected);
+      EXPECT_EQ(cached(*A, *B), expected);
+      EXPECT_EQ(bounded(*A, *B), expected);
+      if (!expected) {
+        EXPECT_EQ(uncached.is_less(), expected_less);
+        EXPECT_EQ(cached.is_less(), expected_less);
+        EXPECT_EQ(bounded.is_less(), expected_less);
+      }
+
+      config::ConfigDoFIsEquivalent::Local fresh_other(disp, "disp", 1, 1e-5,
+                                                       false);
+      expected = fresh_other(*A, *B, other);
+      expected_less = fresh_other.is_less();
+      EXPECT_EQ(uncached(*A, *B, other), expected);
+      EXPECT_EQ(cached(*A, *B, other), expected);
+      if (!expected) {
+        EXPECT_EQ(uncached.is_less(), expected_less);
+        EXPECT_EQ(cached.is_less(), expected_less);
+      }
+    }
+  }
+}
@@ -0,0 +1,94 @@
+#include "casm/configuration/PackedConfiguration.hh"
+
+#include <set>
+#include <unordered_set>
+
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+class PackedConfigurationFCCTernaryTest : public testing::Test {
+ protected:
+  PackedConfigurationFCCTernaryTest() {
+    prim = config::make_shared_prim(test::FCC_ternary_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Prim const> prim;
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(PackedConfigurationFCCTernaryTest, Test1) {
+  // pack and unpack
+  EXPECT_EQ(config::packed_bits_per_site(*prim), 2);
+
+  config::SupercellHandleRegistry registry;
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  for (Index l = 0; l < occ.size(); ++l) {
+    occ(l) = (l * l + 1) % 3;
+  }
+  config::PackedConfiguration packed = config::pack(configuration, registry);
+  EXPECT_EQ(packed.supercell_handle, 0);
+  EXPECT_EQ(packed.words.size(), 1);
+  for (Index l = 0; l < occ.size(); ++l) {
+    EXPECT_EQ(packed.occupant(l), occ(l));
+  }
+  EXPECT_TRUE(config::unpack(packed, registry) == configuration);
+
+  // equal supercells share a handle
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+  auto supercell_copy = std::make_shared<config::Supercell const>(prim, T);
+  EXPECT_EQ(registry.insert(supercell_copy), 0);
+  T << 1, 0, 0, 0, 1, 0, 0, 0, 3;
+  auto other_supercell = std::make_shared<config::Supercell const>(prim, T);
+  EXPECT_EQ(registry.insert(other_supercell), 1);
+  EXPECT_EQ(registry.size(), 2);
+}
+
+TEST_F(PackedConfigurationFCCTernaryTest, Test2) {
+  // ordering and canonical forms are consistent with Configuration
+  config::SupercellHandleRegistry registry;
+  std::set<config::Configuration> expected;
+  std::unordered_set<config::PackedConfiguration,
+                     config::PackedConfigurationHash>
+      distinct;
+  std::vector<config::Configuration> configurations;
+  for (Index k = 0; k < 40; ++k) {
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = ((l * l + k * l + k) % (k % 7 + 2)) % 3;
+    }
+    configurations.push_back(configuration);
+
+    config::Configuration canonical_configuration =
+        config::make_canonical_form(configuration);
+    config::PackedConfiguration packed = config::pack(configuration, registry);
+    config::PackedConfiguration packed_canonical =
+        config::make_canonical_form(packed, registry);
+    EXPECT_TRUE(packed_canonical ==
+                config::pack(canonical_configuration, registry));
+    EXPECT_EQ(config::is_canonical(packed, registry),
+              config::is_canonical(configuration));
+
+    expected.insert(canonical_configuration);
+    distinct.insert(packed_canonical);
+  }
+  EXPECT_EQ(distinct.size(), expected.size());
+
+  for (auto const &lhs : configurations) {
+    for (auto const &rhs : configurations) {
+      EXPECT_EQ(config::pack(lhs, registry) < config::pack(rhs, registry),
+                lhs < rhs);
+    }
+  }
+}
@@ -0,0 +1,69 @@
+#include "casm/configuration/QuantizedConfiguration.hh"
+
+#include <unordered_set>
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(QuantizedConfigurationTest, FCCDisp) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  double tol = 1e-3;
+
+  config::Configuration configuration(supercell);
+  Eigen::MatrixXd &disp = configuration.dof_values.local_dof_values.at("disp");
+  disp.col(0) << 0.01, 0.0, 0.0;
+  disp.col(1) << 0.0, 0.02, 0.0;
+
+  // values are snapped, and values within rounding are equal
+  config::Configuration perturbed(configuration);
+  perturbed.dof_values.local_dof_values.at("disp")(0, 0) += 1e-4;
+  config::QuantizedConfiguration a(configuration, tol);
+  config::QuantizedConfiguration b(perturbed, tol);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.configuration.dof_values.local_dof_values.at("disp")(0, 0),
+            b.configuration.dof_values.local_dof_values.at("disp")(0, 0));
+  EXPECT_EQ(config::QuantizedConfigurationHash()(a),
+            config::QuantizedConfigurationHash()(b));
+
+  // different tol: not equal, and ordered by tol
+  config::QuantizedConfiguration c(configuration, 2 * tol);
+  EXPECT_NE(a, c);
+  EXPECT_TRUE(a < c);
+  EXPECT_FALSE(c < a);
+
+  // key order: global, occupation, local
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  EXPECT_EQ(a.key.size(), 6 + n_sites + 3 * n_sites);
+  EXPECT_EQ(a.key[6 + n_sites], 10);
+  EXPECT_EQ(a.key[6 + n_sites + 4], 20);
+
+  // all equivalents have the same canonical form
+  config::QuantizedConfiguration canonical = make_canonical_form(a);
+  EXPECT_TRUE(is_canonical(canonical));
+  EXPECT_FALSE(canonical < a);
+  EXPECT_EQ(is_canonical(a), canonical == a);
+
+  std::unordered_set<config::QuantizedConfiguration,
+                     config::QuantizedConfigurationHash>
+      distinct;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto it = begin; it != end; ++it) {
+    config::QuantizedConfiguration equiv(copy_apply(*it, configuration), tol);
+    EXPECT_FALSE(canonical < equiv);
+    EXPECT_EQ(is_canonical(equiv), canonical == equiv);
+    distinct.insert(make_canonical_form(equiv));
+  }
+  EXPECT_EQ(distinct.size(), 1);
+  EXPECT_EQ(*distinct.begin(), canonical);
+
+  EXPECT_THROW(config::QuantizedConfiguration(configuration, 0.0),
+               std::runtime_error);
+}
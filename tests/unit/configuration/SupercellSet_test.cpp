@@ -0,0 +1,84 @@
+#include "casm/configuration/SupercellSet.hh"
+
+#include "casm/configuration/ThreadPool.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(SupercellSetTest, Indexes) {
+  std::shared_ptr<config::Prim const> prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+  config::SupercellSet supercells(prim);
+
+  Eigen::Matrix3l T1;
+  T1 << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  Eigen::Matrix3l T2 = 2 * Eigen::Matrix3l::Identity();
+
+  // insert by transformation matrix
+  auto result = supercells.insert(T1);
+  EXPECT_TRUE(result.second);
+  EXPECT_FALSE(supercells.insert(T1).second);
+  EXPECT_FALSE(supercells.insert(result.first->supercell).second);
+  EXPECT_TRUE(supercells.insert(T2).second);
+  EXPECT_EQ(supercells.size(), 2);
+
+  // find by transformation matrix, supercell, and canonical name
+  EXPECT_EQ(supercells.find(T1), result.first);
+  EXPECT_EQ(supercells.count(T2), 1);
+  EXPECT_EQ(supercells.find(config::make_shared_supercell(prim, T1)),
+            result.first);
+  EXPECT_EQ(supercells.count(Eigen::Matrix3l::Identity().eval()), 0);
+  for (auto const &record : supercells) {
+    if (record.is_canonical) {
+      auto it = supercells.find_canonical_by_name(record.supercell_name);
+      ASSERT_TRUE(it != supercells.end());
+      EXPECT_EQ(&*it, &record);
+    }
+  }
+
+  // insert canonical by name
+  auto canonical_supercell =
+      config::make_canonical_form(*config::make_shared_supercell(prim, T2));
+  std::string name =
+      config::SupercellRecord(canonical_supercell).supercell_name;
+  auto canonical_result = supercells.insert_canonical(name);
+  EXPECT_EQ(canonical_result.first->supercell, canonical_supercell);
+  EXPECT_EQ(supercells.count_canonical_by_name(name), 1);
+  EXPECT_FALSE(supercells.insert_canonical(name).second);
+
+  // erase keeps indexes consistent
+  EXPECT_EQ(supercells.erase(T1), 1);
+  EXPECT_EQ(supercells.count(T1), 0);
+  EXPECT_EQ(supercells.erase_canonical_by_name(name), 1);
+  EXPECT_EQ(supercells.count_canonical_by_name(name), 0);
+  Eigen::Matrix3l const &T_canonical =
+      canonical_supercell->superlattice.transformation_matrix_to_super();
+  EXPECT_EQ(supercells.count(T_canonical), 0);
+
+  // direct modification through data() is found by const lookups, and
+  // re-indexed by the next non-const member function call
+  supercells.data().emplace(config::make_shared_supercell(prim, T1));
+  EXPECT_EQ(supercells.count(T1), 1);
+  EXPECT_FALSE(supercells.insert(T1).second);
+  EXPECT_EQ(supercells.count(T1), 1);
+
+  // const lookups may be made concurrently
+  std::vector<Index> counts(16, 0);
+  config::ThreadPool pool(4);
+  pool.parallel_for(counts.size(), [&](Index begin, Index end) {
+    for (Index i = begin; i < end; ++i) {
+      counts[i] = supercells.count(T1) + supercells.count(T2);
+    }
+  });
+  EXPECT_EQ(counts, std::vector<Index>(16, 2));
+
+  // copies have their own indexes
+  config::SupercellSet copy(supercells);
+  supercells.clear();
+  EXPECT_EQ(supercells.count(T1), 0);
+  auto it = copy.find(T1);
+  ASSERT_TRUE(it != copy.end());
+  EXPECT_EQ(it->supercell->superlattice.transformation_matrix_to_super(), T1);
+}
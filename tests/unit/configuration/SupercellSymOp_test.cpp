@@ -1,5 +1,7 @@
 #include "casm/configuration/SupercellSymOp.hh"
 
+#include <thread>
+
 #include "casm/configuration/Configuration.hh"
 #include "casm/configuration/Prim.hh"
 #include "casm/configuration/Supercell.hh"
@@ -106,6 +108,127 @@ TEST_F(SupercellSymOpFCCTest, Test5) {
   EXPECT_EQ(occ_matrix_rep.size(), 48);
 }
 
+TEST_F(SupercellSymOpFCCTest, TestCombinedPermutationTable) {
+  // operations give the same permutations with and without the table
+  Eigen::Matrix3l T;
+  T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+  auto with_table = std::make_shared<config::Supercell const>(
+      supercell->prim, T, 0);  // no translation_permutations
+  auto without_table = std::make_shared<config::Supercell const>(
+      supercell->prim, T, 0, 0);  // no table
+  EXPECT_TRUE(with_table->sym_info.combined_permutations->within_budget());
+  EXPECT_FALSE(
+      without_table->sym_info.combined_permutations->within_budget());
+  EXPECT_EQ(without_table->sym_info.combined_permutations->construct(),
+            nullptr);
+
+  // table is not constructed by using operations
+  auto const &cache = *with_table->sym_info.combined_permutations;
+  for (auto it = config::SupercellSymOp::begin(with_table);
+       it != config::SupercellSymOp::end(with_table); ++it) {
+    it->permute_index(0);
+  }
+  EXPECT_EQ(cache.get_if_constructed(), nullptr);
+
+  // table is constructed once, on request, and shared across threads
+  std::vector<config::CombinedPermutationTable const *> tables(4, nullptr);
+  std::vector<std::thread> threads;
+  for (Index i = 0; i < tables.size(); ++i) {
+    threads.emplace_back([&, i]() { tables[i] = cache.construct(); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_NE(tables[0], nullptr);
+  for (auto table : tables) {
+    EXPECT_EQ(table, tables[0]);
+  }
+  EXPECT_EQ(cache.get_if_constructed(), tables[0]);
+
+  Index n_sites = with_table->unitcellcoord_index_converter.total_sites();
+  auto it = config::SupercellSymOp::begin(with_table);
+  auto end = config::SupercellSymOp::end(with_table);
+  auto it_expected = config::SupercellSymOp::begin(without_table);
+  for (; it != end; ++it, ++it_expected) {
+    EXPECT_EQ(it->combined_permute(), it_expected->combined_permute());
+    EXPECT_EQ(it->translation_permute(), it_expected->translation_permute());
+    for (Index l = 0; l < n_sites; ++l) {
+      EXPECT_EQ(it->permute_index(l), it_expected->permute_index(l));
+    }
+  }
+}
+
+TEST_F(SupercellSymOpFCCTest, TestPermuteIndexWithoutPermutations) {
+  // permute_index is calculated directly when no permutations are held
+  Eigen::Matrix3l T;
+  T << 3, 0, 0, 0, 2, 0, 0, 0, 2;
+  auto without_permutations = std::make_shared<config::Supercell const>(
+      supercell->prim, T, 0, 0);
+  auto with_permutations =
+      std::make_shared<config::Supercell const>(supercell->prim, T);
+  ASSERT_TRUE(
+      with_permutations->sym_info.translation_permutations.has_value());
+
+  Index n_sites =
+      without_permutations->unitcellcoord_index_converter.total_sites();
+  auto it = config::SupercellSymOp::begin(with_permutations);
+  auto end = config::SupercellSymOp::end(with_permutations);
+  for (; it != end; ++it) {
+    config::SupercellSymOp op(without_permutations,
+                              it->supercell_factor_group_index(),
+                              it->translation_index());
+    for (Index l = 0; l < n_sites; ++l) {
+      EXPECT_EQ(op.permute_index(l), it->permute_index(l));
+    }
+  }
+}
+
+TEST_F(SupercellSymOpFCCTest, TestPermuteIndexAfterChange) {
+  // permute_index is updated by decrement and reset
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  std::vector<config::SupercellSymOpHandle> handles =
+      config::make_handles(begin, end);
+
+  config::SupercellSymOp op = end;
+  config::SupercellSymOp reset_op = begin;
+  for (Index i = handles.size() - 1; i >= 0; --i) {
+    --op;
+    reset_op.reset(handles[i]);
+    config::SupercellSymOp expected(supercell, handles[i]);
+    for (Index l = 0; l < n_sites; ++l) {
+      EXPECT_EQ(op.permute_index(l), expected.permute_index(l));
+      EXPECT_EQ(reset_op.permute_index(l), expected.permute_index(l));
+    }
+  }
+}
+
+TEST_F(SupercellSymOpFCCTest, TestHandle) {
+  // convert to and from SupercellSymOpHandle
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  std::vector<config::SupercellSymOpHandle> handles =
+      config::make_handles(begin, end);
+  EXPECT_EQ(handles.size(), 4 * 48);
+  EXPECT_TRUE(std::is_sorted(handles.begin(), handles.end()));
+
+  config::SupercellSymOp op = begin;
+  Index i = 0;
+  for (auto it = begin; it != end; ++it, ++i) {
+    EXPECT_EQ(handles[i].supercell, supercell.get());
+    EXPECT_TRUE(config::SupercellSymOp(supercell, handles[i]) == *it);
+    EXPECT_TRUE(op.reset(handles[i]) == *it);
+    EXPECT_TRUE(op.handle() == it->handle());
+  }
+
+  // handles must reference the same supercell
+  Eigen::Matrix3l T = supercell->superlattice.transformation_matrix_to_super();
+  auto other = std::make_shared<config::Supercell const>(supercell->prim, T);
+  EXPECT_THROW(op.reset(config::SupercellSymOp::begin(other).handle()),
+               std::runtime_error);
+}
+
 class SupercellSymOpFCCTernaryGLStrainDispTest : public testing::Test {
  protected:
   SupercellSymOpFCCTernaryGLStrainDispTest() {
@@ -344,3 +467,35 @@ TEST_F(SupercellSymOpSimpleCubicIsingTest, Test1) {
   EXPECT_TRUE(almost_equal(occ_count,
                            Eigen::VectorXi::Constant(size, 1 * 48 + 7 * 48)));
 }
+
+class SupercellSymOpZrOTest : public testing::Test {
+ protected:
+  SupercellSymOpZrOTest() {
+    auto prim = config::make_shared_prim(test::ZrO_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 1;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(SupercellSymOpZrOTest, TestProductAndInverse) {
+  // products and inverses, found with integer tables, are consistent with
+  // site permutations (the ZrO factor group includes screw and glide ops)
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto A = begin; A != end; ++A) {
+    config::SupercellSymOp A_inverse = A->inverse();
+    for (Index l = 0; l < n_sites; ++l) {
+      EXPECT_EQ(A->permute_index(A_inverse.permute_index(l)), l);
+    }
+    for (auto B = begin; B != end; ++B) {
+      config::SupercellSymOp AB = (*A) * (*B);
+      for (Index l = 0; l < n_sites; ++l) {
+        EXPECT_EQ(AB.permute_index(l), B->permute_index(A->permute_index(l)));
+      }
+    }
+  }
+}
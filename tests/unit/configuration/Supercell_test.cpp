@@ -1,6 +1,9 @@
 #include "casm/configuration/Supercell.hh"
 
+#include <thread>
+
 #include "casm/configuration/Prim.hh"
+#include "casm/configuration/ThreadPool.hh"
 #include "gtest/gtest.h"
 #include "teststructures.hh"
 
@@ -18,3 +21,87 @@ TEST(SupercellTest, Test1) {
   EXPECT_EQ(supercell->sym_info.translation_permutations->size(), 4);
   EXPECT_EQ(supercell->sym_info.factor_group_permutations.size(), 48);
 }
+
+TEST(SupercellTest, MakeSharedSupercell) {
+  std::shared_ptr<config::Prim const> prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  Eigen::Matrix3l T2 = 2 * Eigen::Matrix3l::Identity();
+
+  // equivalent supercells are shared
+  auto supercell = config::make_shared_supercell(prim, T);
+  EXPECT_EQ(config::make_shared_supercell(prim, T), supercell);
+  EXPECT_EQ(config::make_shared_supercell(
+                prim, xtal::Superlattice(prim->basicstructure->lattice(), T)),
+            supercell);
+  EXPECT_NE(config::make_shared_supercell(prim, T2), supercell);
+
+  // supercells of a different prim are not shared
+  std::shared_ptr<config::Prim const> other_prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+  auto other_supercell = config::make_shared_supercell(other_prim, T);
+  EXPECT_NE(other_supercell, supercell);
+  EXPECT_EQ(other_supercell->prim, other_prim);
+
+  // concurrent requests return the same supercell
+  std::vector<std::shared_ptr<config::Supercell const>> results(8);
+  std::vector<std::thread> threads;
+  for (Index i = 0; i < results.size(); ++i) {
+    threads.emplace_back(
+        [&, i]() { results[i] = config::make_shared_supercell(prim, T2); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto const &result : results) {
+    EXPECT_EQ(result, results[0]);
+  }
+}
+
+TEST(SupercellTest, LazySymInfo) {
+  std::shared_ptr<config::Prim const> prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+
+  Eigen::Matrix3l T = 2 * Eigen::Matrix3l::Identity();
+  std::shared_ptr<config::Supercell const> lazy =
+      std::make_shared<config::Supercell const>(prim, T);
+  std::shared_ptr<config::Supercell const> warmed =
+      std::make_shared<config::Supercell const>(prim, T);
+  warmed->sym_info.warm();
+  EXPECT_FALSE(lazy->sym_info.factor_group_permutations.is_constructed());
+  EXPECT_TRUE(warmed->sym_info.factor_group_permutations.is_constructed());
+
+  // lazily constructed members match eagerly constructed members
+  EXPECT_EQ(lazy->sym_info.factor_group->element.size(),
+            warmed->sym_info.factor_group->element.size());
+  EXPECT_EQ(*lazy->sym_info.translation_permutations,
+            *warmed->sym_info.translation_permutations);
+  EXPECT_EQ(lazy->sym_info.factor_group_permutations.get(),
+            warmed->sym_info.factor_group_permutations.get());
+  EXPECT_EQ(lazy->sym_info.factor_group_permutations.size(), 48);
+
+  // repeated access returns the same object
+  EXPECT_EQ(&lazy->sym_info.factor_group_permutations.get(),
+            &lazy->sym_info.factor_group_permutations.get());
+
+  // copies share constructed members
+  config::SupercellSymInfo copy = lazy->sym_info;
+  EXPECT_EQ(&copy.factor_group_permutations.get(),
+            &lazy->sym_info.factor_group_permutations.get());
+
+  // warm many supercells in parallel
+  std::vector<std::shared_ptr<config::Supercell const>> supercells;
+  for (Index i = 1; i <= 4; ++i) {
+    Eigen::Matrix3l T_i = Eigen::Matrix3l::Identity();
+    T_i(2, 2) = i;
+    supercells.push_back(std::make_shared<config::Supercell const>(prim, T_i));
+  }
+  config::ThreadPool pool(2);
+  config::warm_sym_info(supercells, pool);
+  for (Index i = 0; i < supercells.size(); ++i) {
+    EXPECT_EQ(supercells[i]->sym_info.translation_permutations->size(),
+              i + 1);
+  }
+}
@@ -0,0 +1,53 @@
+#include "casm/configuration/ThreadPool.hh"
+
+#include <numeric>
+
+#include "casm/global/definitions.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(ThreadPoolTest, Test1) {
+  config::ThreadPool pool(4);
+  EXPECT_EQ(pool.size(), 4);
+
+  Index n = 1000;
+  std::vector<Index> values(n, 0);
+  pool.parallel_for(n, [&](Index begin, Index end) {
+    for (Index i = begin; i < end; ++i) {
+      values[i] = i;
+    }
+  });
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), Index(0)),
+            n * (n - 1) / 2);
+}
+
+TEST(ThreadPoolTest, Test2) {
+  // exceptions are re-thrown by parallel_for
+  config::ThreadPool pool(2);
+  EXPECT_THROW(pool.parallel_for(10,
+                                 [&](Index begin, Index end) {
+                                   if (begin <= 5 && 5 < end) {
+                                     throw std::runtime_error("error");
+                                   }
+                                 }),
+               std::runtime_error);
+
+  // pool is still usable
+  Index count = 0;
+  pool.parallel_for(
+      10, [&](Index begin, Index end) { count += end - begin; }, 1);
+  EXPECT_EQ(count, 10);
+}
+
+TEST(ThreadPoolTest, Test3) {
+  std::vector<std::pair<Index, Index>> blocks = config::make_blocks(10, 4);
+  ASSERT_EQ(blocks.size(), 4);
+  EXPECT_EQ(blocks[0], std::make_pair(Index(0), Index(3)));
+  EXPECT_EQ(blocks[1], std::make_pair(Index(3), Index(6)));
+  EXPECT_EQ(blocks[2], std::make_pair(Index(6), Index(8)));
+  EXPECT_EQ(blocks[3], std::make_pair(Index(8), Index(10)));
+
+  EXPECT_EQ(config::make_blocks(3, 8).size(), 3);
+  EXPECT_EQ(config::make_blocks(0, 8).size(), 0);
+}
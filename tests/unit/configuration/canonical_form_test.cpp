@@ -1,7 +1,9 @@
-#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/canonical_form_parallel.hh"
 
+#include "casm/crystallography/CanonicalForm.hh"
 #include "casm/misc/CASM_Eigen_math.hh"
 #include "gtest/gtest.h"
+#include "testconfigurations.hh"
 #include "teststructures.hh"
 
 using namespace CASM;
@@ -49,6 +51,55 @@ TEST_F(CanonicalFormFCCTest, TestSupercell2) {
   EXPECT_EQ(equivalents.size(), 3);
 }
 
+TEST_F(CanonicalFormFCCTest, TestSupercell3) {
+  Eigen::Matrix3d S;
+  S << 4., 0, 0, 0, 8., 0, 0, 0, 4.;
+  xtal::Superlattice superlat(prim->basicstructure->lattice(),
+                              xtal::Lattice(S));
+  std::shared_ptr<config::Supercell const> tmp_supercell =
+      std::make_shared<config::Supercell const>(prim, superlat);
+  std::vector<xtal::SymOp> const &point_group =
+      prim->sym_info.point_group->element;
+  auto hnf = [&](xtal::Lattice const &lattice) {
+    Eigen::Matrix3l T =
+        xtal::Superlattice(prim->basicstructure->lattice(), lattice)
+            .transformation_matrix_to_super();
+    return hermite_normal_form(T.cast<int>()).first;
+  };
+
+  std::vector<std::shared_ptr<config::Supercell const>> supercells =
+      make_equivalents(*tmp_supercell);
+  supercells.push_back(tmp_supercell);
+  for (auto const &supercell : supercells) {
+    xtal::Lattice const &lattice = supercell->superlattice.superlattice();
+    xtal::Lattice expected_canonical_lattice =
+        xtal::canonical::equivalent(lattice, point_group, lattice.tol());
+    Eigen::Matrix3l expected_T =
+        xtal::Superlattice(prim->basicstructure->lattice(),
+                           expected_canonical_lattice)
+            .transformation_matrix_to_super();
+
+    config::SupercellCanonicalSearchResult result =
+        canonical_supercell_search(*supercell);
+    EXPECT_EQ(result.canonical_transformation_matrix, expected_T);
+    EXPECT_EQ(result.is_canonical,
+              xtal::canonical::check(lattice, point_group));
+    EXPECT_EQ(result.is_canonical, is_canonical(*supercell));
+    EXPECT_EQ(result.invariant_subgroup_indices.size(), 16);
+    EXPECT_EQ(result.from_canonical_index,
+              prim->sym_info.point_group->inv(result.to_canonical_index));
+
+    // to/from canonical ops generate the expected superlattices
+    xtal::Lattice canonical_lattice = make_canonical_form(*supercell)
+                                          ->superlattice.superlattice();
+    EXPECT_EQ(hnf(sym::copy_apply(to_canonical(*supercell), lattice)),
+              hnf(canonical_lattice));
+    EXPECT_EQ(
+        hnf(sym::copy_apply(from_canonical(*supercell), canonical_lattice)),
+        hnf(lattice));
+  }
+}
+
 TEST_F(CanonicalFormFCCTest, Test1) {
   config::Configuration configuration(supercell);
   Eigen::VectorXi &occ = configuration.dof_values.occupation;
@@ -91,6 +142,35 @@ TEST_F(CanonicalFormFCCTest, Test2) {
   EXPECT_TRUE(almost_equal(equivalents[3].dof_values.occupation, expected));
 }
 
+TEST_F(CanonicalFormFCCTest, Test3) {
+  // make_equivalents_by_cosets gives the same equivalents as make_equivalents
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  occ << 0, 0, 1, 0;
+  std::vector<config::Configuration> expected =
+      make_equivalents(configuration, begin, end);
+  config::EquivalentsResult result =
+      make_equivalents_by_cosets(configuration, begin, end);
+  ASSERT_EQ(result.equivalents.size(), expected.size());
+  ASSERT_EQ(result.equivalence_map.size(), expected.size());
+
+  Index n_ops = 0;
+  for (Index i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(result.equivalents[i] == expected[i]);
+    // each op generates its equivalent, in [begin, end) order
+    auto const &ops = result.equivalence_map[i];
+    EXPECT_TRUE(std::is_sorted(ops.begin(), ops.end()));
+    for (auto const &op : ops) {
+      EXPECT_TRUE(copy_apply(op, configuration) == expected[i]);
+    }
+    n_ops += ops.size();
+  }
+  EXPECT_EQ(n_ops, std::distance(begin, end));
+}
+
 class CanonicalFormFCCTest2 : public testing::Test {
  protected:
   CanonicalFormFCCTest2() {
@@ -129,6 +209,110 @@ TEST_F(CanonicalFormFCCTest2, Test1) {
   }
 }
 
+TEST_F(CanonicalFormFCCTest2, Test2) {
+  // compare translation-factored search with the full operation sweep
+  config::Configuration configuration(supercell);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+
+  occ << 0, 0, 0, 1;
+  config::SupercellSymOp op = to_canonical(configuration);
+  EXPECT_EQ(op.supercell_factor_group_index(), 0);
+  EXPECT_EQ(op.translation_index(), 1);
+  EXPECT_FALSE(is_canonical(configuration));
+
+  config::Configuration canonical_configuration =
+      make_canonical_form(configuration);
+  Eigen::VectorXi expected(4);
+  expected << 1, 0, 0, 0;
+  EXPECT_TRUE(
+      almost_equal(canonical_configuration.dof_values.occupation, expected));
+  EXPECT_TRUE(is_canonical(canonical_configuration));
+}
+
+class CanonicalFormFCCTest3 : public testing::Test {
+ protected:
+  CanonicalFormFCCTest3() {
+    std::shared_ptr<config::Prim const> prim =
+        config::make_shared_prim(test::FCC_binary_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(CanonicalFormFCCTest3, Test1) {
+  // compare translation-factored search with the full operation sweep, for
+  // dilute, concentrated, and ordered occupations
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  for (Index k = 0; k < 12; ++k) {
+    config::Configuration configuration(supercell);
+    configuration.dof_values.occupation =
+        test::make_test_occupation(n_sites, k);
+
+    config::SupercellSymOp expected_op =
+        to_canonical(configuration, begin, end);
+    config::SupercellSymOp op = to_canonical(configuration);
+    EXPECT_EQ(op.supercell_factor_group_index(),
+              expected_op.supercell_factor_group_index());
+    EXPECT_EQ(op.translation_index(), expected_op.translation_index());
+    EXPECT_EQ(is_canonical(configuration),
+              is_canonical(configuration, begin, end));
+    EXPECT_TRUE(is_canonical(make_canonical_form(configuration)));
+  }
+}
+
+TEST_F(CanonicalFormFCCTest3, Test2) {
+  // parallel versions give the same results as the serial versions
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  config::ThreadPool pool(3);
+
+  for (Index k = 0; k < 4; ++k) {
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index l = 0; l < n_sites; ++l) {
+      occ(l) = ((l * l + k * l + 1) % (k + 2) == 0);
+    }
+
+    config::SupercellSymOp expected_op =
+        to_canonical(configuration, begin, end);
+    config::SupercellSymOp op = to_canonical(configuration, begin, end, pool);
+    EXPECT_EQ(op.supercell_factor_group_index(),
+              expected_op.supercell_factor_group_index());
+    EXPECT_EQ(op.translation_index(), expected_op.translation_index());
+
+    EXPECT_TRUE(make_canonical_form(configuration, begin, end, pool) ==
+                make_canonical_form(configuration, begin, end));
+
+    std::vector<config::SupercellSymOp> expected_subgroup =
+        make_invariant_subgroup(configuration, begin, end);
+    std::vector<config::SupercellSymOp> subgroup =
+        make_invariant_subgroup(configuration, begin, end, pool);
+    ASSERT_EQ(subgroup.size(), expected_subgroup.size());
+    for (Index i = 0; i < subgroup.size(); ++i) {
+      EXPECT_EQ(subgroup[i].supercell_factor_group_index(),
+                expected_subgroup[i].supercell_factor_group_index());
+      EXPECT_EQ(subgroup[i].translation_index(),
+                expected_subgroup[i].translation_index());
+    }
+
+    std::vector<config::Configuration> expected_equivalents =
+        make_equivalents(configuration, begin, end);
+    std::vector<config::Configuration> equivalents =
+        make_equivalents(configuration, begin, end, pool);
+    ASSERT_EQ(equivalents.size(), expected_equivalents.size());
+    for (Index i = 0; i < equivalents.size(); ++i) {
+      EXPECT_TRUE(equivalents[i] == expected_equivalents[i]);
+    }
+  }
+}
+
 class CanonicalFormFCCTernaryGLStrainDispTest : public testing::Test {
  protected:
   CanonicalFormFCCTernaryGLStrainDispTest() {
@@ -234,3 +418,27 @@ TEST_F(CanonicalFormFCCTernaryGLStrainDispTest, Test4) {
       expected_GLstrain,
       canonical_configuration.dof_values.global_dof_values.at("GLstrain")));
 }
+
+TEST_F(CanonicalFormFCCTernaryGLStrainDispTest, Test5) {
+  // translation-factored search with occupation, local, and global DoF
+  config::Configuration configuration(supercell);
+  clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
+  dof_values.occupation(3) = 1;
+  dof_values.local_dof_values.at("disp")(2, 2) = 1.0;
+  dof_values.global_dof_values.at("GLstrain")(2) = 0.01;
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::SupercellSymOp expected_op = to_canonical(configuration, begin, end);
+  config::SupercellSymOp op = to_canonical(configuration);
+  EXPECT_EQ(op.supercell_factor_group_index(),
+            expected_op.supercell_factor_group_index());
+  EXPECT_EQ(op.translation_index(), expected_op.translation_index());
+
+  config::Configuration canonical_configuration =
+      make_canonical_form(configuration);
+  EXPECT_TRUE(is_canonical(canonical_configuration));
+  EXPECT_TRUE(canonical_configuration ==
+              make_canonical_form(configuration, begin, end));
+}
@@ -0,0 +1,214 @@
+#include "casm/configuration/canonical_search.hh"
+
+#include "casm/configuration/ThreadPool.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "gtest/gtest.h"
+#include "testconfigurations.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void check_canonical_form_search(config::Configuration const &configuration) {
+  auto const &supercell = configuration.supercell;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  config::CanonicalFormSearchResult result =
+      canonical_form_search(configuration, begin, end);
+
+  config::SupercellSymOp expected_op = to_canonical(configuration, begin, end);
+  EXPECT_EQ(result.to_canonical.supercell_factor_group_index(),
+            expected_op.supercell_factor_group_index());
+  EXPECT_EQ(result.to_canonical.translation_index(),
+            expected_op.translation_index());
+
+  EXPECT_TRUE(result.canonical_configuration ==
+              make_canonical_form(configuration, begin, end));
+
+  std::vector<config::SupercellSymOp> expected_subgroup =
+      make_invariant_subgroup(configuration, begin, end);
+  ASSERT_EQ(result.invariant_subgroup.size(), expected_subgroup.size());
+  for (Index i = 0; i < expected_subgroup.size(); ++i) {
+    EXPECT_EQ(result.invariant_subgroup[i].supercell_factor_group_index(),
+              expected_subgroup[i].supercell_factor_group_index());
+    EXPECT_EQ(result.invariant_subgroup[i].translation_index(),
+              expected_subgroup[i].translation_index());
+  }
+}
+
+void check_make_canonical_forms(
+    std::vector<config::Configuration> const &configurations) {
+  config::ThreadPool pool(3);
+  std::vector<config::CanonicalFormsResult> results;
+  results.push_back(config::make_canonical_forms(configurations, 3));
+  results.push_back(config::make_canonical_forms(configurations, 3, 0));
+  results.push_back(config::make_canonical_forms(configurations, pool, 2));
+  for (auto const &result : results) {
+    ASSERT_EQ(result.canonical_configurations.size(), configurations.size());
+    ASSERT_EQ(result.to_canonical.size(), configurations.size());
+    for (Index i = 0; i < configurations.size(); ++i) {
+      auto const &s = configurations[i].supercell;
+      auto begin = config::SupercellSymOp::begin(s);
+      auto end = config::SupercellSymOp::end(s);
+      config::SupercellSymOp expected_op =
+          to_canonical(configurations[i], begin, end);
+      EXPECT_EQ(result.to_canonical[i].supercell_factor_group_index(),
+                expected_op.supercell_factor_group_index());
+      EXPECT_EQ(result.to_canonical[i].translation_index(),
+                expected_op.translation_index());
+      EXPECT_TRUE(result.canonical_configurations[i] ==
+                  make_canonical_form(configurations[i], begin, end));
+    }
+  }
+}
+
+}  // namespace
+
+class CanonicalSearchFCCTest : public testing::Test {
+ protected:
+  CanonicalSearchFCCTest() {
+    std::shared_ptr<config::Prim const> prim =
+        config::make_shared_prim(test::FCC_binary_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(CanonicalSearchFCCTest, Test1) {
+  // dilute, concentrated, and ordered occupations
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  for (Index k = 0; k < 12; ++k) {
+    config::Configuration configuration(supercell);
+    configuration.dof_values.occupation =
+        test::make_test_occupation(n_sites, k);
+    check_canonical_form_search(configuration);
+  }
+}
+
+TEST_F(CanonicalSearchFCCTest, Test2) {
+  // search over a subset of operations
+  config::Configuration configuration(supercell);
+  configuration.dof_values.occupation(5) = 1;
+
+  auto begin = config::SupercellSymOp::translation_begin(supercell);
+  auto end = config::SupercellSymOp::translation_end(supercell);
+  config::CanonicalFormSearchResult result =
+      canonical_form_search(configuration, begin, end);
+
+  EXPECT_EQ(result.to_canonical.translation_index(),
+            to_canonical(configuration, begin, end).translation_index());
+  EXPECT_EQ(result.invariant_subgroup.size(), 1);
+}
+
+TEST_F(CanonicalSearchFCCTest, Test3) {
+  // batch canonicalization, across supercells
+  std::shared_ptr<config::Prim const> prim = supercell->prim;
+  Eigen::Matrix3l T;
+  T << 3, 0, 0, 0, 3, 0, 0, 0, 1;
+  auto supercell_b = std::make_shared<config::Supercell const>(prim, T);
+
+  std::vector<config::Configuration> configurations;
+  for (Index k = 0; k < 10; ++k) {
+    auto const &s = (k % 2) ? supercell : supercell_b;
+    config::Configuration configuration(s);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    for (Index l = 0; l < occ.size(); ++l) {
+      occ(l) = ((l * l + k * l + 1) % (k + 2) == 0);
+    }
+    configurations.push_back(configuration);
+  }
+
+  check_make_canonical_forms(configurations);
+}
+
+class CanonicalSearchFCCTernaryGLStrainDispTest : public testing::Test {
+ protected:
+  CanonicalSearchFCCTernaryGLStrainDispTest() {
+    auto prim =
+        config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+    Eigen::Matrix3l T;
+    T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(CanonicalSearchFCCTernaryGLStrainDispTest, Test1) {
+  config::Configuration configuration(supercell);
+  clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
+  dof_values.local_dof_values.at("disp")(2, 2) = 1.0;
+  check_canonical_form_search(configuration);
+
+  dof_values.occupation(3) = 1;
+  check_canonical_form_search(configuration);
+
+  dof_values.global_dof_values.at("GLstrain")(2) = 0.01;
+  check_canonical_form_search(configuration);
+}
+
+class CanonicalSearchZrOTest : public testing::Test {
+ protected:
+  CanonicalSearchZrOTest() {
+    std::shared_ptr<config::Prim const> prim =
+        config::make_shared_prim(test::ZrO_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(CanonicalSearchZrOTest, Test1) {
+  // multiple sublattices: the Zr sublattices have a uniform value, and the
+  // dilute and concentrated O sublattice occupations are searched by the
+  // dense and sparse translation searches, respectively
+  Index n_vol = supercell->superlattice.size();
+  std::vector<config::Configuration> configurations;
+  for (Index k = 0; k < 12; ++k) {
+    config::Configuration configuration(supercell);
+    configuration.dof_values.occupation.segment(2 * n_vol, 2 * n_vol) =
+        test::make_test_occupation(2 * n_vol, k);
+    check_canonical_form_search(configuration);
+    configurations.push_back(configuration);
+  }
+  check_make_canonical_forms(configurations);
+}
+
+class CanonicalSearchFCCDimerTest : public testing::Test {
+ protected:
+  CanonicalSearchFCCDimerTest() {
+    std::shared_ptr<config::Prim const> prim =
+        config::make_shared_prim(test::FCC_dimer_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 3;
+    supercell = std::make_shared<config::Supercell const>(prim, T);
+  }
+
+  std::shared_ptr<config::Supercell const> supercell;
+};
+
+TEST_F(CanonicalSearchFCCDimerTest, Test1) {
+  // anisotropic occupants, which are permuted by the factor group
+  // operations: dilute occupations are searched by the dense translation
+  // search, and concentrated occupations by the sparse translation search
+  ASSERT_TRUE(supercell->prim->sym_info.has_aniso_occs);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+  std::vector<config::Configuration> configurations;
+  for (Index k = 0; k < 12; ++k) {
+    config::Configuration configuration(supercell);
+    Eigen::VectorXi &occ = configuration.dof_values.occupation;
+    occ = 2 * test::make_test_occupation(n_sites, k);
+    occ(k) = 1;
+    check_canonical_form_search(configuration);
+    configurations.push_back(configuration);
+  }
+  check_make_canonical_forms(configurations);
+}
@@ -0,0 +1,112 @@
+#include "casm/configuration/fused_apply.hh"
+
+#include "casm/configuration/SupercellSymOp.hh"
+#include "casm/misc/CASM_Eigen_math.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+void expect_equal(config::ConfigurationWithProperties const &A,
+                  config::ConfigurationWithProperties const &B) {
+  clexulator::ConfigDoFValues const &a = A.configuration.dof_values;
+  clexulator::ConfigDoFValues const &b = B.configuration.dof_values;
+  EXPECT_EQ(A.configuration.supercell, B.configuration.supercell);
+  EXPECT_EQ(a.occupation, b.occupation);
+  for (auto const &dof : a.global_dof_values) {
+    EXPECT_TRUE(almost_equal(dof.second, b.global_dof_values.at(dof.first)));
+  }
+  for (auto const &dof : a.local_dof_values) {
+    EXPECT_TRUE(almost_equal(dof.second, b.local_dof_values.at(dof.first)));
+  }
+  for (auto const &property : A.global_properties) {
+    EXPECT_TRUE(almost_equal(property.second,
+                             B.global_properties.at(property.first)));
+  }
+  for (auto const &property : A.local_properties) {
+    EXPECT_TRUE(
+        almost_equal(property.second, B.local_properties.at(property.first)));
+  }
+}
+
+}  // namespace
+
+TEST(FusedApplyTest, FCCTernaryGLStrainDisp) {
+  auto prim = config::make_shared_prim(test::FCC_ternary_GLstrain_disp_prim());
+  Eigen::Matrix3l T;
+  T << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  config::Configuration configuration(supercell);
+  clexulator::ConfigDoFValues &dof_values = configuration.dof_values;
+  dof_values.occupation(1) = 1;
+  dof_values.occupation(2) = 2;
+  dof_values.global_dof_values.at("GLstrain") << 0.01, 0.02, 0.03, 0.0, 0.0,
+      0.01;
+  Eigen::MatrixXd &disp = dof_values.local_dof_values.at("disp");
+  for (Index l = 0; l < n_sites; ++l) {
+    disp.col(l) << 0.01 * l, 0.02, -0.01 * l;
+  }
+
+  Eigen::MatrixXd force(3, n_sites);
+  for (Index l = 0; l < n_sites; ++l) {
+    force.col(l) << 0.1, -0.2 * l, 0.3;
+  }
+  Eigen::VectorXd energy(1);
+  energy << -1.5;
+  Eigen::VectorXd Ustrain(6);
+  Ustrain << 1.01, 1.02, 0.99, 0.0, 0.01, 0.0;
+  config::ConfigurationWithProperties input(
+      configuration, {{"force", force}},
+      {{"energy", energy}, {"Ustrain", Ustrain}});
+
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+
+  // single op: same result as copy_apply, re-using output and workspace
+  config::FusedApplyWorkspace workspace;
+  config::ConfigurationWithProperties output(input);
+  for (auto it = begin; it != end; ++it) {
+    fused_apply(*it, input, output, workspace);
+    expect_equal(output, copy_apply(*it, input));
+  }
+
+  // batch
+  std::vector<config::ConfigurationWithProperties> outputs;
+  fused_apply(begin, end, input, outputs, workspace);
+  ASSERT_EQ(outputs.size(), Index(std::distance(begin, end)));
+  Index i = 0;
+  for (auto it = begin; it != end; ++it, ++i) {
+    expect_equal(outputs[i], copy_apply(*it, input));
+  }
+
+  EXPECT_THROW(fused_apply(*begin, output, output, workspace),
+               std::runtime_error);
+}
+
+TEST(FusedApplyTest, FCCDimerOccupation) {
+  auto prim = config::make_shared_prim(test::FCC_dimer_prim());
+  Eigen::Matrix3l T = 2 * Eigen::Matrix3l::Identity();
+  auto supercell = std::make_shared<config::Supercell const>(prim, T);
+  Index n_sites = supercell->unitcellcoord_index_converter.total_sites();
+
+  config::Configuration input(supercell);
+  Index n_occ = prim->basicstructure->basis()[0].occupant_dof().size();
+  for (Index l = 0; l < n_sites; ++l) {
+    input.dof_values.occupation(l) = l % n_occ;
+  }
+
+  config::FusedApplyWorkspace workspace;
+  std::vector<config::Configuration> outputs;
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  fused_apply(begin, end, input, outputs, workspace);
+  Index i = 0;
+  for (auto it = begin; it != end; ++it, ++i) {
+    EXPECT_EQ(outputs[i].dof_values.occupation,
+              copy_apply(*it, input).dof_values.occupation);
+  }
+}
@@ -0,0 +1,129 @@
+#include "casm/configuration/gather_compare.hh"
+
+#include "casm/configuration/ConfigDoFIsEquivalent.hh"
+#include "casm/configuration/Configuration.hh"
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/SupercellSymOp.hh"
+#include "gtest/gtest.h"
+#include "testconfigurations.hh"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+TEST(GatherCompareTest, Test1) {
+  // find_first_difference, for all permutation types and many lengths
+  for (Index n = 0; n < 200; n += 7) {
+    std::vector<int> values(n);
+    std::vector<std::uint16_t> perm_16bit(n);
+    std::vector<std::uint32_t> perm_32bit(n);
+    for (Index i = 0; i < n; ++i) {
+      values[i] = (i * i + 3 * i) % 5 == 0;
+      perm_16bit[i] = (7 * i + 3) % n;
+      perm_32bit[i] = perm_16bit[i];
+    }
+    config::PermutedOccupation rhs_16bit;
+    rhs_16bit.values = values.data();
+    rhs_16bit.perm_16bit = perm_16bit.data();
+    config::PermutedOccupation rhs_32bit;
+    rhs_32bit.values = values.data();
+    rhs_32bit.perm_32bit = perm_32bit.data();
+
+    std::vector<int> permuted(n);
+    for (Index i = 0; i < n; ++i) {
+      permuted[i] = values[perm_16bit[i]];
+    }
+    for (Index k = 0; k <= n; k += 5) {
+      std::vector<int> lhs_values(permuted);
+      if (k < n) {
+        lhs_values[k] = 2;
+      }
+      config::PermutedOccupation lhs =
+          config::make_permuted_occupation(lhs_values.data());
+      EXPECT_EQ(config::find_first_difference(lhs, rhs_16bit, n), k);
+      EXPECT_EQ(config::find_first_difference(lhs, rhs_32bit, n), k);
+      EXPECT_EQ(config::find_first_difference(rhs_16bit, lhs, n), k);
+      EXPECT_EQ(config::find_first_difference(rhs_32bit, lhs, n), k);
+    }
+    EXPECT_EQ(config::find_first_difference(rhs_16bit, rhs_32bit, n), n);
+  }
+}
+
+class GatherCompareFCCTest : public testing::Test {
+ protected:
+  GatherCompareFCCTest() {
+    std::shared_ptr<config::Prim const> prim =
+        config::make_shared_prim(test::FCC_binary_prim());
+    Eigen::Matrix3l T;
+    T << 2, 0, 0, 0, 2, 0, 0, 0, 2;
+    with_table = std::make_shared<config::Supercell const>(prim, T);
+    with_table->sym_info.combined_permutations->construct();
+    without_table = std::make_shared<config::Supercell const>(prim, T, 0, 0);
+  }
+
+  std::shared_ptr<config::Supercell const> with_table;
+  std::shared_ptr<config::Supercell const> without_table;
+};
+
+TEST_F(GatherCompareFCCTest, Test1) {
+  // Occupation comparisons are the same with and without the table
+  config::Configuration configuration(with_table);
+  Eigen::VectorXi &occ = configuration.dof_values.occupation;
+  occ << 1, 0, 0, 1, 0, 0, 0, 1;
+  config::ConfigDoFIsEquivalent::Occupation f(occ);
+  config::ConfigDoFIsEquivalent::Occupation f_expected(occ);
+
+  auto begin = config::SupercellSymOp::begin(with_table);
+  auto end = config::SupercellSymOp::end(with_table);
+  auto B = config::SupercellSymOp(with_table, 3, 5);
+  auto B_expected = config::SupercellSymOp(without_table, 3, 5);
+  for (auto A = begin; A != end; ++A) {
+    config::SupercellSymOp A_expected(without_table,
+                                      A->supercell_factor_group_index(),
+                                      A->translation_index());
+    bool is_equal = f(*A);
+    EXPECT_EQ(is_equal, f_expected(A_expected));
+    if (!is_equal) {
+      EXPECT_EQ(f.is_less(), f_expected.is_less());
+    }
+    is_equal = f(*A, B);
+    EXPECT_EQ(is_equal, f_expected(A_expected, B_expected));
+    if (!is_equal) {
+      EXPECT_EQ(f.is_less(), f_expected.is_less());
+    }
+  }
+}
+
+TEST(GatherCompareSymOpTest, Test1) {
+  // values permuted by SupercellSymOp::permute_index, without a combined
+  // permutation table, are gathered in blocks
+  std::shared_ptr<config::Prim const> prim =
+      config::make_shared_prim(test::FCC_binary_prim());
+  Eigen::Matrix3l T;
+  T << 5, 0, 0, 0, 5, 0, 0, 0, 5;
+  auto supercell = std::make_shared<config::Supercell const>(prim, T, 0, 0);
+  Index n = supercell->unitcellcoord_index_converter.total_sites();
+  Eigen::VectorXi occ = test::make_test_occupation(n, 9);
+
+  std::vector<int> permuted(n);
+  auto begin = config::SupercellSymOp::begin(supercell);
+  auto end = config::SupercellSymOp::end(supercell);
+  for (auto op = begin; op != end; ++op) {
+    config::PermutedOccupation rhs =
+        config::make_permuted_occupation(occ.data(), *op);
+    ASSERT_EQ(rhs.op, &(*op));
+    for (Index i = 0; i < n; ++i) {
+      permuted[i] = occ[op->permute_index(i)];
+    }
+    config::PermutedOccupation lhs =
+        config::make_permuted_occupation(permuted.data());
+    EXPECT_EQ(config::find_first_difference(lhs, rhs, n), n);
+    for (Index k : {Index(0), Index(5), Index(70), n - 1}) {
+      permuted[k] += 1;
+      EXPECT_EQ(config::find_first_difference(lhs, rhs, n), k);
+      EXPECT_EQ(config::find_first_difference(rhs, lhs, n), k);
+      EXPECT_EQ(rhs[k], occ[op->permute_index(k)]);
+      permuted[k] -= 1;
+    }
+  }
+}
@@ -0,0 +1,131 @@
+#include "casm/configuration/enumeration/SupercellEnumerator.hh"
+
+#include "casm/configuration/Prim.hh"
+#include "casm/configuration/Supercell.hh"
+#include "casm/configuration/ThreadPool.hh"
+#include "casm/configuration/canonical_form.hh"
+#include "casm/configuration/hermite_normal_form.hh"
+#include "gtest/gtest.h"
+#include "teststructures.hh"
+
+using namespace CASM;
+
+namespace {
+
+std::vector<std::shared_ptr<config::Supercell const>> enumerate_all(
+    config::SupercellEnumerator enumerator) {
+  std::vector<std::shared_ptr<config::Supercell const>> result;
+  while (enumerator.is_valid()) {
+    result.push_back(enumerator.value());
+    enumerator.advance();
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(SupercellEnumeratorTest, HermiteNormalFormLess) {
+  Eigen::Matrix3l A;
+  A << 2, 0, 1, 0, 2, 1, 0, 0, 1;
+  Eigen::Matrix3l B;
+  B << 1, 0, 0, 0, 2, 0, 0, 0, 2;
+
+  // diagonal elements are compared first
+  EXPECT_TRUE(config::hermite_normal_form_less(B, A));
+  EXPECT_FALSE(config::hermite_normal_form_less(A, B));
+  EXPECT_FALSE(config::hermite_normal_form_less(A, A));
+
+  // then H(1,2), H(0,2), H(0,1)
+  Eigen::Matrix3l C = A;
+  C(0, 1) = 1;
+  EXPECT_TRUE(config::hermite_normal_form_less(A, C));
+  C(1, 2) = 0;
+  EXPECT_TRUE(config::hermite_normal_form_less(C, A));
+}
+
+TEST(SupercellEnumeratorTest, FCCCount) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+
+  std::vector<Index> count(7, 0);
+  for (auto const &supercell :
+       enumerate_all(config::SupercellEnumerator(prim, 1, 6))) {
+    EXPECT_TRUE(config::is_canonical(*supercell));
+    count[supercell->superlattice.size()] += 1;
+  }
+  std::vector<Index> expected = {0, 1, 2, 3, 7, 5, 10};
+  EXPECT_EQ(count, expected);
+}
+
+TEST(SupercellEnumeratorTest, CompareToCanonicalForm) {
+  auto prim = config::make_shared_prim(test::ZrO_prim());
+
+  // canonical forms of all HNF, volumes 1 to 4
+  std::set<config::Supercell const *> expected;
+  std::vector<std::shared_ptr<config::Supercell const>> hold;
+  for (Index volume = 1; volume <= 4; ++volume) {
+    for (Index a = 1; a <= volume; ++a) {
+      for (Index b = 1; b <= volume; ++b) {
+        if (volume % (a * b) != 0) {
+          continue;
+        }
+        Index c = volume / (a * b);
+        for (Index h01 = 0; h01 < a; ++h01) {
+          for (Index h02 = 0; h02 < a; ++h02) {
+            for (Index h12 = 0; h12 < b; ++h12) {
+              Eigen::Matrix3l H;
+              H << a, h01, h02, 0, b, h12, 0, 0, c;
+              config::Supercell supercell(prim, H);
+              hold.push_back(config::make_canonical_form(supercell));
+              expected.insert(hold.back().get());
+            }
+          }
+        }
+      }
+    }
+  }
+
+  auto result = enumerate_all(config::SupercellEnumerator(prim, 1, 4));
+  std::set<config::Supercell const *> found;
+  for (auto const &supercell : result) {
+    found.insert(supercell.get());
+  }
+  EXPECT_EQ(found.size(), result.size());
+  EXPECT_EQ(found, expected);
+}
+
+TEST(SupercellEnumeratorTest, Parallel) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+
+  config::ThreadPool pool(3);
+  auto serial = enumerate_all(config::SupercellEnumerator(prim, 2, 10));
+  auto parallel = enumerate_all(config::SupercellEnumerator(
+      prim, 2, 10, "abc", Eigen::Matrix3l::Identity(), pool));
+  EXPECT_EQ(serial, parallel);
+}
+
+TEST(SupercellEnumeratorTest, Dirs) {
+  auto prim = config::make_shared_prim(test::FCC_binary_prim());
+
+  // 1d supercells: one per volume
+  auto result = enumerate_all(config::SupercellEnumerator(prim, 1, 5, "a"));
+  ASSERT_EQ(result.size(), 5);
+  for (Index i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(result[i]->superlattice.size(), i + 1);
+  }
+
+  // 2d supercells of the conventional cubic unit cell
+  Eigen::Matrix3l unit_cell;
+  unit_cell << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  result =
+      enumerate_all(config::SupercellEnumerator(prim, 1, 4, "ab", unit_cell));
+  EXPECT_FALSE(result.empty());
+  for (auto const &supercell : result) {
+    EXPECT_TRUE(config::is_canonical(*supercell));
+    EXPECT_EQ(supercell->superlattice.size() % 4, 0);
+  }
+
+  EXPECT_THROW(config::SupercellEnumerator(prim, 1, 4, "ad"),
+               std::runtime_error);
+  EXPECT_THROW(config::SupercellEnumerator(prim, 1, 4, "aa"),
+               std::runtime_error);
+}
@@ -0,0 +1,75 @@
+#ifndef CASM_unittest_testconfigurations
+#define CASM_unittest_testconfigurations
+
+#include "casm/configuration/ConfigurationSet.hh"
+#include "casm/configuration/SupercellSet.hh"
+
+namespace test {
+
+/// \brief Occupation values for testing canonical form searches
+///
+/// \param n_sites Number of sites
+/// \param k Pattern index, in [0, 12)
+///
+/// \returns Occupation values, each 0 or 1:
+/// - k < 4: dilute, a single site with value 1
+/// - 4 <= k < 8: concentrated, a single site with value 0
+/// - 8 <= k < 12: ordered, with values from a quadratic pattern in the site
+///   index
+inline Eigen::VectorXi make_test_occupation(CASM::Index n_sites,
+                                            CASM::Index k) {
+  Eigen::VectorXi occ(n_sites);
+  for (CASM::Index l = 0; l < n_sites; ++l) {
+    if (k < 4) {
+      occ(l) = (l == 3 * k + 1);
+    } else if (k < 8) {
+      occ(l) = (l != 2 * k + 1);
+    } else {
+      occ(l) = ((l * l + k * l + 1) % (k - 5) == 0);
+    }
+  }
+  return occ;
+}
+
+/// \brief Configurations with occupation, GLstrain, and disp values, for
+///     testing configuration input and output
+///
+/// \param supercells A SupercellSet with prim
+///     `test::FCC_ternary_GLstrain_disp_prim()`. The supercells with
+///     transformation matrices `I` and `{{-1, 1, 1}, {1, -1, 1}, {1, 1, -1}}`
+///     are inserted, in that order.
+///
+/// \returns Five configurations:
+/// - "SCEL1_1_1_1_0_0_0/0": occupation(0) == 2, and GLstrain(0) == 0.01
+/// - "SCEL4_2_2_1_1_1_0/0" to "SCEL4_2_2_1_1_1_0/3": occupation(l) == 1, for
+///   l = 0, ..., 3, and non-zero disp values at each site
+inline CASM::config::ConfigurationSet make_io_test_configurations(
+    CASM::config::SupercellSet &supercells) {
+  using namespace CASM;
+
+  Eigen::Matrix3l T1 = Eigen::Matrix3l::Identity();
+  Eigen::Matrix3l T2;
+  T2 << -1, 1, 1, 1, -1, 1, 1, 1, -1;
+  auto supercell1 = supercells.insert(T1).first->supercell;
+  auto supercell2 = supercells.insert(T2).first->supercell;
+
+  config::ConfigurationSet configurations;
+  config::Configuration A(supercell1);
+  A.dof_values.occupation(0) = 2;
+  A.dof_values.global_dof_values.at("GLstrain")(0) = 0.01;
+  configurations.insert("SCEL1_1_1_1_0_0_0", A);
+  for (Index l = 0; l < 4; ++l) {
+    config::Configuration B(supercell2);
+    B.dof_values.occupation(l) = 1;
+    Eigen::MatrixXd &disp = B.dof_values.local_dof_values.at("disp");
+    for (Index k = 0; k < disp.cols(); ++k) {
+      disp.col(k) << 0.01 * k, -0.02, 0.1 / 3.0;
+    }
+    configurations.insert("SCEL4_2_2_1_1_1_0", B);
+  }
+  return configurations;
+}
+
+}  // namespace test
+
+#endif